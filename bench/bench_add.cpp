@@ -0,0 +1,65 @@
+// Measures takum operator+ / operator- and the double codec in tight loops,
+// with and without rare operands (zero, NaR, negligible addends) mixed in,
+// plus the Φ evaluator. bench_add_no_long_double is the same program built
+// with TAKUM_NO_LONG_DOUBLE=1.
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/arithmetic.h"
+#include "takum/internal/phi_bench.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 16;
+constexpr size_t kIters = 20;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    std::mt19937_64 rng(N);
+    std::lognormal_distribution<double> mag(0.0, 2.0);
+    std::vector<double> xs(kCount);
+    std::vector<takum::takum<N>> a(kCount), b(kCount), rare(kCount), out(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        xs[i] = (rng() & 1) ? mag(rng) : -mag(rng);
+        a[i] = takum::takum<N>(xs[i]);
+        b[i] = takum::takum<N>((rng() & 1) ? mag(rng) : -mag(rng));
+        switch (rng() % 16) {
+        case 0: rare[i] = takum::takum<N>(0.0); break;
+        case 1: rare[i] = takum::takum<N>::nar(); break;
+        case 2: rare[i] = takum::takum<N>(xs[i] * 1e-30); break;
+        default: rare[i] = b[i];
+        }
+    }
+
+    auto add = time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i] + b[i]; }, kIters);
+    auto sub = time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i] - b[i]; }, kIters);
+    auto mixed = time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i] + rare[i]; }, kIters);
+    auto encode = time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = takum::takum<N>(xs[i]); }, kIters);
+    double sink = 0.0;
+    auto decode = time_ns([&] { for (size_t i = 0; i < kCount; ++i) sink += a[i].to_double(); }, kIters);
+    auto phi = time_ns([&] {
+        for (size_t i = 0; i < kCount; ++i) {
+            const auto t = static_cast<takum::internal::wide_float>(i) / kCount - 0.5;
+            sink += static_cast<double>(takum::internal::phi::phi_eval<N>(t).value);
+        }
+    }, kIters);
+
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+    std::printf("%4zu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f%s\n", N, ns(add), ns(sub), ns(mixed), ns(encode),
+                ns(decode), ns(phi), sink == 42.0 ? " " : "");
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %10s %10s %10s %10s %10s %10s   (ns/element, %s intermediates)\n", "N", "a+b", "a-b", "a+rare",
+                "encode", "decode", "phi_eval", takum::config::no_long_double() ? "double" : "long double");
+    run<16>();
+    run<32>();
+    run<64>();
+    return 0;
+}
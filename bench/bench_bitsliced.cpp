@@ -0,0 +1,53 @@
+// Compares bit-sliced column scans (bitsliced.h) with the row-layout scans of
+// scan.h on the same data: a magnitude threshold, a sign test and a narrow
+// range around 1.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/bitsliced.h"
+#include "takum/internal/phi_bench.h"
+#include "takum/scan.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 20;
+constexpr size_t kIters = 20;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using takum::scan::cmp_op;
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::lognormal_distribution<double> mag(0.0, 2.0);
+    std::vector<T> rows(kCount);
+    for (auto& t : rows) t = T((rng() & 1) ? mag(rng) : -mag(rng));
+    const takum::bitsliced_column<N> col(rows);
+    std::vector<uint8_t> bits(kCount / 8);
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+    auto row = [&](const char* op, uint64_t row_ns, uint64_t col_ns) {
+        std::printf("%4zu %-12s %9.2f %9.2f %8.1fx\n", N, op, ns(row_ns), ns(col_ns),
+                    static_cast<double>(row_ns) / static_cast<double>(col_ns));
+    };
+
+    // x > 1000: decided by the sign/regime planes for almost every element.
+    row("gt 1000", time_ns([&] { takum::scan::compare<N>(rows, cmp_op::gt, T(1000.0), bits); }, kIters),
+        time_ns([&] { col.compare(cmp_op::gt, T(1000.0), bits); }, kIters));
+    row("lt 0", time_ns([&] { takum::scan::compare<N>(rows, cmp_op::lt, T(0.0), bits); }, kIters),
+        time_ns([&] { col.compare(cmp_op::lt, T(0.0), bits); }, kIters));
+    row("between", time_ns([&] { takum::scan::between<N>(rows, T(0.9), T(1.1), bits); }, kIters),
+        time_ns([&] { col.between(T(0.9), T(1.1), bits); }, kIters));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %-12s %9s %9s %9s   (ns/element, %zu elements)\n", "N", "op",
+                "rows", "sliced", "speedup", kCount);
+    run<16>();
+    run<32>();
+    run<64>();
+    return 0;
+}
@@ -0,0 +1,44 @@
+// Storage and throughput of block_array against a single global width chosen
+// by advise_width() for the same error bound.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "takum/advisor.h"
+#include "takum/block_array.h"
+#include "takum/internal/phi_bench.h"
+
+int main() {
+    using takum::internal::phi::bench::time_ns;
+    constexpr size_t kCount = size_t{1} << 20;
+    constexpr size_t kIters = 5;
+
+    // Sensor-like data: quiet regions near a set point, bursts spanning many decades.
+    std::vector<double> src(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        const double t = static_cast<double>(i);
+        const bool burst = (i / 8192) % 4 == 3;
+        src[i] = burst ? std::exp(std::sin(0.37 * t) * 90.0) : 20.0 + std::sin(1e-3 * t);
+    }
+
+    std::printf("%10s %6s %12s %12s %8s %12s %12s\n", "bound", "N", "global B", "block B", "saved",
+                "enc ns/el", "dec ns/el");
+    for (double bound : {1e-3, 1e-5, 1e-7}) {
+        takum::block_array_options opts;
+        opts.max_rel_error = bound;
+        const auto advice = takum::advise_width(src, bound);
+        const size_t global = (kCount * advice.recommended_width + 63) / 64 * 8;
+
+        takum::block_array arr;
+        auto enc = time_ns([&] { arr = *takum::block_array::encode(src, opts); }, kIters);
+        std::vector<double> out(kCount);
+        auto dec = time_ns([&] { arr.decode(out); }, kIters);
+
+        std::printf("%10.0e %6zu %12zu %12zu %7.1f%% %12.2f %12.2f\n", bound, advice.recommended_width, global,
+                    arr.storage_bytes(), 100.0 * (1.0 - static_cast<double>(arr.storage_bytes()) / static_cast<double>(global)),
+                    static_cast<double>(enc) / static_cast<double>(kCount * kIters),
+                    static_cast<double>(dec) / static_cast<double>(kCount * kIters));
+    }
+    return 0;
+}
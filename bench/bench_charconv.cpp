@@ -0,0 +1,74 @@
+// Compares shortest takum::to_chars / from_chars against the to_double()
+// plus "%.17g" / strtod path they replace.
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "takum/charconv.h"
+#include "takum/internal/phi_bench.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 16;
+constexpr size_t kIters = 10;
+
+double per_value_ns(uint64_t total_ns) {
+    return static_cast<double>(total_ns) / static_cast<double>(kCount * kIters);
+}
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using storage_t = typename takum::takum<N>::storage_t;
+    std::mt19937_64 rng(N);
+    std::vector<takum::takum<N>> values(kCount);
+    for (auto& v : values) {
+        do v = takum::takum<N>::from_raw_bits(static_cast<storage_t>(rng() & ((N == 64 ? 0 : uint64_t{1} << N) - 1)));
+        while (v.is_nar());
+    }
+
+    std::vector<char> text(kCount * 32);
+    std::vector<char*> ends(kCount);
+    size_t short_bytes = 0, long_bytes = 0;
+    auto fmt_takum = time_ns([&] {
+        short_bytes = 0;
+        for (size_t i = 0; i < kCount; ++i) {
+            char* at = text.data() + i * 32;
+            ends[i] = takum::to_chars(at, at + 32, values[i]).ptr;
+            short_bytes += static_cast<size_t>(ends[i] - at);
+        }
+    }, kIters);
+    std::vector<takum::takum<N>> parsed(kCount);
+    auto parse_takum = time_ns([&] {
+        for (size_t i = 0; i < kCount; ++i) takum::from_chars(text.data() + i * 32, ends[i], parsed[i]);
+    }, kIters);
+
+    std::vector<char> text17(kCount * 32);
+    auto fmt_printf = time_ns([&] {
+        long_bytes = 0;
+        for (size_t i = 0; i < kCount; ++i) {
+            long_bytes += static_cast<size_t>(std::snprintf(text17.data() + i * 32, 32, "%.17g", values[i].to_double()));
+        }
+    }, kIters);
+    auto parse_strtod = time_ns([&] {
+        for (size_t i = 0; i < kCount; ++i) parsed[i] = takum::takum<N>(std::strtod(text17.data() + i * 32, nullptr));
+    }, kIters);
+
+    std::printf("%4zu %12.1f %12.1f %12.1f %12.1f %10.2f %10.2f\n", N, per_value_ns(fmt_takum), per_value_ns(fmt_printf),
+                per_value_ns(parse_takum), per_value_ns(parse_strtod),
+                static_cast<double>(short_bytes) / kCount, static_cast<double>(long_bytes) / kCount);
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %12s %12s %12s %12s %10s %10s\n", "N", "to_chars ns", "%.17g ns", "from_chars",
+                "strtod+ctor", "chars", "chars %.17g");
+    run<16>();
+    run<32>();
+    run<48>();
+    run<64>();
+    return 0;
+}
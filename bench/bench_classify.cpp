@@ -0,0 +1,53 @@
+// Compares the classify.h screening kernels with the scalar loops they
+// replace (is_nar() per element, std::copy_if) on a 1%-NaR stream.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/classify.h"
+#include "takum/internal/phi_bench.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 20;
+constexpr size_t kIters = 20;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::vector<T> in(kCount), out(kCount);
+    for (auto& t : in) t = (rng() % 100 == 0) ? T::nar() : T(static_cast<double>(rng() % 2000) - 1000.0);
+    const std::span<const T> s(in);
+    std::vector<uint8_t> bits(kCount / 8);
+    std::vector<takum::takum_class> cls(kCount);
+    size_t sink = 0;
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+
+    const auto scalar_count = time_ns([&] { for (const auto& t : in) sink += t.is_nar(); }, kIters);
+    const auto count = time_ns([&] { sink += takum::count_nar<N>(s); }, kIters);
+    const auto mask = time_ns([&] { sink += takum::nar_mask<N>(s, bits); }, kIters);
+    const auto classify = time_ns([&] { takum::classify<N>(s, cls); }, kIters);
+    const auto scalar_copy = time_ns([&] {
+        sink += static_cast<size_t>(std::copy_if(in.begin(), in.end(), out.begin(), [](const T& t) { return !t.is_nar(); }) -
+                                    out.begin());
+    }, kIters);
+    const auto remove = time_ns([&] { sink += takum::remove_nar<N>(s, out); }, kIters);
+    std::printf("%4zu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f%s\n", N, ns(scalar_count), ns(count), ns(mask),
+                ns(classify), ns(scalar_copy), ns(remove), sink == 42 ? " " : "");
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %10s %10s %10s %10s %10s %10s   (ns/element)\n", "N", "is_nar", "count_nar", "nar_mask",
+                "classify", "copy_if", "remove_nar");
+    run<16>();
+    run<32>();
+    run<64>();
+    run<128>();
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Compression ratio and throughput of takum::codec on takum32 time series,
+// with zlib (level 1 and 6) as a general-purpose baseline when available.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "takum/codec.h"
+#include "takum/internal/phi_bench.h"
+
+#if TAKUM_BENCH_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 22;
+constexpr size_t kIters = 5;
+
+double gbps(size_t bytes, uint64_t ns) {
+    return static_cast<double>(bytes) * kIters / static_cast<double>(ns);
+}
+
+void report(const char* name, size_t raw, size_t packed, uint64_t enc_ns, uint64_t dec_ns) {
+    std::printf("  %-12s ratio %6.2f   compress %7.3f GB/s   decompress %7.3f GB/s\n", name,
+                static_cast<double>(raw) / static_cast<double>(packed), gbps(raw, enc_ns), gbps(raw, dec_ns));
+}
+
+void run(const char* label, const std::vector<takum::takum<32>>& in) {
+    using takum::internal::phi::bench::time_ns;
+    const size_t raw = in.size() * sizeof(uint32_t);
+    std::printf("%s\n", label);
+
+    std::vector<uint8_t> frame;
+    auto enc = time_ns([&] { frame = *takum::codec::compress<32>(std::span<const takum::takum<32>>(in)); }, kIters);
+    std::vector<takum::takum<32>> out(in.size());
+    auto dec = time_ns([&] { (void)takum::codec::decompress<32>(frame, std::span<takum::takum<32>>(out)); }, kIters);
+    report("takum::codec", raw, frame.size(), enc, dec);
+
+#if TAKUM_BENCH_HAVE_ZLIB
+    for (int level : {1, 6}) {
+        std::vector<Bytef> z(compressBound(static_cast<uLong>(raw)));
+        uLongf zlen = 0;
+        auto zenc = time_ns([&] {
+            zlen = static_cast<uLongf>(z.size());
+            compress2(z.data(), &zlen, reinterpret_cast<const Bytef*>(in.data()), static_cast<uLong>(raw), level);
+        }, kIters);
+        auto zdec = time_ns([&] {
+            uLongf olen = static_cast<uLongf>(raw);
+            uncompress(reinterpret_cast<Bytef*>(out.data()), &olen, z.data(), zlen);
+        }, kIters);
+        char name[16];
+        std::snprintf(name, sizeof(name), "zlib -%d", level);
+        report(name, raw, zlen, zenc, zdec);
+    }
+#endif
+}
+
+} // namespace
+
+int main() {
+    std::vector<takum::takum<32>> in(kCount);
+    for (size_t i = 0; i < kCount; ++i) in[i] = takum::takum<32>(20.0 + std::sin(1e-4 * static_cast<double>(i)));
+    run("slow sensor signal", in);
+
+    for (size_t i = 0; i < kCount; ++i) in[i] = takum::takum<32>(1e-3 * static_cast<double>(i) + 1.0);
+    run("sorted ramp", in);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        in[i] = takum::takum<32>(std::exp(std::sin(1e-3 * static_cast<double>(i)) * 10.0) * std::cos(3e-2 * static_cast<double>(i)));
+    }
+    run("oscillating, wide range", in);
+    return 0;
+}
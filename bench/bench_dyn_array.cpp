@@ -0,0 +1,56 @@
+// Compares runtime-width dyn_array bulk conversion against the static-width
+// encode_batch / decode_batch kernels it dispatches to.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "takum/batch.h"
+#include "takum/dyn_array.h"
+#include "takum/internal/phi_bench.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 20;
+constexpr size_t kIters = 20;
+
+double per_element_ns(uint64_t total_ns) {
+    return static_cast<double>(total_ns) / static_cast<double>(kCount * kIters);
+}
+
+template <size_t N>
+void run(const std::vector<double>& src) {
+    using takum::internal::phi::bench::time_ns;
+    std::vector<takum::takum<N>> fixed(src.size());
+    std::vector<double> out(src.size());
+
+    auto enc_static = time_ns([&] { takum::encode_batch<N, double>(src, fixed); }, kIters);
+    auto dec_static = time_ns([&] { takum::decode_batch<N, double>(fixed, out); }, kIters);
+
+    takum::dyn_array arr;
+    auto enc_dyn = time_ns([&] { arr = *takum::dyn_array::encode(N, src); }, kIters);
+    auto dec_dyn = time_ns([&] { arr.decode(out); }, kIters);
+
+    std::printf("%4zu %12.2f %12.2f %12.2f %12.2f %10zu %10zu\n", N,
+                per_element_ns(enc_static), per_element_ns(enc_dyn),
+                per_element_ns(dec_static), per_element_ns(dec_dyn),
+                fixed.size() * sizeof(takum::takum<N>), arr.storage_bytes());
+}
+
+} // namespace
+
+int main() {
+    std::vector<double> src(kCount);
+    for (size_t i = 0; i < kCount; ++i) src[i] = std::exp(std::sin(1e-4 * static_cast<double>(i)) * 20.0);
+
+    std::printf("%4s %12s %12s %12s %12s %10s %10s\n", "N", "enc ns/el", "dyn enc", "dec ns/el",
+                "dyn dec", "bytes", "dyn bytes");
+    run<12>(src);
+    run<16>(src);
+    run<19>(src);
+    run<24>(src);
+    run<32>(src);
+    run<48>(src);
+    run<64>(src);
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Compares the elementwise span kernels (elementwise.h) with the equivalent
+// loops over the scalar operators, for each operation and width. The s_*
+// rows compare scalar safe_* loops with the checked span variants.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/elementwise.h"
+#include "takum/internal/phi_bench.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 16;
+constexpr size_t kIters = 20;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::lognormal_distribution<double> mag(0.0, 2.0);
+    std::vector<T> a(kCount), b(kCount), out(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        a[i] = T((rng() & 1) ? mag(rng) : -mag(rng));
+        b[i] = T((rng() & 1) ? mag(rng) : -mag(rng));
+    }
+    const std::span<const T> sa(a), sb(b);
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+    auto row = [&](const char* op, uint64_t scalar, uint64_t span) {
+        std::printf("%4zu %-6s %10.1f %10.1f %8.1fx\n", N, op, ns(scalar), ns(span),
+                    static_cast<double>(scalar) / static_cast<double>(span));
+    };
+
+    row("add", time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i] + b[i]; }, kIters),
+        time_ns([&] { takum::add<N>(sa, sb, out); }, kIters));
+    row("sub", time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i] - b[i]; }, kIters),
+        time_ns([&] { takum::sub<N>(sa, sb, out); }, kIters));
+    row("mul", time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i] * b[i]; }, kIters),
+        time_ns([&] { takum::mul<N>(sa, sb, out); }, kIters));
+    row("div", time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i] / b[i]; }, kIters),
+        time_ns([&] { takum::div<N>(sa, sb, out); }, kIters));
+    row("mul_s", time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i] * b[0]; }, kIters),
+        time_ns([&] { takum::mul<N>(sa, b[0], out); }, kIters));
+    std::vector<uint8_t> codes(kCount);
+    row("s_add", time_ns([&] {
+            for (size_t i = 0; i < kCount; ++i) { auto r = takum::safe_add(a[i], b[i]); out[i] = r ? *r : T::nar(); }
+        }, kIters),
+        time_ns([&] { takum::safe_add<N>(sa, sb, out, codes); }, kIters));
+    row("s_mul", time_ns([&] {
+            for (size_t i = 0; i < kCount; ++i) { auto r = takum::safe_mul(a[i], b[i]); out[i] = r ? *r : T::nar(); }
+        }, kIters),
+        time_ns([&] { takum::safe_mul<N>(sa, sb, out, codes); }, kIters));
+    row("neg", time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = -a[i]; }, kIters),
+        time_ns([&] { takum::neg<N>(sa, out); }, kIters));
+    row("abs", time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = takum::abs(a[i]); }, kIters),
+        time_ns([&] { takum::abs<N>(sa, out); }, kIters));
+    row("recip", time_ns([&] { for (size_t i = 0; i < kCount; ++i) out[i] = a[i].reciprocal(); }, kIters),
+        time_ns([&] { takum::recip<N>(sa, out); }, kIters));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %-6s %10s %10s %9s   (ns/element, %zu elements)\n", "N", "op", "scalar", "span", "speedup",
+                kCount);
+    run<16>();
+    run<32>();
+    run<64>();
+    return 0;
+}
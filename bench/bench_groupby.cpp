@@ -0,0 +1,70 @@
+// Group-by over a takum column with 64 groups: the naive loop decodes every
+// row with to_double() and accumulates doubles; the kernels (groupby.h) use
+// the decode table, raw-bit min/max and per-thread partial tables.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/groupby.h"
+#include "takum/internal/phi_bench.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 20;
+constexpr size_t kGroups = 64;
+constexpr size_t kIters = 5;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::lognormal_distribution<double> mag(0.0, 2.0);
+    std::vector<T> v(kCount);
+    std::vector<uint32_t> ids(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        v[i] = T((rng() & 1) ? mag(rng) : -mag(rng));
+        ids[i] = static_cast<uint32_t>(rng() % kGroups);
+    }
+    const std::span<const uint32_t> sids(ids);
+    const unsigned basic = takum::agg_count | takum::agg_sum | takum::agg_min | takum::agg_max | takum::agg_mean;
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+
+    std::vector<double> sum(kGroups), lo(kGroups), hi(kGroups);
+    std::vector<uint64_t> count(kGroups);
+    const uint64_t naive = time_ns([&] {
+        std::fill(sum.begin(), sum.end(), 0.0);
+        std::fill(lo.begin(), lo.end(), 1e300);
+        std::fill(hi.begin(), hi.end(), -1e300);
+        std::fill(count.begin(), count.end(), 0);
+        for (size_t i = 0; i < kCount; ++i) {
+            if (v[i].is_nar()) continue;
+            const double x = v[i].to_double();
+            sum[ids[i]] += x;
+            lo[ids[i]] = std::min(lo[ids[i]], x);
+            hi[ids[i]] = std::max(hi[ids[i]], x);
+            ++count[ids[i]];
+        }
+    }, kIters);
+    const uint64_t dense = time_ns([&] { (void)takum::group_by<N>(v, sids, kGroups, basic); }, kIters);
+    const uint64_t hash = time_ns([&] {
+        (void)takum::group_by_key<N>(v, sids, basic, takum::group_strategy::hash);
+    }, kIters);
+    const uint64_t sort = time_ns([&] {
+        (void)takum::group_by_key<N>(v, sids, basic, takum::group_strategy::sort);
+    }, kIters);
+    const uint64_t all = time_ns([&] { (void)takum::group_by<N>(v, sids, kGroups); }, kIters);
+    std::printf("%4zu %9.2f %9.2f %9.2f %9.2f %9.2f\n", N, ns(naive), ns(dense), ns(hash), ns(sort), ns(all));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %9s %9s %9s %9s %9s   (ns/row, %zu rows, %zu groups; count/sum/min/max/mean, "
+                "'all' adds product and logsumexp)\n",
+                "N", "naive", "dense", "hash", "sort", "all", kCount, kGroups);
+    run<16>();
+    run<32>();
+    return 0;
+}
@@ -0,0 +1,67 @@
+// Compares takum::parse_many against per-token from_chars and the
+// strtod + takum<N>(double) path on comma/newline separated text.
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "takum/parse.h"
+#include "takum/internal/phi_bench.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 18;
+constexpr size_t kIters = 5;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    std::mt19937_64 rng(N);
+    std::normal_distribution<double> dist(0.0, 1000.0);
+    std::string text;
+    char buf[32];
+    for (size_t i = 0; i < kCount; ++i) {
+        std::snprintf(buf, sizeof(buf), "%.9g%c", dist(rng), (i % 8 == 7) ? '\n' : ',');
+        text += buf;
+    }
+
+    std::vector<takum::takum<N>> out(kCount);
+    auto many = time_ns([&] { takum::parse_many<N>(text, std::span<takum::takum<N>>(out)); }, kIters);
+    auto single = time_ns([&] {
+        takum::internal::parse_range<N>(text.data(), text.data() + text.size(), out.data(), out.size());
+    }, kIters);
+    auto per_token = time_ns([&] {
+        const char* p = text.data();
+        const char* last = p + text.size();
+        for (size_t i = 0; i < kCount; ++i) {
+            p = takum::from_chars(p, last, out[i]).ptr + 1;
+        }
+    }, kIters);
+    auto strtod = time_ns([&] {
+        const char* p = text.data();
+        for (size_t i = 0; i < kCount; ++i) {
+            char* end = nullptr;
+            out[i] = takum::takum<N>(std::strtod(p, &end));
+            p = end + 1;
+        }
+    }, kIters);
+
+    const double bytes = static_cast<double>(text.size()) * kIters;
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+    std::printf("%4zu %12.1f %12.1f %12.1f %12.1f %10.2f\n", N, ns(many), ns(single), ns(per_token), ns(strtod),
+                bytes / static_cast<double>(many));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %12s %12s %12s %12s %10s\n", "N", "parse_many", "1 thread", "from_chars", "strtod+ctor",
+                "GB/s");
+    run<16>();
+    run<32>();
+    run<48>();
+    run<64>();
+    return 0;
+}
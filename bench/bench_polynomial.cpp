@@ -0,0 +1,53 @@
+// Polynomial evaluation over a takum column: the naive loop runs Horner with
+// the scalar operators (an encode/decode round trip per operation); polyval
+// (polynomial.h) decodes each point once, runs Horner across a block in the
+// wide accumulator and rounds once. "fixed" is the std::array overload.
+
+#include <array>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/internal/phi_bench.h"
+#include "takum/polynomial.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 18;
+constexpr size_t kIters = 5;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::uniform_real_distribution<double> dist(-2.0, 2.0);
+    std::vector<T> x(kCount), out(kCount);
+    for (auto& v : x) v = T(dist(rng));
+    std::array<T, 8> c;
+    for (auto& v : c) v = T(dist(rng));
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+
+    const uint64_t naive = time_ns([&] {
+        for (size_t i = 0; i < kCount; ++i) {
+            T p = c.back();
+            for (size_t k = c.size() - 1; k-- > 0;) p = p * x[i] + c[k];
+            out[i] = p;
+        }
+    }, kIters);
+    const uint64_t dynamic = time_ns([&] { takum::polyval<N>(std::span<const T>(c), x, out); }, kIters);
+    const uint64_t fixed = time_ns([&] { takum::polyval<N>(c, x, out); }, kIters);
+    const uint64_t rational = time_ns([&] { takum::ratval<N>(c, c, x, out); }, kIters);
+    std::printf("%4zu %9.2f %9.2f %9.2f %9.2f\n", N, ns(naive), ns(dynamic), ns(fixed), ns(rational));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %9s %9s %9s %9s   (ns/point, %zu points, degree 7)\n", "N", "naive", "polyval", "fixed",
+                "ratval", kCount);
+    run<16>();
+    run<32>();
+    run<64>();
+    return 0;
+}
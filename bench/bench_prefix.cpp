@@ -0,0 +1,54 @@
+// Prefix sums and products of a takum column: the naive loops are the serial
+// `acc = acc op x` scans with the scalar operators; the kernels (numeric.h)
+// carry the running value wide (or, for products, as an integer ℓ sum) and
+// run two passes over fixed blocks on the worker threads.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/internal/phi_bench.h"
+#include "takum/numeric.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 20;
+constexpr size_t kIters = 5;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::uniform_real_distribution<double> dist(0.9, 1.1);
+    std::vector<T> v(kCount), out(kCount);
+    for (auto& x : v) x = T(dist(rng));
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+
+    const uint64_t naive_sum = time_ns([&] {
+        T acc(0.0);
+        for (size_t i = 0; i < kCount; ++i) out[i] = acc = acc + v[i];
+    }, kIters);
+    const uint64_t wide = time_ns([&] { takum::inclusive_scan<N>(v, out); }, kIters);
+    const uint64_t comp = time_ns([&] {
+        takum::inclusive_scan<N>(v, out, takum::scan_carry::compensated);
+    }, kIters);
+    const uint64_t naive_prod = time_ns([&] {
+        T acc(1.0);
+        for (size_t i = 0; i < kCount; ++i) out[i] = acc = acc * v[i];
+    }, kIters);
+    const uint64_t prod = time_ns([&] { takum::inclusive_product_scan<N>(v, out); }, kIters);
+    std::printf("%4zu %9.2f %9.2f %9.2f %9.2f %9.2f\n", N, ns(naive_sum), ns(wide), ns(comp), ns(naive_prod),
+                ns(prod));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %9s %9s %9s %9s %9s   (ns/element, %zu elements)\n", "N", "naive+", "sum", "sum-comp",
+                "naive*", "product", kCount);
+    run<16>();
+    run<32>();
+    run<64>();
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Compares scan::compare / scan::between (scan.h) with decoding each takum and
+// comparing the double, and with the same filter over a plain double column.
+// The zoned rows run on a sorted copy of the column with a block-4096 zone map.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/internal/phi_bench.h"
+#include "takum/scan.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 18;
+constexpr size_t kIters = 20;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using takum::scan::cmp_op;
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::normal_distribution<double> dist(0.0, 10.0);
+    std::vector<double> d(kCount);
+    std::vector<T> col(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        d[i] = dist(rng);
+        col[i] = T(d[i]);
+    }
+    std::vector<T> sorted(col);
+    std::sort(sorted.begin(), sorted.end(), [](const T& a, const T& b) { return a.to_double() < b.to_double(); });
+    const auto zm = takum::scan::make_zone_map<N>(sorted);
+    std::vector<uint8_t> bits(kCount / 8);
+    const double c = 12.5, lo = -3.0, hi = 4.0;
+    const T tc(c), tlo(lo), thi(hi);
+
+    auto bitmap = [&](auto&& pred) {
+        for (size_t g = 0; g < kCount; g += 8) {
+            uint8_t byte = 0;
+            for (size_t j = 0; j < 8; ++j) byte |= static_cast<uint8_t>(pred(g + j) ? 1u << j : 0u);
+            bits[g / 8] = byte;
+        }
+    };
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+    auto row = [&](const char* op, uint64_t dbl, uint64_t decode, uint64_t scan, uint64_t zoned) {
+        std::printf("%4zu %-8s %9.2f %9.2f %9.2f %9.2f\n", N, op, ns(dbl), ns(decode), ns(scan), ns(zoned));
+    };
+
+    row("lt", time_ns([&] { bitmap([&](size_t i) { return d[i] < c; }); }, kIters),
+        time_ns([&] { bitmap([&](size_t i) { return !col[i].is_nar() && col[i].to_double() < c; }); }, kIters),
+        time_ns([&] { takum::scan::compare<N>(col, cmp_op::lt, tc, bits); }, kIters),
+        time_ns([&] { takum::scan::compare<N>(sorted, zm, cmp_op::lt, tc, bits); }, kIters));
+    row("between", time_ns([&] { bitmap([&](size_t i) { return d[i] >= lo && d[i] <= hi; }); }, kIters),
+        time_ns([&] {
+            bitmap([&](size_t i) {
+                const double x = col[i].to_double();
+                return !col[i].is_nar() && x >= lo && x <= hi;
+            });
+        }, kIters),
+        time_ns([&] { takum::scan::between<N>(col, tlo, thi, bits); }, kIters),
+        time_ns([&] { takum::scan::between<N>(sorted, zm, tlo, thi, bits); }, kIters));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %-8s %9s %9s %9s %9s   (ns/element, %zu elements)\n", "N", "op", "double", "decode", "scan",
+                "zoned", kCount);
+    run<16>();
+    run<32>();
+    run<64>();
+    return 0;
+}
@@ -0,0 +1,63 @@
+// Moments of a takum column: the naive loop runs a Welford update per value
+// after to_double(); running_moments::update (stats.h) decodes blocks through
+// the table, takes two-pass block moments and merges them (and per-thread
+// partial states) with Chan's formula. "scalar" is its one-value update.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "takum/internal/phi_bench.h"
+#include "takum/stats.h"
+
+namespace {
+
+constexpr size_t kCount = size_t{1} << 20;
+constexpr size_t kIters = 5;
+
+template <size_t N>
+void run() {
+    using takum::internal::phi::bench::time_ns;
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::normal_distribution<double> dist(100.0, 15.0);
+    std::vector<T> v(kCount);
+    for (auto& x : v) x = T(dist(rng));
+    const std::span<const T> in(v);
+    auto ns = [](uint64_t t) { return static_cast<double>(t) / static_cast<double>(kCount * kIters); };
+
+    double sink = 0;
+    const uint64_t naive = time_ns([&] {
+        double n = 0, mean = 0, m2 = 0;
+        for (const T& x : v) {
+            if (x.is_nar()) continue;
+            const double d = x.to_double() - mean;
+            n += 1;
+            mean += d / n;
+            m2 += d * (x.to_double() - mean);
+        }
+        sink += m2 / n;
+    }, kIters);
+    const uint64_t scalar = time_ns([&] {
+        takum::stats::running_moments<N> m;
+        for (const T& x : v) m.update(x);
+        sink += m.variance().to_double();
+    }, kIters);
+    const uint64_t batch = time_ns([&] {
+        takum::stats::running_moments<N> m;
+        m.update(in);
+        sink += m.variance().to_double();
+    }, kIters);
+    std::printf("%4zu %9.2f %9.2f %9.2f   (%g)\n", N, ns(naive), ns(scalar), ns(batch), sink);
+}
+
+} // namespace
+
+int main() {
+    std::printf("%4s %9s %9s %9s   (ns/value, %zu values; naive is mean/variance only)\n", "N", "naive",
+                "scalar", "batch", kCount);
+    run<16>();
+    run<32>();
+    run<64>();
+    return 0;
+}
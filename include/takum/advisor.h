@@ -0,0 +1,240 @@
+/**
+ * @file advisor.h
+ * @brief Data-driven storage width advice for takum datasets.
+ *
+ * `advise_width()` scans a dataset of host doubles once (in parallel for large
+ * inputs), encodes every value at each candidate width, and reports per-width
+ * accuracy and range statistics together with the narrowest width that meets
+ * a relative error target. It replaces picking a per-tensor or per-column N
+ * by trial and error.
+ *
+ * @details
+ * For each candidate width N the report contains:
+ * - max / mean relative error of `takum<N>(x).to_double()` against x
+ * - the number of values whose ℓ = 2·ln|x| exceeds `takum<N>::max_ell()`
+ *   (these saturate when encoded and are excluded from the error statistics)
+ * - the number of non-finite inputs (these always encode to NaR)
+ * - the bit-packed storage size of the dataset at that width
+ *
+ * A histogram of integer ℓ magnitudes is returned alongside the report so
+ * callers can see where the dataset sits in the tapered dynamic range.
+ *
+ * **Usage Example:**
+ * ```cpp
+ * auto advice = takum::advise_width(column, 1e-4);
+ * if (advice.recommended_width != 0) store_as(advice.recommended_width);
+ * ```
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/internal/parallel.h"
+#include "takum/internal/width_dispatch.h"
+
+namespace takum {
+
+/**
+ * @brief Histogram of ⌊ℓ⌋ over the finite, non-zero values of a dataset.
+ *
+ * Bin `i` counts values with ⌊2·ln|x|⌋ == `min_bin + i`; values outside the
+ * takum range land in the first/last bin.
+ */
+struct ell_histogram {
+    /// Lowest ⌊ℓ⌋ tracked (values below are folded into bin 0).
+    static constexpr int min_bin = -255;
+    /// Highest ⌊ℓ⌋ tracked (values above are folded into the last bin).
+    static constexpr int max_bin = 255;
+
+    /// Counts per integer ℓ bin.
+    std::array<uint64_t, max_bin - min_bin + 1> bins{};
+    /// Number of exact zeros (ℓ = -∞, exactly representable at every width).
+    uint64_t zeros = 0;
+    /// Number of NaN/±∞ inputs (NaR at every width).
+    uint64_t non_finite = 0;
+
+    /// @brief Count for values with ⌊ℓ⌋ == @p ell_floor (0 outside the tracked range).
+    uint64_t count(int ell_floor) const noexcept {
+        if (ell_floor < min_bin || ell_floor > max_bin) return 0;
+        return bins[static_cast<size_t>(ell_floor - min_bin)];
+    }
+};
+
+/**
+ * @brief Accuracy and size statistics for one candidate width.
+ */
+struct width_candidate {
+    size_t width = 0;            ///< Candidate N
+    double max_rel_error = 0.0;  ///< Worst relative round-trip error over measured values
+    double mean_rel_error = 0.0; ///< Mean relative round-trip error over measured values
+    uint64_t saturated = 0;      ///< Values with |ℓ| > takum<N>::max_ell()
+    uint64_t nar = 0;            ///< Non-finite inputs (encode to NaR)
+    uint64_t packed_bytes = 0;   ///< Bit-packed size of the dataset at this width
+    bool meets_target = false;   ///< Error target met (and no saturation unless allowed)
+};
+
+/**
+ * @brief Result of advise_width().
+ */
+struct width_advice {
+    /// One entry per evaluated width, narrowest first.
+    std::vector<width_candidate> candidates;
+    /// Narrowest width meeting the target, or 0 if none does.
+    size_t recommended_width = 0;
+    /// Size of the dataset stored as `double`.
+    uint64_t baseline_bytes = 0;
+    /// baseline_bytes minus the packed size at the recommended width (0 if none).
+    uint64_t bytes_saved = 0;
+    /// Histogram of ⌊ℓ⌋ over the dataset.
+    ell_histogram histogram;
+
+    /// @brief Look up the statistics for @p width (nullptr if it was not evaluated).
+    const width_candidate* find(size_t width) const noexcept {
+        for (const auto& c : candidates) if (c.width == width) return &c;
+        return nullptr;
+    }
+};
+
+/**
+ * @brief Options controlling advise_width().
+ */
+struct advisor_options {
+    size_t min_width = 12;          ///< Narrowest candidate considered
+    size_t max_width = 64;          ///< Widest candidate considered
+    bool allow_saturation = false;  ///< Accept widths even if some values saturate
+    size_t grain = TAKUM_PARALLEL_GRAIN; ///< Minimum elements per worker thread
+};
+
+namespace internal {
+
+/// Per-width running statistics for one worker.
+struct advisor_width_accum {
+    double max_rel = 0.0;
+    double sum_rel = 0.0;
+    uint64_t measured = 0;
+    uint64_t saturated = 0;
+};
+
+/// Per-worker partial result of the advisor scan.
+struct advisor_partial {
+    ell_histogram histogram;
+    std::array<advisor_width_accum, dispatch_width_table.size()> widths{};
+};
+
+/// Scan data[begin, end) into @p out.
+inline void advisor_scan(std::span<const double> data, size_t begin, size_t end,
+                         const advisor_options& opts,
+                         const std::array<wide_float, dispatch_width_table.size()>& max_ell,
+                         advisor_partial& out) {
+    for (size_t i = begin; i < end; ++i) {
+        const double x = data[i];
+        if (!std::isfinite(x)) { ++out.histogram.non_finite; continue; }
+        if (x == 0.0) {
+            ++out.histogram.zeros;
+            for (auto& w : out.widths) ++w.measured;
+            continue;
+        }
+        // Same ℓ computation as the encoder so saturation matches its clamp exactly.
+        const wide_float ell = 2 * std::log(std::fabs(static_cast<wide_float>(x)));
+        const wide_float bin_f = std::floor(ell);
+        int bin = (bin_f < ell_histogram::min_bin) ? ell_histogram::min_bin
+                : (bin_f > ell_histogram::max_bin) ? ell_histogram::max_bin
+                : static_cast<int>(bin_f);
+        ++out.histogram.bins[static_cast<size_t>(bin - ell_histogram::min_bin)];
+
+        size_t k = 0;
+        for_each_dispatch_width([&](auto width) {
+            constexpr size_t N = decltype(width)::value;
+            auto& acc = out.widths[k];
+            const wide_float limit = max_ell[k++];
+            if (N < opts.min_width || N > opts.max_width) return;
+            if (std::fabs(ell) > limit) { ++acc.saturated; return; }
+            const double back = takum<N>(x).to_double();
+            const double rel = std::fabs(back - x) / std::fabs(x);
+            if (rel > acc.max_rel) acc.max_rel = rel;
+            acc.sum_rel += rel;
+            ++acc.measured;
+        });
+    }
+}
+
+} // namespace internal
+
+/**
+ * @brief Recommend the narrowest takum width that stores @p data within @p error_target.
+ *
+ * Every candidate width in [opts.min_width, opts.max_width] that has a
+ * precompiled kernel (12, 16, 19, 20, 24, 28, 32, 40, 48, 56, 64) is
+ * evaluated in a single pass over the data. Inputs larger than
+ * `opts.grain` elements are split across worker threads.
+ *
+ * @param data Dataset to analyse (NaN/±∞ are counted as NaR, not errors)
+ * @param error_target Maximum acceptable relative error per value
+ * @param opts Candidate range and saturation policy
+ * @return Per-width statistics, ℓ histogram and the recommended width
+ *
+ * @note A width meets the target when its max relative error is ≤ @p error_target
+ *       and, unless `opts.allow_saturation` is set, no value saturates.
+ */
+inline width_advice advise_width(std::span<const double> data, double error_target,
+                                 const advisor_options& opts = {}) {
+    std::array<internal::wide_float, internal::dispatch_width_table.size()> max_ell{};
+    {
+        size_t k = 0;
+        internal::for_each_dispatch_width([&](auto width) {
+            max_ell[k++] = takum<decltype(width)::value>::max_ell();
+        });
+    }
+
+    std::vector<internal::advisor_partial> partials(internal::worker_count(data.size(), opts.grain));
+    internal::parallel_for(data.size(), [&](size_t begin, size_t end, size_t worker) {
+        internal::advisor_scan(data, begin, end, opts, max_ell, partials[worker]);
+    }, opts.grain);
+
+    width_advice advice;
+    internal::advisor_partial total;
+    for (const auto& p : partials) {
+        for (size_t b = 0; b < total.histogram.bins.size(); ++b) total.histogram.bins[b] += p.histogram.bins[b];
+        total.histogram.zeros += p.histogram.zeros;
+        total.histogram.non_finite += p.histogram.non_finite;
+        for (size_t k = 0; k < total.widths.size(); ++k) {
+            auto& t = total.widths[k];
+            const auto& w = p.widths[k];
+            if (w.max_rel > t.max_rel) t.max_rel = w.max_rel;
+            t.sum_rel += w.sum_rel;
+            t.measured += w.measured;
+            t.saturated += w.saturated;
+        }
+    }
+    advice.histogram = total.histogram;
+    advice.baseline_bytes = static_cast<uint64_t>(data.size()) * sizeof(double);
+
+    for (size_t k = 0; k < internal::dispatch_width_table.size(); ++k) {
+        const size_t N = internal::dispatch_width_table[k];
+        if (N < opts.min_width || N > opts.max_width) continue;
+        const auto& acc = total.widths[k];
+        width_candidate c;
+        c.width = N;
+        c.max_rel_error = acc.max_rel;
+        c.mean_rel_error = acc.measured ? acc.sum_rel / static_cast<double>(acc.measured) : 0.0;
+        c.saturated = acc.saturated;
+        c.nar = total.histogram.non_finite;
+        c.packed_bytes = (static_cast<uint64_t>(data.size()) * N + 7) / 8;
+        c.meets_target = c.max_rel_error <= error_target && (opts.allow_saturation || c.saturated == 0);
+        if (c.meets_target && advice.recommended_width == 0) {
+            advice.recommended_width = N;
+            advice.bytes_saved = advice.baseline_bytes > c.packed_bytes ? advice.baseline_bytes - c.packed_bytes : 0;
+        }
+        advice.candidates.push_back(c);
+    }
+    return advice;
+}
+
+} // namespace takum
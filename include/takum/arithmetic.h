@@ -19,105 +19,106 @@
 
 #include <type_traits>
 #include <cmath>
+#include <utility>
 
 namespace takum {
 
+namespace internal {
+
 /**
- * @brief Add two takum values (Φ-enhanced path with fallback).
- * 
- * @deprecated The term "Phase‑4 Φ path" is deprecated. This implements the
- * current takum addition algorithm using Gaussian‑log (Φ) evaluation.
- * 
- * Primary path: Gaussian‑log helper Φ to reduce double rounding.
- * Fallback: exact log-sum-exp in ℓ space when budget exceeded.
+ * @brief Addends below this fraction of the larger operand cannot move it by
+ * half a unit in the last place (relative spacing is at least 2^-(N-3)).
  */
 template <size_t N>
-inline takum<N> operator+(const takum<N>& a, const takum<N>& b) noexcept {
-    if (a.is_nar() || b.is_nar()) return takum<N>::nar();
+inline constexpr double negligible_addend_ratio = [] {
+    double r = 1.0;
+    for (size_t i = 0; i < N + 2; ++i) r *= 0.5;
+    return r;
+}();
 
-    long double ell_a = a.get_exact_ell();
-    long double ell_b = b.get_exact_ell();
-    if (!std::isfinite((double)ell_a) || !std::isfinite((double)ell_b)) {
-        double da = a.to_double();
-        double db = b.to_double();
-        if (!std::isfinite(da) || !std::isfinite(db)) return takum<N>::nar();
-        return takum<N>(da + db);
-    }
+// Rare paths of operator+ live out of line so the common case stays a small
+// kernel that inlines into caller loops (bench/bench_add.cpp,
+// scripts/object_size_report.py).
 
-    bool Sa = (ell_a < 0.0L);
-    bool Sb = (ell_b < 0.0L);
-    long double mag_a = fabsl(ell_a);
-    long double mag_b = fabsl(ell_b);
-    
-    // Handle cases where one operand is 1.0 (ell = 0)
-    if (mag_a == 0.0L && mag_b == 0.0L) {
-        // Both are 1.0 or -1.0: result is 2.0 or 0.0
-        return takum<N>((Sa ? -1.0 : 1.0) + (Sb ? -1.0 : 1.0));
-    }
-    if (mag_a == 0.0L || mag_b == 0.0L) {
-        // One operand is ±1.0, but still exercise Phi path for diagnostics
-        // Fall through to normal path with ratio = 0
-        if (mag_a == 0.0L) {
-            std::swap(mag_a, mag_b); 
-            std::swap(Sa, Sb);
-        }
-        // Now mag_a > 0, mag_b = 0, so ratio = 0
-    } else {
-        if (mag_b > mag_a) { std::swap(mag_a, mag_b); std::swap(Sa, Sb); }
+/**
+ * @brief NaR or zero operand: NaR propagates, zero is the additive identity.
+ *
+ * Like every path of operator+, the result is the host-double sum re-encoded,
+ * so wide formats match takum<N>(a.to_double() + b.to_double()) bit for bit.
+ */
+template <size_t N>
+TAKUM_COLD TAKUM_NOINLINE takum<N> add_special(const takum<N>& a, const takum<N>& b) noexcept {
+    if (a.is_nar() || b.is_nar()) {
+        raise_status(flag_nar);
+        return takum<N>::nar();
     }
-    
-    if (mag_a == mag_b && Sa != Sb) return takum<N>{}; // perfect cancellation
+    return takum<N>(a.is_zero() ? b.to_double() : a.to_double());
+}
 
-    long double ratio = (mag_a == 0.0L) ? 0.0L : (mag_b / mag_a);
-    
-    // Check if the smaller value is negligible compared to the larger value
-    // Convert ell magnitudes back to actual value magnitudes for comparison
-    long double val_a = (mag_a == 0.0L) ? 1.0L : expl(mag_a / 2.0L);
-    long double val_b = (mag_b == 0.0L) ? 1.0L : expl(mag_b / 2.0L);
-    long double val_ratio = val_b / val_a;
-    
-    if (val_ratio < 1e-6L) { // negligible addend in actual value space
-        return takum<N>::from_ell(Sa, mag_a);
-    }
+/**
+ * @brief Exact cancellation (zero) or a host-double overflow of da + db.
+ *
+ * Overflow falls back to log-sum-exp in ℓ space around the larger operand.
+ */
+template <size_t N>
+TAKUM_COLD TAKUM_NOINLINE takum<N> add_exceptional(double da, double db) noexcept {
+    if (da == -db) return takum<N>{};
+    if (std::fabs(db) > std::fabs(da)) std::swap(da, db);
+    const bool S = std::signbit(da);
+    const wide_float z = static_cast<wide_float>(db) / static_cast<wide_float>(da); // in [-1, 1]
+    const wide_float arg = 1 + z;
+    if (arg <= 0) return takum<N>{};
+    return takum<N>::from_ell(S, 2 * (std::log(std::fabs(static_cast<wide_float>(da))) + std::log(arg)));
+}
+
+/**
+ * @brief Feed the Φ diagnostics counters for an addition with magnitude ratio
+ * |b|/|a| in (0, 1]. Informational only: the sum itself never depends on Φ.
+ */
+template <size_t N>
+TAKUM_NOINLINE void record_add_phi(double ratio) noexcept {
+    const auto phi_res = phi::phi_eval<N>(static_cast<wide_float>(ratio) - wide_float(0.5));
+    phi::record_phi<N>(phi_res, phi::within_phi_budget<N>(phi_res));
+}
+
+/**
+ * @brief Sum of two decoded, finite, non-zero operands.
+ *
+ * Shared by operator+ and the span kernels in elementwise.h, which pass
+ * RecordPhi = false so worker threads never touch the diagnostics counters.
+ */
+template <size_t N, bool RecordPhi>
+inline takum<N> add_decoded(double da, double db) noexcept {
+    const double ma = std::fabs(da);
+    const double mb = std::fabs(db);
+    if (mb < ma * negligible_addend_ratio<N>) TAKUM_UNLIKELY return takum<N>(da);
+    if (ma < mb * negligible_addend_ratio<N>) TAKUM_UNLIKELY return takum<N>(db);
+    if constexpr (RecordPhi) record_add_phi<N>(ma < mb ? ma / mb : mb / ma);
+    const double sum = da + db;
+    if (sum == 0.0 || !std::isfinite(sum)) TAKUM_UNLIKELY return add_exceptional<N>(da, db);
+    return takum<N>(sum);
+}
 
-    long double t = (ratio - 0.5L); // map to [-0.5,0.5]
-    auto phi_res = internal::phi::phi_eval<N>(t);
-    bool ok = internal::phi::within_phi_budget<N>(phi_res);
-    internal::phi::record_phi<N>(phi_res, ok);
+} // namespace internal
 
-    long double ell_res_mag;
-    bool force_fallback = false;
-    if (ok) {
-        long double s = (Sa == Sb) ? 1.0L : -1.0L;
-        long double adj = s * ratio - 0.5L * ratio * ratio; // 2nd-order
-        long double blended = adj * phi_res.value;
-        ell_res_mag = mag_a + blended;
-        if (ell_res_mag < 0.0L) force_fallback = true;
-    }
-    if (!ok || force_fallback) {
-        // For simple cases, use double arithmetic to maintain exact precision
-        double da = a.to_double();
-        double db = b.to_double();
-        double result = da + db;
-        if (std::isfinite(result)) {
-            return takum<N>(result);
-        }
-        
-        // Fallback to log-sum-exp for edge cases
-        long double log_a = mag_a / 2.0L;  // log(|a|) = ell_a/2
-        long double log_b = mag_b / 2.0L;  // log(|b|) = ell_b/2
-        long double s = (Sa == Sb) ? 1.0L : -1.0L;
-        long double diff = log_b - log_a;  // log(|b|/|a|)
-        long double z = s * expl(diff);    // ±|b|/|a|
-        if (fabsl(z) < 1e-24L) {
-            ell_res_mag = mag_a;
-        } else {
-            long double arg = 1.0L + z;
-            if (arg <= 0.0L) return (arg == 0.0L) ? takum<N>{} : takum<N>::nar();
-            ell_res_mag = 2.0L * (log_a + logl(arg));  // Convert back to ell = 2*log
-        }
+/**
+ * @brief Add two takum values.
+ *
+ * The common case is a small inlinable kernel: decode both operands, add in
+ * host double (far below half an ulp for N ≤ 32, and the same fallback the
+ * Φ budget check already selected for wider formats) and re-encode. Rare
+ * cases — NaR or zero operands, negligible addends, exact cancellation and
+ * double overflow — are handled by cold out-of-line helpers.
+ *
+ * With TAKUM_ENABLE_PHI_DIAGNOSTICS the Gaussian-log (Φ) helper is evaluated
+ * for each non-trivial addition to keep phi_diag<N>() counters meaningful.
+ */
+template <size_t N>
+inline takum<N> operator+(const takum<N>& a, const takum<N>& b) noexcept {
+    if (a.is_nar() || b.is_nar() || a.is_zero() || b.is_zero()) TAKUM_UNLIKELY {
+        return internal::add_special(a, b);
     }
-    return takum<N>::from_ell(Sa, ell_res_mag);
+    return internal::add_decoded<N, TAKUM_ENABLE_PHI_DIAGNOSTICS != 0>(a.to_double(), b.to_double());
 }
 
 /**
@@ -125,18 +126,7 @@ inline takum<N> operator+(const takum<N>& a, const takum<N>& b) noexcept {
  */
 template <size_t N>
 inline takum<N> operator-(const takum<N>& a, const takum<N>& b) noexcept {
-    if (a.is_nar() || b.is_nar()) return takum<N>::nar();
-    long double eb = b.get_exact_ell();
-    if (!std::isfinite((double)eb)) {
-        double da = a.to_double();
-        double db = b.to_double();
-        if (!std::isfinite(da) || !std::isfinite(db)) return takum<N>::nar();
-        return takum<N>(da - db);
-    }
-    bool Sb = (eb < 0.0L);
-    long double mb = fabsl(eb);
-    takum<N> negb = takum<N>::from_ell(!Sb, mb);
-    return a + negb;
+    return a + -b;
 }
 
 /**
@@ -144,7 +134,10 @@ inline takum<N> operator-(const takum<N>& a, const takum<N>& b) noexcept {
  */
 template <size_t N>
 inline takum<N> operator*(const takum<N>& a, const takum<N>& b) noexcept {
-    if (a.is_nar() || b.is_nar()) return takum<N>::nar();
+    if (a.is_nar() || b.is_nar()) {
+        internal::raise_status(flag_nar);
+        return takum<N>::nar();
+    }
     double da = a.to_double();
     double db = b.to_double();
     if (!std::isfinite(da) || !std::isfinite(db)) return takum<N>::nar();
@@ -156,10 +149,16 @@ inline takum<N> operator*(const takum<N>& a, const takum<N>& b) noexcept {
  */
 template <size_t N>
 inline takum<N> operator/(const takum<N>& a, const takum<N>& b) noexcept {
-    if (a.is_nar() || b.is_nar()) return takum<N>::nar();
+    if (a.is_nar() || b.is_nar()) {
+        internal::raise_status(flag_nar);
+        return takum<N>::nar();
+    }
     double da = a.to_double();
     double db = b.to_double();
-    if (!std::isfinite(da) || !std::isfinite(db) || db == 0.0) return takum<N>::nar();
+    if (!std::isfinite(da) || !std::isfinite(db) || db == 0.0) {
+        internal::raise_status(flag_nar | flag_invalid);
+        return takum<N>::nar();
+    }
     return takum<N>(da / db);
 }
 
@@ -236,7 +235,7 @@ inline std::expected<takum<N>, takum_error> safe_mul(const takum<N>& a, const ta
 template <size_t N>
 inline std::expected<takum<N>, takum_error> safe_div(const takum<N>& a, const takum<N>& b) noexcept {
     if (a.is_nar() || b.is_nar()) return std::unexpected(takum_error{takum_error::Kind::InvalidOperation, "NaR operand"});
-    if (b.to_double() == 0.0) return std::unexpected(takum_error{takum_error::Kind::DomainError, "division by zero"});
+    if (b.is_zero()) return std::unexpected(takum_error{takum_error::Kind::DomainError, "division by zero"});
     takum<N> r = a / b;
     if (r.is_nar()) return std::unexpected(takum_error{takum_error::Kind::Overflow, "result NaR/overflow"});
     return r;
@@ -257,7 +256,7 @@ inline std::expected<takum<N>, takum_error> safe_abs(const takum<N>& a) noexcept
 template <size_t N>
 inline std::expected<takum<N>, takum_error> safe_recip(const takum<N>& a) noexcept {
     if (a.is_nar()) return std::unexpected(takum_error{takum_error::Kind::InvalidOperation, "NaR operand"});
-    if (a.to_double() == 0.0) return std::unexpected(takum_error{takum_error::Kind::DomainError, "reciprocal of zero"});
+    if (a.is_zero()) return std::unexpected(takum_error{takum_error::Kind::DomainError, "reciprocal of zero"});
     takum<N> r = a.reciprocal();
     if (r.is_nar()) return std::unexpected(takum_error{takum_error::Kind::Overflow, "result NaR/overflow"});
     return r;
@@ -312,7 +311,7 @@ inline std::optional<takum<N>> safe_mul(const takum<N>& a, const takum<N>& b) no
 template <size_t N>
 inline std::optional<takum<N>> safe_div(const takum<N>& a, const takum<N>& b) noexcept {
     if (a.is_nar() || b.is_nar()) return std::nullopt;
-    if (b.to_double() == 0.0) return std::nullopt;
+    if (b.is_zero()) return std::nullopt;
     takum<N> r = a / b;
     if (r.is_nar()) return std::nullopt;
     return r;
@@ -330,11 +329,23 @@ inline std::optional<takum<N>> safe_abs(const takum<N>& a) noexcept {
 template <size_t N>
 inline std::optional<takum<N>> safe_recip(const takum<N>& a) noexcept {
     if (a.is_nar()) return std::nullopt;
-    if (a.to_double() == 0.0) return std::nullopt;
+    if (a.is_zero()) return std::nullopt;
     takum<N> r = a.reciprocal();
     if (r.is_nar()) return std::nullopt;
     return r;
 }
 #endif // !TAKUM_HAS_STD_EXPECTED
 
+#if TAKUM_COMPILED
+// Instantiated once in TakumCppCompiled (src/takum_compiled.cpp).
+#define TAKUM_EXTERN_ARITHMETIC(N) \
+    extern template takum<N> operator+ <N>(const takum<N>&, const takum<N>&) noexcept; \
+    extern template takum<N> operator- <N>(const takum<N>&, const takum<N>&) noexcept; \
+    extern template takum<N> operator* <N>(const takum<N>&, const takum<N>&) noexcept; \
+    extern template takum<N> operator/ <N>(const takum<N>&, const takum<N>&) noexcept; \
+    extern template takum<N> abs<N>(const takum<N>&) noexcept;
+TAKUM_COMPILED_WIDTHS(TAKUM_EXTERN_ARITHMETIC)
+#undef TAKUM_EXTERN_ARITHMETIC
+#endif
+
 } // namespace takum
@@ -0,0 +1,324 @@
+/**
+ * @file arrow.h
+ * @brief Zero-copy export/import of takum<N> columns through the Arrow C Data Interface.
+ *
+ * Takum columns are exchanged as an Arrow *extension type*: the storage type
+ * is the raw pattern (`uint32` for N ≤ 32, `uint64` for N ≤ 64, fixed-size
+ * binary for wider formats) and the field metadata carries
+ * `ARROW:extension:name = "takum.N"`. Engines that know the extension decode
+ * the patterns; others still see a well-typed integer column.
+ *
+ * The C Data Interface structs are declared here exactly as in the Arrow
+ * specification (guarded by `ARROW_C_DATA_INTERFACE`, so including Arrow's
+ * own `abi.h` first is fine); no Arrow library is needed.
+ *
+ * **Ownership:**
+ * - `export_array(span, ...)` lends the span's memory: it must outlive the
+ *   consumer's call to `ArrowArray::release`.
+ * - `export_array(std::vector&&, ...)` moves the vector into the exported
+ *   array, which then owns it; still no element copy.
+ * - `import_array` takes ownership of the `ArrowArray` (the source struct is
+ *   marked released) and views its data buffer in place. Arrays with nulls are
+ *   copied so that null slots become NaR.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/result.h"
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace takum::arrow {
+
+/// @brief Extension type name for takum<N> ("takum.N").
+inline std::string extension_name(size_t n) {
+    return "takum." + std::to_string(n);
+}
+
+/// @brief Arrow storage format string for takum<N>.
+template <size_t N>
+inline std::string storage_format() {
+    if constexpr (N <= 32) return "I";
+    else if constexpr (N <= 64) return "L";
+    else return "w:" + std::to_string(sizeof(takum<N>));
+}
+
+namespace internal {
+
+using namespace ::takum::internal;
+
+/// Encode key/value pairs in the C Data Interface metadata layout (native int32s).
+inline std::vector<char> encode_metadata(const std::vector<std::pair<std::string, std::string>>& kv) {
+    std::vector<char> out;
+    auto put_i32 = [&](int32_t v) {
+        const size_t at = out.size();
+        out.resize(at + 4);
+        std::memcpy(out.data() + at, &v, 4);
+    };
+    put_i32(static_cast<int32_t>(kv.size()));
+    for (const auto& [k, v] : kv) {
+        put_i32(static_cast<int32_t>(k.size()));
+        out.insert(out.end(), k.begin(), k.end());
+        put_i32(static_cast<int32_t>(v.size()));
+        out.insert(out.end(), v.begin(), v.end());
+    }
+    return out;
+}
+
+/// Look up @p key in C Data Interface metadata; empty if absent.
+inline std::string find_metadata(const char* metadata, const std::string& key) {
+    if (!metadata) return {};
+    auto get_i32 = [&](const char*& p) {
+        int32_t v;
+        std::memcpy(&v, p, 4);
+        p += 4;
+        return v;
+    };
+    const char* p = metadata;
+    const int32_t n = get_i32(p);
+    for (int32_t i = 0; i < n; ++i) {
+        const int32_t kl = get_i32(p);
+        std::string k(p, static_cast<size_t>(kl));
+        p += kl;
+        const int32_t vl = get_i32(p);
+        std::string v(p, static_cast<size_t>(vl));
+        p += vl;
+        if (k == key) return v;
+    }
+    return {};
+}
+
+struct schema_holder {
+    std::string format;
+    std::string name;
+    std::vector<char> metadata;
+};
+
+struct array_holder {
+    const void* buffers[2] = {nullptr, nullptr};
+    std::shared_ptr<const void> owner; ///< Keeps moved-in storage alive
+};
+
+inline void release_schema(ArrowSchema* s) {
+    if (!s || !s->release) return;
+    delete static_cast<schema_holder*>(s->private_data);
+    s->release = nullptr;
+}
+
+inline void release_array(ArrowArray* a) {
+    if (!a || !a->release) return;
+    delete static_cast<array_holder*>(a->private_data);
+    a->release = nullptr;
+}
+
+template <size_t N>
+inline void fill_schema(ArrowSchema* out, const char* field_name) {
+    auto* h = new schema_holder;
+    h->format = storage_format<N>();
+    h->name = field_name ? field_name : "";
+    h->metadata = encode_metadata({{"ARROW:extension:name", extension_name(N)},
+                                   {"ARROW:extension:metadata", "{\"width\":" + std::to_string(N) + "}"}});
+    out->format = h->format.c_str();
+    out->name = h->name.c_str();
+    out->metadata = h->metadata.data();
+    out->flags = 0;
+    out->n_children = 0;
+    out->children = nullptr;
+    out->dictionary = nullptr;
+    out->release = &release_schema;
+    out->private_data = h;
+}
+
+template <size_t N>
+inline void fill_array(ArrowArray* out, const takum<N>* data, size_t length, std::shared_ptr<const void> owner) {
+    auto* h = new array_holder;
+    h->buffers[1] = data;
+    h->owner = std::move(owner);
+    out->length = static_cast<int64_t>(length);
+    out->null_count = 0;
+    out->offset = 0;
+    out->n_buffers = 2;
+    out->n_children = 0;
+    out->buffers = h->buffers;
+    out->children = nullptr;
+    out->dictionary = nullptr;
+    out->release = &release_array;
+    out->private_data = h;
+}
+
+} // namespace internal
+
+/**
+ * @brief Export @p values (borrowed, zero-copy) as an Arrow array and schema.
+ *
+ * @param values Elements; must stay alive and unchanged until `out_array->release` is called
+ * @param out_array Receives the array (caller calls its release callback)
+ * @param out_schema Receives the extension-typed field schema (caller releases)
+ * @param field_name Optional field name
+ */
+template <size_t N>
+inline void export_array(std::span<const takum<N>> values, ArrowArray* out_array, ArrowSchema* out_schema,
+                         const char* field_name = "") {
+    static_assert(std::is_trivially_copyable_v<takum<N>>, "arrow: takum<N> must be trivially copyable");
+    internal::fill_array<N>(out_array, values.data(), values.size(), nullptr);
+    internal::fill_schema<N>(out_schema, field_name);
+}
+
+/**
+ * @brief Export @p values, transferring ownership of the vector (zero-copy).
+ */
+template <size_t N>
+inline void export_array(std::vector<takum<N>>&& values, ArrowArray* out_array, ArrowSchema* out_schema,
+                         const char* field_name = "") {
+    auto owned = std::make_shared<const std::vector<takum<N>>>(std::move(values));
+    internal::fill_array<N>(out_array, owned->data(), owned->size(), owned);
+    internal::fill_schema<N>(out_schema, field_name);
+}
+
+/**
+ * @brief An imported Arrow takum column; releases the producer's array on destruction.
+ */
+template <size_t N>
+class imported_array {
+public:
+    imported_array() = default;
+    imported_array(const imported_array&) = delete;
+    imported_array& operator=(const imported_array&) = delete;
+    imported_array(imported_array&& other) noexcept { swap(other); }
+    imported_array& operator=(imported_array&& other) noexcept {
+        if (this != &other) {
+            reset();
+            swap(other);
+        }
+        return *this;
+    }
+    ~imported_array() { reset(); }
+
+    /// @brief Elements (viewing the producer's buffer unless nulls forced a copy).
+    std::span<const takum<N>> values() const noexcept {
+        return owned_.empty() ? std::span<const takum<N>>(data_, length_) : std::span<const takum<N>>(owned_);
+    }
+    /// @brief Number of elements.
+    size_t size() const noexcept { return length_; }
+    /// @brief Element @p i.
+    const takum<N>& operator[](size_t i) const noexcept { return values()[i]; }
+    /// @brief True when values() points into the producer's buffer.
+    bool zero_copy() const noexcept { return owned_.empty() && length_ != 0; }
+
+private:
+    template <size_t M>
+    friend result<imported_array<M>> import_array(ArrowArray*, const ArrowSchema*);
+
+    void reset() noexcept {
+        if (array_.release) array_.release(&array_);
+        array_.release = nullptr;
+        owned_.clear();
+        data_ = nullptr;
+        length_ = 0;
+    }
+
+    void swap(imported_array& other) noexcept {
+        std::swap(array_, other.array_);
+        std::swap(data_, other.data_);
+        std::swap(length_, other.length_);
+        owned_.swap(other.owned_);
+    }
+
+    ArrowArray array_{};
+    const takum<N>* data_ = nullptr;
+    size_t length_ = 0;
+    std::vector<takum<N>> owned_;
+};
+
+/**
+ * @brief Import an Arrow array of takum<N> patterns.
+ *
+ * The schema must use takum<N>'s storage format; if it carries an
+ * `ARROW:extension:name` it must be "takum.N". On success the array is moved
+ * into the result and `array->release` is set to null, per the C Data
+ * Interface move semantics; on failure the caller keeps ownership.
+ */
+template <size_t N>
+inline result<imported_array<N>> import_array(ArrowArray* array, const ArrowSchema* schema) {
+    if (!array || !schema || !array->release || !schema->format) {
+        return internal::fail(takum_error::Kind::DomainError, "arrow: released or null array/schema");
+    }
+    if (storage_format<N>() != schema->format) {
+        return internal::fail(takum_error::Kind::DomainError, "arrow: storage format does not match takum<N>");
+    }
+    const std::string ext = internal::find_metadata(schema->metadata, "ARROW:extension:name");
+    if (!ext.empty() && ext != extension_name(N)) {
+        return internal::fail(takum_error::Kind::DomainError, "arrow: extension type is not takum.N");
+    }
+    if (array->n_buffers != 2 || array->length < 0 || array->offset < 0 || (array->length > 0 && !array->buffers[1])) {
+        return internal::fail(takum_error::Kind::DomainError, "arrow: malformed array");
+    }
+
+    imported_array<N> out;
+    out.array_ = *array;
+    array->release = nullptr;
+    out.length_ = static_cast<size_t>(out.array_.length);
+    out.data_ = static_cast<const takum<N>*>(out.array_.buffers[1]) + out.array_.offset;
+
+    const auto* validity = static_cast<const uint8_t*>(out.array_.buffers[0]);
+    if (out.array_.null_count != 0 && validity) {
+        out.owned_.assign(out.data_, out.data_ + out.length_);
+        for (size_t i = 0; i < out.length_; ++i) {
+            const size_t bit = static_cast<size_t>(out.array_.offset) + i;
+            if (!((validity[bit / 8] >> (bit % 8)) & 1u)) out.owned_[i] = takum<N>::nar();
+        }
+    }
+    return out;
+}
+
+} // namespace takum::arrow
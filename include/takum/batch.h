@@ -0,0 +1,114 @@
+/**
+ * @file batch.h
+ * @brief Bulk conversion between host floating-point spans and takum<N> spans.
+ *
+ * `encode_batch` and `decode_batch` are the static-width conversion kernels
+ * used by the containers and file formats. They produce exactly the same
+ * patterns/values as the scalar `takum<N>(double)` constructor and
+ * `to_double()`, but run as tight loops split across worker threads for large
+ * inputs, and decode narrow formats (N ≤ TAKUM_DECODE_LUT_MAX_BITS) through a
+ * single shared pattern → double table.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/config.h"
+#include "takum/internal/bitpack.h"
+#include "takum/internal/parallel.h"
+
+namespace takum {
+
+namespace internal {
+
+/// @brief True when decode_batch<N> uses the full lookup table.
+template <size_t N>
+inline constexpr bool uses_decode_lut = (N <= TAKUM_DECODE_LUT_MAX_BITS);
+
+/**
+ * @brief Table of `to_double()` for every N-bit pattern (built on first use).
+ */
+template <size_t N>
+inline const std::vector<double>& decode_lut() {
+    static_assert(N <= 24, "decode_lut: table would be too large");
+    static const std::vector<double> table = [] {
+        std::vector<double> t(size_t{1} << N);
+        for (size_t i = 0; i < t.size(); ++i) {
+            using storage_t = typename takum<N>::storage_t;
+            t[i] = takum<N>::from_raw_bits(static_cast<storage_t>(i)).to_double();
+        }
+        return t;
+    }();
+    return table;
+}
+
+/**
+ * @brief Decode @p count bit-packed takum<N> patterns starting at element @p first.
+ *
+ * Serial kernel shared by the packed containers; callers parallelise over
+ * disjoint ranges.
+ */
+template <size_t N>
+inline void decode_packed(const uint64_t* words, size_t first, size_t count, double* out) {
+    if constexpr (uses_decode_lut<N>) {
+        const double* table = decode_lut<N>().data();
+        unpack_bits<N>(words, first, count, [&](size_t i, uint64_t v) { out[i] = table[v]; });
+    } else {
+        using storage_t = typename takum<N>::storage_t;
+        unpack_bits<N>(words, first, count, [&](size_t i, uint64_t v) {
+            out[i] = takum<N>::from_raw_bits(static_cast<storage_t>(v)).to_double();
+        });
+    }
+}
+
+} // namespace internal
+
+/**
+ * @brief Encode host floating-point values into takum<N>.
+ *
+ * Converts `min(in.size(), out.size())` elements; element i is bit-identical
+ * to `takum<N>(static_cast<double>(in[i]))`.
+ *
+ * @tparam N Takum bit width
+ * @tparam Real `float` or `double` source type
+ */
+template <size_t N, std::floating_point Real>
+inline void encode_batch(std::span<const Real> in, std::span<takum<N>> out) {
+    const size_t n = std::min(in.size(), out.size());
+    internal::parallel_for(n, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) out[i] = takum<N>(static_cast<double>(in[i]));
+    });
+}
+
+/**
+ * @brief Decode takum<N> values into host floating-point values.
+ *
+ * Converts `min(in.size(), out.size())` elements; element i equals
+ * `in[i].to_double()` (narrowed to Real). NaR decodes to quiet NaN.
+ *
+ * @tparam N Takum bit width
+ * @tparam Real `float` or `double` destination type
+ */
+template <size_t N, std::floating_point Real>
+inline void decode_batch(std::span<const takum<N>> in, std::span<Real> out) {
+    const size_t n = std::min(in.size(), out.size());
+    if constexpr (internal::uses_decode_lut<N>) {
+        const double* table = internal::decode_lut<N>().data();
+        constexpr uint32_t mask = (uint32_t{1} << N) - 1u;
+        internal::parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) out[i] = static_cast<Real>(table[in[i].storage & mask]);
+        });
+    } else {
+        internal::parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) out[i] = static_cast<Real>(in[i].to_double());
+        });
+    }
+}
+
+} // namespace takum
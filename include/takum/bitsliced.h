@@ -0,0 +1,309 @@
+/**
+ * @file bitsliced.h
+ * @brief Bit-sliced (bit-plane) column layout with early-terminating scans.
+ *
+ * `bitsliced_column<N>` stores the order keys of scan.h vertically: plane k
+ * holds bit k (counted from the most significant) of every element, 64
+ * elements per word, so the sign, regime and characteristic of a whole
+ * column sit in the first few planes. This is the BitWeaving/V layout:
+ *
+ * - compare() / between() walk the planes from the top over blocks of 512
+ *   elements (one cache line per plane) and stop as soon as every element of
+ *   the block is decided, so selective predicates read only a few planes.
+ * - approx() / decode() rebuild values from the top k planes only, the
+ *   midpoint of the patterns sharing that prefix; more planes refine them.
+ *
+ * Predicates follow scan.h: values compare by value, NaR never matches and
+ * a NaR constant or bound selects nothing. Bitmaps are LSB-first and cover
+ * `min(size(), 8 * bits.size())` elements. Like the scans, columns are
+ * limited to N <= 64.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/scan.h"
+#include "takum/internal/parallel.h"
+
+namespace takum {
+
+namespace internal {
+
+/// @brief Bit @p b of an order key, counted from the most significant (b < N).
+template <size_t N>
+inline bool key_bit(const scan_key_t<N>& k, size_t b) noexcept {
+    return ((k >> (N - 1 - b)) & 1u) != 0;
+}
+
+/// @brief OR @p bit (0 or 1) into bit @p b (from the most significant) of an order key.
+template <size_t N>
+inline void or_key_bit(scan_key_t<N>& k, size_t b, uint64_t bit = 1) noexcept {
+    k |= static_cast<scan_key_t<N>>(static_cast<scan_key_t<N>>(bit) << (N - 1 - b));
+}
+
+/**
+ * @brief In-place 64x64 bit-matrix anti-transpose (Hacker's Delight 7-3):
+ * bit c of a[r] moves to bit 63 - r of a[63 - c].
+ */
+inline void transpose64(uint64_t (&a)[64]) noexcept {
+    uint64_t m = 0x00000000FFFFFFFFULL;
+    for (unsigned j = 32; j != 0; j >>= 1, m ^= m << j) {
+        for (unsigned k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            const uint64_t t = (a[k] ^ (a[k | j] >> j)) & m;
+            a[k] ^= t;
+            a[k | j] ^= t << j;
+        }
+    }
+}
+
+/// @brief Running state of one plane-wise comparison over a 64-element word.
+struct plane_cmp {
+    uint64_t lt = 0; ///< Decided less than the constant
+    uint64_t gt = 0; ///< Decided greater than the constant
+    uint64_t eq = 0; ///< Equal on every plane read so far
+
+    void step(uint64_t x, bool c) noexcept {
+        const uint64_t cw = c ? ~0ULL : 0ULL;
+        lt |= eq & ~x & cw;
+        gt |= eq & x & ~cw;
+        eq &= ~(x ^ cw);
+    }
+};
+
+} // namespace internal
+
+/**
+ * @brief Column of takum values stored as N bit planes of their order keys.
+ */
+template <size_t N>
+class bitsliced_column {
+    static_assert(N <= 64, "bitsliced: only single-word takum widths are supported");
+
+public:
+    using key_type = internal::scan_key_t<N>;
+
+    /// @brief Elements per scan block: one 64-byte cache line of each plane.
+    static constexpr size_t block_words = 8;
+
+    /// @brief Empty column.
+    bitsliced_column() = default;
+
+    /// @brief Slice @p values into bit planes (in parallel for large inputs).
+    explicit bitsliced_column(std::span<const takum<N>> values)
+        : size_(values.size()), words_((values.size() + 63) / 64), planes_(N * words_, 0ULL), nar_(words_, 0ULL) {
+        const key_type nar = internal::nar_key<N>();
+        constexpr size_t grain = TAKUM_PARALLEL_GRAIN / 64;
+        internal::parallel_for(words_, [&](size_t begin, size_t end, size_t) {
+            for (size_t w = begin; w < end; ++w) {
+                const size_t first = w * 64;
+                const size_t len = std::min<size_t>(64, size_ - first);
+                key_type keys[64]{};
+                uint64_t nar_word = 0;
+                for (size_t j = 0; j < len; ++j) {
+                    keys[j] = internal::order_key(values[first + j]);
+                    nar_word |= static_cast<uint64_t>(keys[j] == nar) << j;
+                }
+                nar_[w] = nar_word;
+                // Key bit b of element j (MSB-aligned) becomes bit j of plane b.
+                uint64_t m[64];
+                for (size_t j = 0; j < 64; ++j) m[63 - j] = static_cast<uint64_t>(keys[j]) << (64 - N);
+                internal::transpose64(m);
+                for (size_t b = 0; b < N; ++b) planes_[b * words_ + w] = m[b];
+            }
+        }, grain);
+    }
+
+    /// @brief Number of elements.
+    size_t size() const noexcept { return size_; }
+    /// @brief True when the column holds no elements.
+    bool empty() const noexcept { return size_ == 0; }
+    /// @brief 64-bit words per plane.
+    size_t words() const noexcept { return words_; }
+    /// @brief Plane @p k (0 = most significant key bit); bit j of word w is element 64w + j.
+    std::span<const uint64_t> plane(size_t k) const noexcept {
+        return std::span<const uint64_t>(planes_).subspan(k * words_, words_);
+    }
+    /// @brief NaR bitmap, in the same word layout as the planes.
+    std::span<const uint64_t> nar_words() const noexcept { return nar_; }
+    /// @brief Bytes of plane and NaR storage.
+    size_t storage_bytes() const noexcept { return (planes_.size() + nar_.size()) * sizeof(uint64_t); }
+
+    /// @brief Element @p i, gathered from all planes.
+    takum<N> operator[](size_t i) const noexcept { return approx(i, N); }
+
+    /**
+     * @brief Element @p i rebuilt from its top @p planes planes.
+     *
+     * The missing low bits are set to the midpoint of the patterns sharing the
+     * prefix (a one followed by zeros), so the error halves with every added
+     * plane; `planes >= N` is exact and NaR elements stay NaR.
+     */
+    takum<N> approx(size_t i, size_t planes) const noexcept {
+        const size_t w = i / 64, j = i % 64;
+        if ((nar_[w] >> j) & 1u) return takum<N>::nar();
+        planes = std::min(planes, N);
+        key_type k{};
+        for (size_t b = 0; b < planes; ++b) {
+            internal::or_key_bit<N>(k, b, (planes_[b * words_ + w] >> j) & 1u);
+        }
+        if (planes < N) {
+            key_type mid = k;
+            internal::or_key_bit<N>(mid, planes);
+            // The midpoint of the smallest negative magnitudes is the NaR key.
+            if (mid != internal::nar_key<N>()) k = mid;
+        }
+        return internal::from_order_key<N>(k);
+    }
+
+    /**
+     * @brief Rebuild `min(size(), out.size())` elements from the top @p planes planes.
+     *
+     * Reads only those planes (plus the NaR bitmap); see approx().
+     */
+    void decode(std::span<takum<N>> out, size_t planes = N) const {
+        const size_t n = std::min(size_, out.size());
+        planes = std::min(planes, N);
+        const key_type nar = internal::nar_key<N>();
+        constexpr size_t grain = TAKUM_PARALLEL_GRAIN / 64;
+        internal::parallel_for((n + 63) / 64, [&](size_t begin, size_t end, size_t) {
+            for (size_t w = begin; w < end; ++w) {
+                const size_t first = w * 64;
+                const size_t len = std::min<size_t>(64, n - first);
+                key_type keys[64]{};
+                // Bit j of plane b becomes key bit b of element j.
+                uint64_t m[64]{};
+                for (size_t b = 0; b < planes; ++b) m[b] = planes_[b * words_ + w];
+                internal::transpose64(m);
+                for (size_t j = 0; j < len; ++j) keys[j] = static_cast<key_type>(m[63 - j] >> (64 - N));
+                for (size_t j = 0; j < len; ++j) {
+                    if (planes < N) {
+                        key_type mid = keys[j];
+                        internal::or_key_bit<N>(mid, planes);
+                        keys[j] = mid != nar ? mid : keys[j];
+                    }
+                    // A NaR element's planes hold the NaR key exactly.
+                    if ((nar_[w] >> j) & 1u) keys[j] = nar;
+                    out[first + j] = internal::from_order_key<N>(keys[j]);
+                }
+            }
+        }, grain);
+    }
+
+    /**
+     * @brief Selection bitmap of `element <op> constant`, reading planes only
+     * until each 512-element block is decided.
+     *
+     * @return Number of selected elements
+     */
+    size_t compare(scan::cmp_op op, const takum<N>& constant, std::span<uint8_t> bits) const {
+        const size_t n = std::min(size_, bits.size() * 8);
+        if (constant.is_nar()) {
+            internal::clear_bitmap(bits, n);
+            return 0;
+        }
+        const key_type c = internal::order_key(constant);
+        return run(bits, n, [&](size_t first, size_t count, uint64_t* out) {
+            internal::plane_cmp s[block_words];
+            for (size_t w = 0; w < count; ++w) s[w].eq = ~0ULL;
+            for (size_t b = 0; b < N; ++b) {
+                const uint64_t* p = planes_.data() + b * words_ + first;
+                const bool cb = internal::key_bit<N>(c, b);
+                uint64_t undecided = 0;
+                for (size_t w = 0; w < count; ++w) {
+                    s[w].step(p[w], cb);
+                    undecided |= s[w].eq;
+                }
+                if (undecided == 0) break;
+            }
+            for (size_t w = 0; w < count; ++w) {
+                switch (op) {
+                    case scan::cmp_op::lt: out[w] = s[w].lt; break;
+                    case scan::cmp_op::le: out[w] = s[w].lt | s[w].eq; break;
+                    case scan::cmp_op::gt: out[w] = s[w].gt; break;
+                    case scan::cmp_op::ge: out[w] = s[w].gt | s[w].eq; break;
+                    case scan::cmp_op::eq: out[w] = s[w].eq; break;
+                    case scan::cmp_op::ne: out[w] = s[w].lt | s[w].gt; break;
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Selection bitmap of `lo <= element <= hi`, reading planes only
+     * until both bounds decide each 512-element block.
+     *
+     * @return Number of selected elements
+     */
+    size_t between(const takum<N>& lo, const takum<N>& hi, std::span<uint8_t> bits) const {
+        const size_t n = std::min(size_, bits.size() * 8);
+        const key_type klo = internal::order_key(lo), khi = internal::order_key(hi);
+        if (lo.is_nar() || hi.is_nar() || khi < klo) {
+            internal::clear_bitmap(bits, n);
+            return 0;
+        }
+        return run(bits, n, [&](size_t first, size_t count, uint64_t* out) {
+            internal::plane_cmp a[block_words], z[block_words];
+            for (size_t w = 0; w < count; ++w) a[w].eq = z[w].eq = ~0ULL;
+            for (size_t b = 0; b < N; ++b) {
+                const uint64_t* p = planes_.data() + b * words_ + first;
+                const bool lb = internal::key_bit<N>(klo, b), hb = internal::key_bit<N>(khi, b);
+                uint64_t undecided = 0;
+                for (size_t w = 0; w < count; ++w) {
+                    a[w].step(p[w], lb);
+                    z[w].step(p[w], hb);
+                    undecided |= a[w].eq | z[w].eq;
+                }
+                if (undecided == 0) break;
+            }
+            for (size_t w = 0; w < count; ++w) out[w] = (a[w].gt | a[w].eq) & (z[w].lt | z[w].eq);
+        });
+    }
+
+private:
+    /// @brief Run @p block(first_word, word_count, out_words) over 512-element
+    /// blocks in parallel, mask NaR and tail bits, and write the bitmap bytes.
+    template <typename Block>
+    size_t run(std::span<uint8_t> bits, size_t n, Block&& block) const {
+        const size_t words = (n + 63) / 64;
+        const size_t bytes = (n + 7) / 8;
+        const size_t blocks = (words + block_words - 1) / block_words;
+        constexpr size_t grain = std::max<size_t>(1, TAKUM_PARALLEL_GRAIN / (64 * block_words));
+        std::vector<size_t> partial(internal::worker_count(blocks, grain), 0);
+        internal::parallel_for(blocks, [&](size_t begin, size_t end, size_t wk) {
+            size_t total = 0;
+            for (size_t bl = begin; bl < end; ++bl) {
+                const size_t first = bl * block_words;
+                const size_t count = std::min(block_words, words - first);
+                uint64_t out[block_words];
+                block(first, count, out);
+                for (size_t w = 0; w < count; ++w) {
+                    const size_t g = first + w;
+                    const size_t len = std::min<size_t>(64, n - g * 64);
+                    uint64_t word = out[w] & ~nar_[g];
+                    if (len < 64) word &= (1ULL << len) - 1;
+                    total += static_cast<size_t>(std::popcount(word));
+                    const size_t byte_end = std::min(bytes, (g + 1) * 8);
+                    for (size_t b = g * 8; b < byte_end; ++b) bits[b] = static_cast<uint8_t>(word >> (8 * (b - g * 8)));
+                }
+            }
+            partial[wk] = total;
+        }, grain);
+        size_t total = 0;
+        for (size_t c : partial) total += c;
+        return total;
+    }
+
+    size_t size_ = 0;
+    size_t words_ = 0;
+    std::vector<uint64_t> planes_; ///< N planes of words_ words each, most significant first
+    std::vector<uint64_t> nar_;    ///< NaR bitmap, words_ words
+};
+
+} // namespace takum
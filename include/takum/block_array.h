@@ -0,0 +1,329 @@
+/**
+ * @file block_array.h
+ * @brief Block-adaptive precision container: each block stored at its own takum width.
+ *
+ * `block_array` splits a dataset into fixed-size blocks (256 elements by
+ * default) and stores every block at the narrowest precompiled width
+ * (12, 16, 19, 20, 24, 28, 32, 40, 48, 56, 64) whose round-trip relative
+ * error stays within a configured bound. Data whose dynamic range varies by
+ * region (quiet vs. saturated sensor channels, smooth vs. turbulent fields)
+ * therefore pays for precision only where it is needed, instead of storing
+ * everything at the width required by the worst region.
+ *
+ * **Layout:**
+ * - All blocks share one contiguous `uint64_t` word vector; each block starts
+ *   on a word boundary and is bit-packed at its own width.
+ * - A block directory (`block_entry`: word offset, count, width) gives O(1)
+ *   random access to any element.
+ *
+ * **Operations:**
+ * - `encode()` selects widths and packs blocks in parallel.
+ * - `decode()` / `decode_block()` for bulk and random-access reads.
+ * - `for_each_block()` streams decoded blocks through a single block-sized buffer.
+ * - `transform()` / `zip()` run elementwise kernels block by block and
+ *   re-select the width of each output block.
+ *
+ * The relative error of element x is |decode(x) - x| / |x|; zeros are exact
+ * and NaN/±∞ are stored as NaR without counting against the bound.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/batch.h"
+#include "takum/dyn_array.h"
+#include "takum/result.h"
+#include "takum/internal/bitpack.h"
+#include "takum/internal/parallel.h"
+#include "takum/internal/width_dispatch.h"
+
+namespace takum {
+
+/**
+ * @brief Configuration of a block_array.
+ */
+struct block_array_options {
+    double max_rel_error = 1e-3; ///< Per-element relative error bound
+    size_t block_size = 256;     ///< Elements per block (last block may be shorter)
+    size_t min_width = 12;       ///< Narrowest candidate width
+    size_t max_width = 64;       ///< Widest candidate width (used when nothing meets the bound)
+};
+
+/**
+ * @brief Directory entry describing one block.
+ */
+struct block_entry {
+    uint64_t word_offset = 0; ///< Index of the block's first word in block_array::words()
+    uint32_t count = 0;       ///< Elements in the block
+    uint8_t width = 0;        ///< Takum width N of every element in the block
+};
+
+namespace internal {
+
+/// Relative error check shared by width selection (zeros exact, non-finite → NaR).
+inline bool within_rel_error(double x, double back, double bound) noexcept {
+    if (!std::isfinite(x) || x == 0.0) return true;
+    return std::fabs(back - x) <= bound * std::fabs(x);
+}
+
+/**
+ * @brief Choose the narrowest candidate width for one block and emit its patterns.
+ *
+ * Candidates are tried narrowest first and abandoned at the first element
+ * that misses the bound, so rejected widths usually cost a few encodes. The
+ * widest candidate is always encoded in full and used if nothing else fits.
+ *
+ * @return Selected width; @p patterns holds the raw patterns at that width
+ */
+inline size_t select_block_width(std::span<const double> block, const block_array_options& opts,
+                                 std::span<uint64_t> patterns) {
+    size_t widest = 0;
+    for (size_t w : dispatch_width_table) {
+        if (w >= opts.min_width && w <= opts.max_width) widest = w;
+    }
+    size_t chosen = 0;
+    for_each_dispatch_width([&](auto width) {
+        constexpr size_t N = decltype(width)::value;
+        if (chosen != 0 || N < opts.min_width || N > opts.max_width) return;
+        for (size_t i = 0; i < block.size(); ++i) {
+            const takum<N> t(block[i]);
+            if (N != widest && !within_rel_error(block[i], t.to_double(), opts.max_rel_error)) return;
+            patterns[i] = static_cast<uint64_t>(t.storage);
+        }
+        chosen = N;
+    });
+    return chosen;
+}
+
+} // namespace internal
+
+/**
+ * @brief Tensor container storing each block at its own takum width.
+ */
+class block_array {
+public:
+    /// @brief Empty array.
+    block_array() = default;
+
+    /**
+     * @brief Encode @p values block by block.
+     *
+     * Width selection and packing both run in parallel over blocks for large
+     * inputs. Fails with DomainError for a zero block size, a NaN or negative
+     * error bound, or a width range that contains no precompiled width.
+     */
+    static result<block_array> encode(std::span<const double> values, const block_array_options& opts = {}) {
+        if (!valid_options(opts)) return internal::fail(takum_error::Kind::DomainError, "invalid block_array options");
+        block_array out;
+        out.opts_ = opts;
+        out.size_ = values.size();
+        const size_t blocks = out.block_count();
+        out.directory_.resize(blocks);
+
+        // Pass 1: choose each block's width; keep its patterns for packing.
+        std::vector<uint64_t> patterns(values.size());
+        internal::parallel_for(blocks, [&](size_t bb, size_t be, size_t) {
+            for (size_t b = bb; b < be; ++b) {
+                const size_t first = b * opts.block_size;
+                const size_t n = std::min(opts.block_size, values.size() - first);
+                auto& e = out.directory_[b];
+                e.count = static_cast<uint32_t>(n);
+                e.width = static_cast<uint8_t>(internal::select_block_width(
+                    values.subspan(first, n), opts, std::span<uint64_t>(patterns).subspan(first, n)));
+            }
+        }, out.block_grain());
+
+        // Directory offsets, then pass 2: pack blocks into their word ranges.
+        uint64_t offset = 0;
+        for (auto& e : out.directory_) {
+            e.word_offset = offset;
+            offset += internal::packed_words(e.count, e.width);
+        }
+        out.words_.assign(offset, 0ULL);
+        internal::parallel_for(blocks, [&](size_t bb, size_t be, size_t) {
+            for (size_t b = bb; b < be; ++b) {
+                const auto& e = out.directory_[b];
+                const uint64_t* src = patterns.data() + b * opts.block_size;
+                internal::dispatch_width(e.width, [&](auto w) {
+                    internal::pack_bits<decltype(w)::value>(e.count, [&](size_t i) { return src[i]; },
+                                                            out.words_.data() + e.word_offset);
+                });
+            }
+        }, out.block_grain());
+        return out;
+    }
+
+    /// @brief Number of elements.
+    size_t size() const noexcept { return size_; }
+    /// @brief True when the array holds no elements.
+    bool empty() const noexcept { return size_ == 0; }
+    /// @brief Options the array was encoded with.
+    const block_array_options& options() const noexcept { return opts_; }
+    /// @brief Elements per block.
+    size_t block_size() const noexcept { return opts_.block_size; }
+    /// @brief Number of blocks.
+    size_t block_count() const noexcept { return (size_ + opts_.block_size - 1) / opts_.block_size; }
+    /// @brief Directory entry of block @p b.
+    const block_entry& block(size_t b) const noexcept { return directory_[b]; }
+    /// @brief Whole block directory.
+    std::span<const block_entry> directory() const noexcept { return directory_; }
+    /// @brief Packed storage of all blocks.
+    std::span<const uint64_t> words() const noexcept { return words_; }
+    /// @brief Bytes of packed element storage plus the block directory.
+    size_t storage_bytes() const noexcept {
+        return words_.size() * sizeof(uint64_t) + directory_.size() * sizeof(block_entry);
+    }
+
+    /// @brief Element @p i as a runtime-width scalar (width of its block).
+    takum_dyn operator[](size_t i) const noexcept {
+        const auto& e = directory_[i / opts_.block_size];
+        return takum_dyn(e.width, internal::read_packed(words_.data() + e.word_offset, i % opts_.block_size, e.width));
+    }
+
+    /**
+     * @brief Decode block @p b into @p out.
+     * @return Elements written: the block's count, or 0 if @p out is too small
+     */
+    size_t decode_block(size_t b, std::span<double> out) const {
+        const auto& e = directory_[b];
+        if (out.size() < e.count) return 0;
+        internal::dispatch_width(e.width, [&](auto w) {
+            internal::decode_packed<decltype(w)::value>(words_.data() + e.word_offset, 0, e.count, out.data());
+        });
+        return e.count;
+    }
+
+    /**
+     * @brief Decode the whole array into @p out (parallel over blocks).
+     * @return Elements written (0 if @p out is shorter than size())
+     */
+    size_t decode(std::span<double> out) const {
+        if (out.size() < size_) return 0;
+        internal::parallel_for(block_count(), [&](size_t bb, size_t be, size_t) {
+            for (size_t b = bb; b < be; ++b) decode_block(b, out.subspan(b * opts_.block_size));
+        }, block_grain());
+        return size_;
+    }
+
+    /**
+     * @brief Stream the array block by block.
+     *
+     * Calls `f(block_index, first_element, std::span<const double> values)`
+     * for every block in order, reusing one block-sized decode buffer.
+     */
+    template <typename F>
+    void for_each_block(F&& f) const {
+        std::vector<double> buf(std::min(opts_.block_size, size_));
+        for (size_t b = 0; b < block_count(); ++b) {
+            const size_t n = decode_block(b, buf);
+            f(b, b * opts_.block_size, std::span<const double>(buf.data(), n));
+        }
+    }
+
+    /**
+     * @brief Apply `double f(double)` elementwise, block by block.
+     *
+     * Each output block is re-encoded at the narrowest width meeting
+     * @p opts' bound (defaults to this array's options).
+     */
+    template <typename F>
+    result<block_array> transform(F&& f) const {
+        return transform(std::forward<F>(f), opts_);
+    }
+
+    /// @copydoc transform(F&&) const
+    template <typename F>
+    result<block_array> transform(F&& f, const block_array_options& opts) const {
+        if (!valid_options(opts) || opts.block_size != opts_.block_size) {
+            return internal::fail(takum_error::Kind::DomainError, "invalid block_array options");
+        }
+        return blockwise(size_, opts, [&](size_t b, std::span<double> buf) {
+            decode_block(b, buf);
+            for (auto& v : buf) v = f(v);
+        });
+    }
+
+    /**
+     * @brief Apply `double f(double, double)` to corresponding elements of @p a and @p b.
+     *
+     * Both arrays must have the same size and block size; the result uses
+     * @p a's options.
+     */
+    template <typename F>
+    static result<block_array> zip(const block_array& a, const block_array& b, F&& f) {
+        if (a.size_ != b.size_ || a.opts_.block_size != b.opts_.block_size) {
+            return internal::fail(takum_error::Kind::DomainError, "block_array::zip: shape mismatch");
+        }
+        return blockwise(a.size_, a.opts_, [&](size_t blk, std::span<double> buf) {
+            std::vector<double> rhs(buf.size());
+            a.decode_block(blk, buf);
+            b.decode_block(blk, rhs);
+            for (size_t i = 0; i < buf.size(); ++i) buf[i] = f(buf[i], rhs[i]);
+        });
+    }
+
+private:
+    static bool valid_options(const block_array_options& opts) noexcept {
+        if (opts.block_size == 0 || opts.block_size > UINT32_MAX) return false;
+        if (!(opts.max_rel_error >= 0.0)) return false;
+        return std::ranges::any_of(internal::dispatch_width_table, [&](size_t w) {
+            return w >= opts.min_width && w <= opts.max_width;
+        });
+    }
+
+    /// Blocks per parallel chunk so one chunk covers about TAKUM_PARALLEL_GRAIN elements.
+    size_t block_grain() const noexcept { return std::max<size_t>(1, TAKUM_PARALLEL_GRAIN / opts_.block_size); }
+
+    /**
+     * Build an array of @p count elements whose block b is produced by
+     * `fill(b, span<double>)` and then width-selected and packed.
+     */
+    template <typename Fill>
+    static block_array blockwise(size_t count, const block_array_options& opts, Fill&& fill) {
+        block_array out;
+        out.opts_ = opts;
+        out.size_ = count;
+        const size_t blocks = out.block_count();
+        out.directory_.resize(blocks);
+        std::vector<std::vector<uint64_t>> packed(blocks);
+        internal::parallel_for(blocks, [&](size_t bb, size_t be, size_t) {
+            std::vector<double> buf(opts.block_size);
+            std::vector<uint64_t> patterns(opts.block_size);
+            for (size_t b = bb; b < be; ++b) {
+                const size_t n = std::min(opts.block_size, count - b * opts.block_size);
+                std::span<double> vals(buf.data(), n);
+                fill(b, vals);
+                auto& e = out.directory_[b];
+                e.count = static_cast<uint32_t>(n);
+                e.width = static_cast<uint8_t>(internal::select_block_width(vals, opts, patterns));
+                packed[b].assign(internal::packed_words(n, e.width), 0ULL);
+                internal::dispatch_width(e.width, [&](auto w) {
+                    internal::pack_bits<decltype(w)::value>(n, [&](size_t i) { return patterns[i]; }, packed[b].data());
+                });
+            }
+        }, out.block_grain());
+
+        uint64_t offset = 0;
+        for (size_t b = 0; b < blocks; ++b) {
+            out.directory_[b].word_offset = offset;
+            offset += packed[b].size();
+        }
+        out.words_.reserve(offset);
+        for (const auto& p : packed) out.words_.insert(out.words_.end(), p.begin(), p.end());
+        return out;
+    }
+
+    block_array_options opts_{};
+    size_t size_ = 0;
+    std::vector<block_entry> directory_;
+    std::vector<uint64_t> words_;
+};
+
+} // namespace takum
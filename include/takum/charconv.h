@@ -0,0 +1,555 @@
+/**
+ * @file charconv.h
+ * @brief Allocation-free `to_chars` / `from_chars` for takum<N>.
+ *
+ * `to_chars(first, last, x)` writes the shortest decimal string that
+ * `from_chars` maps back to the same bit pattern. A takum's rounding
+ * interval is bounded by the midpoints (in ℓ) to the adjacent bit patterns
+ * `u ± 1` of its magnitude. That interval is scaled to 18 digits and digits
+ * are stripped while it still holds an integer (as in Ryu/Grisu). Results
+ * within rounding noise of a midpoint are verified by running them through
+ * the parser's own rounding; the rare misses fall back to growing the digit
+ * count one at a time.
+ *
+ * `from_chars` parses up to 19 significant digits (20 when they start below
+ * 18), computes ℓ = 2 ln|v| in long double and rounds it to the nearest
+ * pattern (ties to even). Near 1, takum64 patterns are closer together than
+ * 19 digits resolve, so their shortest strings take the 20th digit; every
+ * pattern of every supported width round trips. Overflow and underflow beyond
+ * half a gap past maxpos/minpos report `errc::result_out_of_range` and leave
+ * the value unchanged, like the standard overloads.
+ *
+ * Formatting follows `<charconv>`: `fixed`, `scientific`, `general` (with or
+ * without precision, `%g` rules when given) — plus `chars_format::hex`, which
+ * reads and writes the raw bit pattern in hex since a takum has no binary
+ * exponent. NaR is written as "NaR"; "nar", "nan" and "inf" parse as NaR.
+ * Supported for 12 ≤ N ≤ 64.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+#include "takum/core.h"
+
+namespace takum {
+
+namespace internal {
+
+/// Decimal value digits × 10^exp10 with @ref count significant digits.
+struct decimal {
+    uint64_t digits = 0;
+    int exp10 = 0;
+    int count = 0;
+};
+
+inline constexpr uint64_t pow10_u64[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL};
+
+inline constexpr long double ln10_ld = 2.302585092994045684017991454684364208L;
+// ln 10 split so that e · ln10_hi is exact for |e| < 64 (Cody–Waite).
+inline constexpr long double ln10_hi = 0x24d763776aaa2b0p-56L;
+inline constexpr long double ln10_lo = 4.968982586806363024329693407574085476e-18L;
+inline constexpr int max_decimal_digits = 19;
+/// 19-digit prefixes below this still take a 20th digit (and a round-up) within uint64.
+inline constexpr uint64_t max_20_digit_prefix = 1800000000000000000ULL;
+
+/// 10^k in long double (exact for k ≤ 27).
+inline long double pow10_ld(int k) noexcept {
+    long double r = 1.0L;
+    for (; k > 19; k -= 19) r *= 1e19L;
+    return r * static_cast<long double>(pow10_u64[k]);
+}
+
+/// floor(x) without the x87 rounding-mode switch of floorl.
+inline int64_t floor_to_int(long double x) noexcept {
+    const auto i = static_cast<int64_t>(x);
+    return static_cast<long double>(i) > x ? i - 1 : i;
+}
+
+/// Round non-negative x to the nearest integer (halves up).
+inline uint64_t round_to_uint(long double x) noexcept {
+    return static_cast<uint64_t>(x + 0.5L);
+}
+
+/// v × 10^k with a single rounding for |k| ≤ 27.
+inline long double scale10(long double v, int k) noexcept {
+    return k >= 0 ? v * pow10_ld(k) : v / pow10_ld(-k);
+}
+
+inline int digit_count(uint64_t v) noexcept {
+    int n = 1;
+    while (n < 20 && v >= pow10_u64[n]) ++n;
+    return n;
+}
+
+/// Round v > 0 to @p p significant digits (1 ≤ p ≤ 19).
+inline decimal round_significant(long double v, int p) noexcept {
+    int e10 = static_cast<int>(floorl(log10l(v)));
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        const uint64_t d = round_to_uint(scale10(v, p - 1 - e10));
+        if (d >= pow10_u64[p]) { ++e10; continue; }
+        if (d < pow10_u64[p - 1]) { --e10; continue; }
+        return {d, e10 - p + 1, p};
+    }
+    const uint64_t d = std::clamp<uint64_t>(round_to_uint(scale10(v, p - 1 - e10)),
+                                            pow10_u64[p - 1], pow10_u64[p] - 1);
+    return {d, e10 - p + 1, p};
+}
+
+/// Drop trailing zero digits.
+inline decimal trim_zeros(decimal d) noexcept {
+    while (d.count > 1 && d.digits % 10 == 0) {
+        d.digits /= 10;
+        ++d.exp10;
+        --d.count;
+    }
+    return d;
+}
+
+template <size_t N>
+inline constexpr uint64_t magnitude_mask = (uint64_t{1} << (N - 1)) - 1;
+
+/// Exact ℓ of a nonzero magnitude pattern (the low N-1 bits).
+template <size_t N>
+inline long double ell_of_magnitude(uint64_t u) noexcept {
+    const bool D = (u >> (N - 2)) & 1u;
+    const uint32_t R = static_cast<uint32_t>((u >> (N - 5)) & 7u);
+    const uint32_t r = D ? R : 7u - R;
+    const size_t p = N - 5 - r;
+    const uint64_t c_bits = r ? (u >> p) & ((uint64_t{1} << r) - 1) : 0;
+    const int64_t c = D ? static_cast<int64_t>((uint64_t{1} << r) - 1 + c_bits)
+                        : -(int64_t{1} << (r + 1)) + 1 + static_cast<int64_t>(c_bits);
+    const uint64_t m_bits = p ? u & ((uint64_t{1} << p) - 1) : 0;
+    return static_cast<long double>(c) + static_cast<long double>(m_bits) / static_cast<long double>(uint64_t{1} << p);
+}
+
+/// Nearest magnitude pattern (ties to even) for ℓ in [ℓ(1), ℓ(max)].
+template <size_t N>
+inline uint64_t magnitude_of_ell(long double ell) noexcept {
+    const int64_t c = floor_to_int(ell);
+    const bool D = c >= 0;
+    const uint32_t r = std::min<uint32_t>(
+        7u, static_cast<uint32_t>(std::bit_width(static_cast<uint64_t>(D ? c + 1 : -c))) - 1u);
+    const uint32_t R = D ? r : 7u - r;
+    const size_t p = N - 5 - r;
+    const uint64_t c_bits = r == 0 ? 0
+        : D ? static_cast<uint64_t>(c - ((int64_t{1} << r) - 1))
+            : static_cast<uint64_t>(c + ((int64_t{1} << (r + 1)) - 1));
+    const long double scaled = (ell - static_cast<long double>(c)) * static_cast<long double>(uint64_t{1} << p);
+    const uint64_t m_bits = static_cast<uint64_t>(scaled);
+    const long double frac = scaled - static_cast<long double>(m_bits);
+    uint64_t u = (uint64_t{D} << (N - 2)) | (uint64_t{R} << (N - 5)) | (c_bits << p) | m_bits;
+    // Mantissa overflow carries into the next characteristic: magnitudes are contiguous in ℓ.
+    if (frac > 0.5L || (frac == 0.5L && (u & 1u))) ++u;
+    return std::min(u, magnitude_mask<N>);
+}
+
+/// ℓ of minpos/maxpos and the half-gap limits beyond which parsing overflows.
+struct ell_range {
+    long double min, max, min_limit, max_limit;
+};
+
+template <size_t N>
+inline ell_range make_ell_range() noexcept {
+    constexpr uint64_t top = magnitude_mask<N>;
+    const long double lo = ell_of_magnitude<N>(1);
+    const long double hi = ell_of_magnitude<N>(top);
+    return {lo, hi, lo - 0.5L * (ell_of_magnitude<N>(2) - lo), hi + 0.5L * (hi - ell_of_magnitude<N>(top - 1))};
+}
+
+/// Round digits × 10^exp10 (digits > 0) to a magnitude pattern.
+template <size_t N>
+inline std::errc magnitude_of_decimal(uint64_t digits, int exp10, uint64_t& u) noexcept {
+    const int nd = digit_count(digits);
+    const long double m = static_cast<long double>(digits) / static_cast<long double>(pow10_u64[nd - 1]);
+    const long double e = static_cast<long double>(exp10 + nd - 1);
+    const long double ell = 2.0L * (e * ln10_hi + (logl(m) + e * ln10_lo));
+
+    static const ell_range range = make_ell_range<N>();
+    if (ell >= range.max) {
+        if (ell > range.max_limit) return std::errc::result_out_of_range;
+        u = magnitude_mask<N>;
+        return {};
+    }
+    if (ell <= range.min) {
+        if (ell < range.min_limit) return std::errc::result_out_of_range;
+        u = 1;
+        return {};
+    }
+    u = magnitude_of_ell<N>(ell);
+    return {};
+}
+
+/// e^t - 1, cheaply for the tiny half-gaps of wide formats.
+inline long double expm1_small(long double t) noexcept {
+    if (fabsl(t) >= 1e-3L) return expm1l(t);
+    return t * (1.0L + t * (0.5L + t * (1.0L / 6 + t * (1.0L / 24 + t * (1.0L / 120)))));
+}
+
+/// Shortest decimal that rounds back to magnitude @p u.
+template <size_t N>
+inline decimal shortest_decimal(uint64_t u) noexcept {
+    constexpr uint64_t top = magnitude_mask<N>;
+    const long double ell = ell_of_magnitude<N>(u);
+    const long double below = u > 1 ? ell - ell_of_magnitude<N>(u - 1) : ell_of_magnitude<N>(u + 1) - ell;
+    const long double above = u < top ? ell_of_magnitude<N>(u + 1) - ell : below;
+    const long double v = expl(0.5L * ell);
+    auto round_trips = [&](uint64_t digits, int exp10) {
+        uint64_t back = 0;
+        return magnitude_of_decimal<N>(digits, exp10, back) == std::errc{} && back == u;
+    };
+
+    // Fast path: scale the midpoint interval (ℓ ± gap/2 → v·e^(±gap/4)) to 18
+    // digits and strip digits while it still contains an integer.
+    int k = 17 - static_cast<int>(floor_to_int(ell * (0.5L / ln10_ld)));
+    long double v_s = scale10(v, k);
+    if (v_s >= 1e18L) {
+        v_s /= 10.0L;
+        --k;
+    } else if (v_s < 1e17L) {
+        v_s *= 10.0L;
+        ++k;
+    }
+    const long double lo_s = v_s + v_s * expm1_small(-0.25L * below);
+    const long double hi_s = v_s + v_s * expm1_small(0.25L * above);
+    uint64_t lo = static_cast<uint64_t>(lo_s) + 1;
+    uint64_t hi = static_cast<uint64_t>(hi_s);
+    if (static_cast<long double>(hi) == hi_s) --hi;
+    if (lo <= hi) {
+        int removed = 0;
+        while ((lo + 9) / 10 <= hi / 10) {
+            lo = (lo + 9) / 10;
+            hi /= 10;
+            ++removed;
+        }
+        const uint64_t near = round_to_uint(v_s / pow10_ld(removed));
+        const uint64_t cand = std::clamp(near, lo, hi);
+        // Scaling and the parser's ℓ are good to a few long double ulps (which
+        // grow with |ℓ|); only candidates that close to a midpoint need the exact check.
+        const long double c_s = static_cast<long double>(cand) * pow10_ld(removed);
+        const long double margin = v_s * (2e-18L + fabsl(ell) * 4e-19L);
+        if ((c_s - lo_s > margin && hi_s - c_s > margin) || round_trips(cand, removed - k)) {
+            return trim_zeros({cand, removed - k, digit_count(cand)});
+        }
+    }
+
+    // Slow path: grow the digit count from the bound implied by the interval width.
+    const long double width = 0.5L * (below + above);
+    int p = std::max(1, static_cast<int>(floorl(log10l(2.0L / width))) - 1);
+    for (; p <= max_decimal_digits; ++p) {
+        const decimal d = round_significant(v, p);
+        for (int delta : {0, -1, 1}) {
+            const uint64_t cand = d.digits + static_cast<uint64_t>(static_cast<int64_t>(delta));
+            if (cand < pow10_u64[p - 1] || cand >= pow10_u64[p]) continue;
+            if (round_trips(cand, d.exp10)) return trim_zeros({cand, d.exp10, p});
+        }
+    }
+    // Only takum64 near 1 gets here: its half-gaps are narrower than a 19th digit.
+    const decimal d = round_significant(v, max_decimal_digits);
+    if (d.digits < max_20_digit_prefix) {
+        const uint64_t near = round_to_uint(scale10(v, 1 - d.exp10));
+        for (int delta : {0, -1, 1}) {
+            const uint64_t cand = near + static_cast<uint64_t>(static_cast<int64_t>(delta));
+            if (round_trips(cand, d.exp10 - 1)) return trim_zeros({cand, d.exp10 - 1, 20});
+        }
+    }
+    return trim_zeros(d);
+}
+
+/// Bounds-checked output cursor.
+struct char_writer {
+    char* p;
+    char* last;
+    bool ok = true;
+
+    void put(char c) noexcept {
+        if (p == last) { ok = false; return; }
+        *p++ = c;
+    }
+    void fill(char c, size_t n) noexcept {
+        if (static_cast<size_t>(last - p) < n) { ok = false; p = last; return; }
+        p = std::fill_n(p, n, c);
+    }
+    void digits(uint64_t v, int count) noexcept {
+        char buf[20];
+        for (int i = count - 1; i >= 0; --i) {
+            buf[i] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        }
+        if (last - p < count) { ok = false; p = last; return; }
+        p = std::copy_n(buf, count, p);
+    }
+    std::to_chars_result result() const noexcept {
+        return ok ? std::to_chars_result{p, std::errc{}} : std::to_chars_result{last, std::errc::value_too_large};
+    }
+};
+
+/// Write d in fixed notation with exactly @p frac fractional digits (frac ≥ -d.exp10).
+inline void write_fixed(char_writer& w, const decimal& d, int frac) noexcept {
+    if (d.exp10 >= 0) {
+        w.digits(d.digits, d.count);
+        w.fill('0', static_cast<size_t>(d.exp10));
+        if (frac > 0) {
+            w.put('.');
+            w.fill('0', static_cast<size_t>(frac));
+        }
+        return;
+    }
+    const int after = -d.exp10;
+    if (d.count > after) {
+        w.digits(d.digits / pow10_u64[after], d.count - after);
+    } else {
+        w.put('0');
+    }
+    if (frac == 0) return;
+    w.put('.');
+    if (d.count > after) {
+        w.digits(d.digits % pow10_u64[after], after);
+    } else {
+        w.fill('0', static_cast<size_t>(after - d.count));
+        w.digits(d.digits, d.count);
+    }
+    w.fill('0', static_cast<size_t>(frac - after));
+}
+
+/// Write d as d.ddd…e±XX with exactly @p frac fractional digits (frac ≥ d.count - 1).
+inline void write_scientific(char_writer& w, const decimal& d, int frac) noexcept {
+    const uint64_t lead_scale = pow10_u64[d.count - 1];
+    w.digits(d.digits / lead_scale, 1);
+    if (frac > 0) {
+        w.put('.');
+        if (d.count > 1) w.digits(d.digits % lead_scale, d.count - 1);
+        w.fill('0', static_cast<size_t>(frac - (d.count - 1)));
+    }
+    int x = d.digits == 0 ? 0 : d.exp10 + d.count - 1;
+    w.put('e');
+    w.put(x < 0 ? '-' : '+');
+    x = x < 0 ? -x : x;
+    w.digits(static_cast<uint64_t>(x), std::max(2, digit_count(static_cast<uint64_t>(x))));
+}
+
+/// Length of d in fixed / scientific shortest form (excluding sign).
+inline int fixed_length(const decimal& d) noexcept {
+    if (d.exp10 >= 0) return d.count + d.exp10;
+    const int after = -d.exp10;
+    return (d.count > after ? d.count - after : 1) + 1 + after;
+}
+
+inline int scientific_length(const decimal& d) noexcept {
+    const int x = d.exp10 + d.count - 1;
+    const int ax = x < 0 ? -x : x;
+    return d.count + (d.count > 1 ? 1 : 0) + 2 + std::max(2, digit_count(static_cast<uint64_t>(ax)));
+}
+
+/// Exactly rounded-to-@p frac-places fixed digits of v (beyond 19 significant digits, zeros).
+inline decimal round_fixed(long double v, int frac) noexcept {
+    const int e10 = static_cast<int>(floorl(log10l(v)));
+    if (e10 + 1 + frac > max_decimal_digits) return round_significant(v, max_decimal_digits);
+    const uint64_t d = round_to_uint(scale10(v, frac));
+    return {d, -frac, d == 0 ? 1 : digit_count(d)};
+}
+
+inline bool ascii_iequal(const char* first, const char* last, const char* word) noexcept {
+    for (; *word; ++word, ++first) {
+        if (first == last) return false;
+        char c = *first;
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != *word) return false;
+    }
+    return true;
+}
+
+} // namespace internal
+
+/**
+ * @brief Format @p x in the requested style with @p precision digits.
+ *
+ * `fixed`: @p precision fractional digits; `scientific`: @p precision digits
+ * after the leading one; `general`: `%g` rules with @p precision significant
+ * digits and trailing zeros removed; `hex`: the raw pattern (precision ignored).
+ * A negative precision means 6. Digits past what long double resolves
+ * (about 19 significant) are written as zeros.
+ */
+template <size_t N>
+inline std::to_chars_result to_chars(char* first, char* last, const takum<N>& x, std::chars_format fmt,
+                                     int precision) noexcept {
+    static_assert(N >= 12 && N <= 64, "takum::to_chars: supported for 12 <= N <= 64");
+    using namespace internal;
+    char_writer w{first, last};
+    const uint64_t bits = static_cast<uint64_t>(x.raw_bits());
+    if (fmt == std::chars_format::hex) {
+        const auto r = std::to_chars(first, last, bits, 16);
+        return r.ec == std::errc{} ? r : std::to_chars_result{last, std::errc::value_too_large};
+    }
+    if (x.is_nar()) {
+        for (const char* s = "NaR"; *s; ++s) w.put(*s);
+        return w.result();
+    }
+    if (precision < 0) precision = 6;
+    const uint64_t u = bits & magnitude_mask<N>;
+    if ((bits >> (N - 1)) & 1u) w.put('-');
+    const long double v = u == 0 ? 0.0L : expl(0.5L * ell_of_magnitude<N>(u));
+
+    if (fmt == std::chars_format::fixed) {
+        write_fixed(w, u == 0 ? decimal{0, 0, 1} : round_fixed(v, precision), precision);
+        return w.result();
+    }
+    if (fmt == std::chars_format::scientific) {
+        write_scientific(w, u == 0 ? decimal{0, 0, 1} : round_significant(v, std::min(precision + 1, max_decimal_digits)),
+                         precision);
+        return w.result();
+    }
+    // general
+    const int p = std::min(precision == 0 ? 1 : precision, max_decimal_digits);
+    if (u == 0) {
+        w.put('0');
+        return w.result();
+    }
+    const decimal d = round_significant(v, p);
+    const int exp = d.exp10 + d.count - 1;
+    const decimal t = trim_zeros(d);
+    if (exp >= -4 && exp < (precision == 0 ? 1 : precision)) {
+        write_fixed(w, t, std::max(0, -t.exp10));
+    } else {
+        write_scientific(w, t, t.count - 1);
+    }
+    return w.result();
+}
+
+/**
+ * @brief Format @p x with the shortest round-tripping digits in style @p fmt.
+ *
+ * `general` behaves like the format-less overload.
+ */
+template <size_t N>
+inline std::to_chars_result to_chars(char* first, char* last, const takum<N>& x, std::chars_format fmt) noexcept {
+    static_assert(N >= 12 && N <= 64, "takum::to_chars: supported for 12 <= N <= 64");
+    using namespace internal;
+    if (fmt == std::chars_format::hex || x.is_nar()) return to_chars(first, last, x, fmt, 0);
+    char_writer w{first, last};
+    const uint64_t bits = static_cast<uint64_t>(x.raw_bits());
+    const uint64_t u = bits & magnitude_mask<N>;
+    if ((bits >> (N - 1)) & 1u) w.put('-');
+    const decimal d = u == 0 ? decimal{0, 0, 1} : shortest_decimal<N>(u);
+    const bool fixed = fmt == std::chars_format::fixed ||
+                       (fmt != std::chars_format::scientific && fixed_length(d) <= scientific_length(d));
+    if (fixed) write_fixed(w, d, std::max(0, -d.exp10));
+    else write_scientific(w, d, d.count - 1);
+    return w.result();
+}
+
+/**
+ * @brief Write the shortest decimal string that from_chars maps back to @p x.
+ *
+ * Uses fixed or scientific notation, whichever is shorter (fixed on ties).
+ */
+template <size_t N>
+inline std::to_chars_result to_chars(char* first, char* last, const takum<N>& x) noexcept {
+    return to_chars(first, last, x, std::chars_format::general);
+}
+
+/**
+ * @brief Parse a decimal (or, with `chars_format::hex`, a raw hex pattern) into @p value.
+ *
+ * Accepts an optional leading '-', digits with an optional '.', and an
+ * exponent as allowed by @p fmt, plus "nar" / "nan" / "inf" / "infinity"
+ * (case-insensitive) for NaR. On failure @p value is left unchanged.
+ */
+template <size_t N>
+inline std::from_chars_result from_chars(const char* first, const char* last, takum<N>& value,
+                                         std::chars_format fmt = std::chars_format::general) noexcept {
+    static_assert(N >= 12 && N <= 64, "takum::from_chars: supported for 12 <= N <= 64");
+    using namespace internal;
+    using storage_t = typename takum<N>::storage_t;
+    const char* p = first;
+
+    if (fmt == std::chars_format::hex) {
+        uint64_t bits = 0;
+        const auto r = std::from_chars(first, last, bits, 16);
+        if (r.ec != std::errc{}) return r;
+        if constexpr (N < 64) {
+            if (bits >> N) return {r.ptr, std::errc::result_out_of_range};
+        }
+        value = takum<N>::from_raw_bits(static_cast<storage_t>(bits));
+        return r;
+    }
+
+    const bool negative = p != last && *p == '-';
+    if (negative) ++p;
+    for (const char* word : {"infinity", "inf", "nar", "nan"}) {
+        if (ascii_iequal(p, last, word)) {
+            value = takum<N>::nar();
+            return {p + std::strlen(word), std::errc{}};
+        }
+    }
+
+    uint64_t digits = 0;
+    int kept = 0;
+    int exp10 = 0;
+    bool any = false;
+    bool round_up = false;
+    bool dropped = false;
+    auto take = [&](int d, bool after_point) {
+        any = true;
+        if (digits == 0 && d == 0) {
+            if (after_point) --exp10;
+            return;
+        }
+        if (kept < max_decimal_digits || (kept == max_decimal_digits && digits < max_20_digit_prefix)) {
+            digits = digits * 10 + static_cast<uint64_t>(d);
+            ++kept;
+            if (after_point) --exp10;
+        } else {
+            if (!dropped) round_up = d >= 5;
+            dropped = true;
+            if (!after_point) ++exp10;
+        }
+    };
+    for (; p != last && *p >= '0' && *p <= '9'; ++p) take(*p - '0', false);
+    if (p != last && *p == '.') {
+        const char* point = p++;
+        const bool had_digits = any;
+        for (; p != last && *p >= '0' && *p <= '9'; ++p) take(*p - '0', true);
+        if (!had_digits && p == point + 1) return {first, std::errc::invalid_argument};
+    }
+    if (!any) return {first, std::errc::invalid_argument};
+
+    const bool allow_exp = fmt != std::chars_format::fixed;
+    bool have_exp = false;
+    if (allow_exp && p != last && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        const bool exp_negative = q != last && *q == '-';
+        if (q != last && (*q == '-' || *q == '+')) ++q;
+        if (q != last && *q >= '0' && *q <= '9') {
+            int e = 0;
+            for (; q != last && *q >= '0' && *q <= '9'; ++q) e = std::min(e * 10 + (*q - '0'), 100000);
+            exp10 += exp_negative ? -e : e;
+            p = q;
+            have_exp = true;
+        }
+    }
+    if (fmt == std::chars_format::scientific && !have_exp) return {first, std::errc::invalid_argument};
+
+    if (digits == 0) {
+        value = takum<N>{};
+        return {p, std::errc{}};
+    }
+    if (round_up) ++digits;
+    uint64_t u = 0;
+    if (const std::errc ec = magnitude_of_decimal<N>(digits, exp10, u); ec != std::errc{}) return {p, ec};
+    value = takum<N>::from_raw_bits(static_cast<storage_t>((negative ? uint64_t{1} << (N - 1) : 0) | u));
+    return {p, std::errc{}};
+}
+
+} // namespace takum
@@ -0,0 +1,229 @@
+/**
+ * @file classify.h
+ * @brief Bulk NaR screening, classification and stream compaction over spans.
+ *
+ * Data-cleaning kernels that look only at raw bit patterns: `count_nar`,
+ * `any_nar`, `nar_mask` (LSB-first bitmap, the inverse of an Arrow validity
+ * bitmap), `classify` (zero / positive / negative / NaR per element),
+ * `remove_nar` and `compact_if`. The per-element tests are branch-free
+ * compares on the storage words, so the loops vectorise; the counting and
+ * NaR-removal kernels split across worker threads above TAKUM_PARALLEL_GRAIN
+ * elements.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/internal/parallel.h"
+
+namespace takum {
+
+/**
+ * @brief Category of a takum value, as produced by classify().
+ */
+enum class takum_class : uint8_t {
+    zero = 0,
+    positive = 1,
+    negative = 2,
+    nar = 3
+};
+
+namespace internal {
+
+/// @brief NaR test on the raw pattern (the sign bit alone).
+template <size_t N>
+inline bool nar_bits(const takum<N>& t) noexcept {
+    return t.is_nar();
+}
+
+/// @brief Branch-free category of one pattern.
+template <size_t N>
+inline takum_class class_bits(const takum<N>& t) noexcept {
+    const bool sign = t.signbit();
+    bool rest_zero;
+    if constexpr (N <= 64) {
+        using storage_t = typename takum<N>::storage_t;
+        constexpr storage_t low_mask = (storage_t{1} << (N - 1)) - 1;
+        rest_zero = (t.storage & low_mask) == 0;
+    } else {
+        rest_zero = t.is_zero() || t.is_nar();
+    }
+    // zero: 0, positive: 1, negative: 2, NaR: 3
+    const unsigned s = sign ? 1u : 0u;
+    return static_cast<takum_class>(rest_zero ? 3u * s : 1u + s);
+}
+
+/// @brief Serial NaR removal. NaRs are rare in practice, so unlike compact_if
+/// this branches on the (well-predicted) test and only stores survivors.
+template <size_t N>
+inline size_t copy_non_nar(std::span<const takum<N>> in, std::span<takum<N>> out) noexcept {
+    const takum<N>* src = in.data();
+    takum<N>* dst = out.data();
+    size_t k = 0;
+    if (out.size() >= in.size()) { // common case: no capacity check per element
+        for (size_t i = 0; i < in.size(); ++i) {
+            if (!nar_bits(src[i])) TAKUM_LIKELY dst[k++] = src[i];
+        }
+        return k;
+    }
+    for (size_t i = 0; i < in.size() && k < out.size(); ++i) {
+        if (!nar_bits(src[i])) TAKUM_LIKELY dst[k++] = src[i];
+    }
+    return k;
+}
+
+/// @brief LSB-first bitmap bytes for the 64-element groups [g_begin, g_end)
+/// of the first @p n elements of @p p: bit j of group g is `test(p[64 * g + j])`.
+/// Trailing bits of the last byte are cleared. Returns the number of set bits.
+template <size_t N, typename Test>
+inline size_t mask_groups(const takum<N>* p, size_t n, uint8_t* bits, size_t g_begin, size_t g_end,
+                          Test&& test) noexcept {
+    const size_t bytes = (n + 7) / 8;
+    size_t count = 0;
+    for (size_t g = g_begin; g < g_end; ++g) {
+        const size_t first = g * 64;
+        const size_t len = std::min<size_t>(64, n - first);
+        const takum<N>* q = p + first;
+        uint64_t word = 0;
+        if (len == 64) {
+            for (size_t j = 0; j < 64; ++j) word |= static_cast<uint64_t>(static_cast<bool>(test(q[j]))) << j;
+        } else {
+            for (size_t j = 0; j < len; ++j) word |= static_cast<uint64_t>(static_cast<bool>(test(q[j]))) << j;
+        }
+        count += static_cast<size_t>(std::popcount(word));
+        const size_t byte_end = std::min(bytes, (g + 1) * 8);
+        for (size_t b = g * 8; b < byte_end; ++b) bits[b] = static_cast<uint8_t>(word >> (8 * (b - g * 8)));
+    }
+    return count;
+}
+
+} // namespace internal
+
+/**
+ * @brief Number of NaR elements in @p in.
+ */
+template <size_t N>
+inline size_t count_nar(std::span<const takum<N>> in) {
+    std::vector<size_t> partial(internal::worker_count(in.size()), 0);
+    internal::parallel_for(in.size(), [&](size_t begin, size_t end, size_t w) {
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i) count += internal::nar_bits(in[i]) ? 1 : 0;
+        partial[w] = count;
+    });
+    size_t total = 0;
+    for (size_t c : partial) total += c;
+    return total;
+}
+
+/**
+ * @brief True when @p in contains a NaR.
+ *
+ * Scans in fixed blocks without early exit inside a block, so each block
+ * stays a straight-line reduction; returns after the first block that hits.
+ */
+template <size_t N>
+inline bool any_nar(std::span<const takum<N>> in) {
+    constexpr size_t block = 256;
+    for (size_t base = 0; base < in.size(); base += block) {
+        const size_t end = std::min(in.size(), base + block);
+        bool hit = false;
+        for (size_t i = base; i < end; ++i) hit |= internal::nar_bits(in[i]);
+        if (hit) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Write an LSB-first bitmap with bit i set iff in[i] is NaR.
+ *
+ * Covers `min(in.size(), 8 * bits.size())` elements; unused bits of the last
+ * byte written are cleared. Inverting the bytes gives an Arrow validity bitmap.
+ *
+ * @return Number of NaR elements found
+ */
+template <size_t N>
+inline size_t nar_mask(std::span<const takum<N>> in, std::span<uint8_t> bits) {
+    const size_t n = std::min(in.size(), bits.size() * 8);
+    // Workers own whole 64-element groups (8 bitmap bytes) so no byte is shared.
+    const size_t groups = (n + 63) / 64;
+    constexpr size_t grain = TAKUM_PARALLEL_GRAIN / 64;
+    std::vector<size_t> partial(internal::worker_count(groups, grain), 0);
+    internal::parallel_for(groups, [&](size_t begin, size_t end, size_t w) {
+        partial[w] = internal::mask_groups<N>(in.data(), n, bits.data(), begin, end,
+                                              [](const takum<N>& t) { return internal::nar_bits(t); });
+    }, grain);
+    size_t total = 0;
+    for (size_t c : partial) total += c;
+    return total;
+}
+
+/**
+ * @brief Category of each element: `out[i] = takum_class` of `in[i]`.
+ *
+ * Converts `min(in.size(), out.size())` elements.
+ */
+template <size_t N>
+inline void classify(std::span<const takum<N>> in, std::span<takum_class> out) {
+    const size_t n = std::min(in.size(), out.size());
+    internal::parallel_for(n, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) out[i] = internal::class_bits(in[i]);
+    });
+}
+
+/**
+ * @brief Copy the elements satisfying @p pred to the front of @p out, in order.
+ *
+ * Runs serially, calling `pred(in[i])` exactly once per element; the store is
+ * unconditional and the cursor advances by the predicate, so the loop has no
+ * data-dependent branch. Stops when @p out is full.
+ *
+ * @return Number of elements written
+ */
+template <size_t N, typename Pred>
+inline size_t compact_if(std::span<const takum<N>> in, std::span<takum<N>> out, Pred&& pred) {
+    size_t k = 0;
+    const size_t cap = out.size();
+    for (size_t i = 0; i < in.size() && k < cap; ++i) {
+        out[k] = in[i];
+        k += pred(in[i]) ? 1 : 0;
+    }
+    return k;
+}
+
+/**
+ * @brief Copy the non-NaR elements of @p in to the front of @p out, in order.
+ *
+ * Two passes on raw bits when threaded: each worker counts the survivors of
+ * its chunk, then writes them at its prefix offset. Elements past `out.size()` survivors are
+ * dropped. @p out must not overlap @p in.
+ *
+ * @return Number of elements written
+ */
+template <size_t N>
+inline size_t remove_nar(std::span<const takum<N>> in, std::span<takum<N>> out) {
+    const size_t n = in.size();
+    const size_t workers = internal::worker_count(n);
+    if (workers == 1) return internal::copy_non_nar<N>(in, out);
+    std::vector<size_t> offset(workers + 1, 0);
+    internal::parallel_for(n, [&](size_t begin, size_t end, size_t w) {
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i) count += internal::nar_bits(in[i]) ? 0 : 1;
+        offset[w + 1] = count;
+    });
+    for (size_t w = 0; w < workers; ++w) offset[w + 1] += offset[w];
+    internal::parallel_for(n, [&](size_t begin, size_t end, size_t w) {
+        const size_t first = std::min(offset[w], out.size());
+        const size_t last = std::min(offset[w + 1], out.size());
+        internal::copy_non_nar<N>(in.subspan(begin, end - begin), out.subspan(first, last - first));
+    });
+    return std::min(offset[workers], out.size());
+}
+
+} // namespace takum
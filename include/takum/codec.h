@@ -0,0 +1,494 @@
+/**
+ * @file codec.h
+ * @brief Lossless block codec for takum<N> streams (predictor + zigzag + PFOR bit-packing).
+ *
+ * Takum patterns are monotonic in the value they encode, so for smooth or
+ * sorted series neighbouring raw patterns differ by small integers. The codec
+ * exploits that directly on the integer patterns:
+ *
+ * 1. **Predictor** (per block): `none`, `delta` (difference to the previous
+ *    sign-extended pattern) or `xor_prev` (XOR with the previous pattern).
+ *    `automatic` tries all three and keeps the smallest encoding.
+ * 2. **Zigzag** maps signed residuals to small unsigned integers
+ *    (`none`/`delta` only).
+ * 3. **Frame of reference + patched bit-packing (PFOR)**: residuals are
+ *    offset by the block minimum and packed at the bit width b that minimises
+ *    the block size; the few values needing more than b bits are stored as
+ *    exceptions (16-bit position + high bits).
+ *
+ * **Frame layout** (all integers little-endian):
+ * ```
+ * header  "TKZ1" u8 version u8 N u16 0 u32 block_size u32 block_count u64 count
+ * index   block_count × u64 byte offset of each block from the frame start
+ *         u32 CRC-32 of header + index
+ * block   u8 predictor u8 b u8 exception_bits u8 0 u32 count u32 exceptions u32 0
+ *         u64 anchor u64 base
+ *         packed residuals, exception positions (u16), packed exception high bits
+ *         u32 CRC-32 of the block
+ * ```
+ * The block index gives random access (`decompress_block`); each block is
+ * checksummed independently so corruption is detected and localised.
+ *
+ * Compression and decompression run in parallel over blocks for large
+ * inputs. Decoding is portable scalar code: branch-light fixed-width
+ * unpacking (one kernel per bit width) followed by the inverse predictor.
+ * There are no hand-written SIMD kernels; bench_codec measures about
+ * 0.6-0.8 GB/s of decompression per core.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/result.h"
+#include "takum/internal/bitpack.h"
+#include "takum/internal/byte_io.h"
+#include "takum/internal/checksum.h"
+#include "takum/internal/parallel.h"
+
+namespace takum::codec {
+
+/// @brief Residual predictor applied to each block.
+enum class predictor : uint8_t {
+    none = 0,       ///< Zigzag of the sign-extended pattern itself
+    delta = 1,      ///< Zigzag of the difference to the previous pattern
+    xor_prev = 2,   ///< XOR with the previous pattern
+    automatic = 255 ///< Choose the smallest of the above per block
+};
+
+/// @brief Compression options.
+struct options {
+    predictor pred = predictor::automatic; ///< Predictor (or automatic choice per block)
+    uint32_t block_size = 4096;            ///< Elements per block (1..65536)
+};
+
+/// @brief Summary of a frame, read from its header.
+struct frame_info {
+    size_t width = 0;       ///< Takum width N
+    size_t count = 0;       ///< Total elements
+    size_t block_size = 0;  ///< Elements per block
+    size_t block_count = 0; ///< Number of blocks
+};
+
+namespace internal {
+
+using namespace ::takum::internal;
+
+inline constexpr uint8_t frame_magic[4] = {'T', 'K', 'Z', '1'};
+inline constexpr uint8_t frame_version = 1;
+inline constexpr size_t frame_header_bytes = 24;
+inline constexpr size_t block_header_bytes = 32;
+inline constexpr uint32_t max_block_size = 65536;
+
+/// Append packed 64-bit words as little-endian bytes.
+inline void put_words(std::vector<uint8_t>& out, const std::vector<uint64_t>& words) {
+    const size_t at = out.size();
+    out.resize(at + words.size() * 8);
+    if constexpr (std::endian::native == std::endian::little) {
+        if (!words.empty()) std::memcpy(out.data() + at, words.data(), words.size() * 8);
+    } else {
+        for (size_t i = 0; i < words.size(); ++i) {
+            for (size_t b = 0; b < 8; ++b) out[at + i * 8 + b] = static_cast<uint8_t>(words[i] >> (8 * b));
+        }
+    }
+}
+
+/// Read @p n little-endian words (unaligned source) into @p words.
+inline void get_words(const uint8_t* p, size_t n, uint64_t* words) noexcept {
+    if constexpr (std::endian::native == std::endian::little) {
+        if (n) std::memcpy(words, p, n * 8);
+    } else {
+        for (size_t i = 0; i < n; ++i) words[i] = load_le(p + i * 8, 8);
+    }
+}
+
+inline uint64_t zigzag(uint64_t v) noexcept {
+    return (v << 1) ^ (0ULL - (v >> 63));
+}
+
+inline uint64_t unzigzag(uint64_t v) noexcept {
+    return (v >> 1) ^ (0ULL - (v & 1ULL));
+}
+
+/// Sign-extend an N-bit pattern to 64 bits.
+template <size_t N>
+inline uint64_t sign_extend(uint64_t v) noexcept {
+    if constexpr (N == 64) return v;
+    else return static_cast<uint64_t>(static_cast<int64_t>(v << (64 - N)) >> (64 - N));
+}
+
+/// Residuals of one block under predictor @p p; returns the anchor.
+template <size_t N>
+inline uint64_t predict(std::span<const uint64_t> v, predictor p, uint64_t* r) noexcept {
+    switch (p) {
+    case predictor::delta: {
+        uint64_t prev = sign_extend<N>(v[0]);
+        for (size_t i = 0; i < v.size(); ++i) {
+            const uint64_t cur = sign_extend<N>(v[i]);
+            r[i] = zigzag(cur - prev);
+            prev = cur;
+        }
+        return v[0];
+    }
+    case predictor::xor_prev: {
+        uint64_t prev = v[0];
+        for (size_t i = 0; i < v.size(); ++i) {
+            r[i] = v[i] ^ prev;
+            prev = v[i];
+        }
+        return v[0];
+    }
+    default:
+        for (size_t i = 0; i < v.size(); ++i) r[i] = zigzag(sign_extend<N>(v[i]));
+        return 0;
+    }
+}
+
+/// Inverse of predict(); writes N-bit patterns back into @p r in place.
+template <size_t N>
+inline void unpredict(predictor p, uint64_t anchor, uint64_t* r, size_t n) noexcept {
+    constexpr uint64_t mask = low_mask(N);
+    switch (p) {
+    case predictor::delta: {
+        uint64_t acc = sign_extend<N>(anchor);
+        for (size_t i = 0; i < n; ++i) {
+            acc += unzigzag(r[i]);
+            r[i] = acc & mask;
+        }
+        break;
+    }
+    case predictor::xor_prev: {
+        uint64_t acc = anchor;
+        for (size_t i = 0; i < n; ++i) {
+            acc ^= r[i];
+            r[i] = acc;
+        }
+        break;
+    }
+    default:
+        for (size_t i = 0; i < n; ++i) r[i] = unzigzag(r[i]) & mask;
+        break;
+    }
+}
+
+/// PFOR layout chosen for a residual block.
+struct pfor_plan {
+    uint64_t base = 0;
+    uint8_t bits = 0;
+    uint8_t exception_bits = 0;
+    uint32_t exceptions = 0;
+    size_t bytes = 0; ///< Encoded block size including header and CRC
+};
+
+/// Subtract the block minimum from @p r and choose the cheapest bit width.
+inline pfor_plan plan_pfor(uint64_t* r, size_t n) noexcept {
+    pfor_plan plan;
+    plan.base = *std::min_element(r, r + n);
+    std::array<uint32_t, 65> hist{};
+    for (size_t i = 0; i < n; ++i) {
+        r[i] -= plan.base;
+        ++hist[static_cast<size_t>(std::bit_width(r[i]))];
+    }
+    size_t max_bits = 64;
+    while (max_bits > 0 && hist[max_bits] == 0) --max_bits;
+
+    size_t best = SIZE_MAX;
+    uint32_t above = 0; // values needing more than b bits
+    for (size_t b = max_bits + 1; b-- > 0;) {
+        const size_t eb = max_bits - b;
+        const size_t bytes = packed_words(n, b) * 8 + size_t{above} * 2 + packed_words(above, eb) * 8;
+        if (bytes <= best) {
+            best = bytes;
+            plan.bits = static_cast<uint8_t>(b);
+            plan.exception_bits = static_cast<uint8_t>(eb);
+            plan.exceptions = above;
+        }
+        above += hist[b];
+    }
+    plan.bytes = block_header_bytes + best + 4;
+    return plan;
+}
+
+/// Encode one block of raw patterns into @p out.
+template <size_t N>
+inline void encode_block(std::span<const uint64_t> v, predictor pred, std::vector<uint8_t>& out) {
+    const size_t n = v.size();
+    std::vector<uint64_t> r(n);
+    uint64_t anchor = 0;
+    pfor_plan plan;
+    if (pred == predictor::automatic) {
+        std::vector<uint64_t> trial(n);
+        size_t best = SIZE_MAX;
+        for (predictor p : {predictor::delta, predictor::xor_prev, predictor::none}) {
+            const uint64_t a = predict<N>(v, p, trial.data());
+            const pfor_plan pl = plan_pfor(trial.data(), n);
+            if (pl.bytes < best) {
+                best = pl.bytes;
+                pred = p;
+                anchor = a;
+                plan = pl;
+                r.swap(trial);
+            }
+        }
+    } else {
+        anchor = predict<N>(v, pred, r.data());
+        plan = plan_pfor(r.data(), n);
+    }
+
+    std::vector<uint16_t> positions;
+    std::vector<uint64_t> highs;
+    positions.reserve(plan.exceptions);
+    highs.reserve(plan.exceptions);
+    const uint64_t keep = plan.bits ? low_mask(plan.bits) : 0ULL;
+    for (size_t i = 0; i < n; ++i) {
+        if (plan.bits < 64 && (r[i] >> plan.bits) != 0) {
+            positions.push_back(static_cast<uint16_t>(i));
+            highs.push_back(r[i] >> plan.bits);
+        }
+        r[i] &= keep;
+    }
+
+    const size_t start = out.size();
+    out.reserve(start + plan.bytes);
+    append_le(out, static_cast<uint8_t>(pred), 1);
+    append_le(out, plan.bits, 1);
+    append_le(out, plan.exception_bits, 1);
+    append_le(out, 0, 1);
+    append_le(out, n, 4);
+    append_le(out, positions.size(), 4);
+    append_le(out, 0, 4);
+    append_le(out, anchor, 8);
+    append_le(out, plan.base, 8);
+
+    std::vector<uint64_t> words(packed_words(n, plan.bits));
+    pack_array(plan.bits, r.data(), n, words.data());
+    put_words(out, words);
+    for (uint16_t pos : positions) append_le(out, pos, 2);
+    words.assign(packed_words(highs.size(), plan.exception_bits), 0ULL);
+    pack_array(plan.exception_bits, highs.data(), highs.size(), words.data());
+    put_words(out, words);
+
+    append_le(out, crc32(0, std::span<const uint8_t>(out.data() + start, out.size() - start)), 4);
+}
+
+/// Parsed and validated frame header.
+struct frame_view {
+    frame_info info;
+    const uint8_t* index = nullptr;
+};
+
+inline result<frame_view> parse_frame(std::span<const uint8_t> frame, size_t expected_width) {
+    if (frame.size() < frame_header_bytes + 4 || std::memcmp(frame.data(), frame_magic, 4) != 0) {
+        return fail(takum_error::Kind::DomainError, "codec: not a takum codec frame");
+    }
+    if (frame[4] != frame_version) return fail(takum_error::Kind::DomainError, "codec: unsupported frame version");
+    frame_view fv;
+    fv.info.width = frame[5];
+    fv.info.block_size = load_le(frame.data() + 8, 4);
+    fv.info.block_count = load_le(frame.data() + 12, 4);
+    fv.info.count = load_le(frame.data() + 16, 8);
+    if (expected_width != 0 && fv.info.width != expected_width) {
+        return fail(takum_error::Kind::DomainError, "codec: frame width does not match N");
+    }
+    if (fv.info.block_size == 0 || fv.info.block_size > max_block_size ||
+        fv.info.block_count != (fv.info.count + fv.info.block_size - 1) / fv.info.block_size) {
+        return fail(takum_error::Kind::DomainError, "codec: malformed frame header");
+    }
+    const size_t head = frame_header_bytes + fv.info.block_count * 8;
+    if (frame.size() < head + 4) return fail(takum_error::Kind::DomainError, "codec: truncated frame");
+    if (crc32(0, frame.first(head)) != load_le(frame.data() + head, 4)) {
+        return fail(takum_error::Kind::DomainError, "codec: header checksum mismatch");
+    }
+    fv.index = frame.data() + frame_header_bytes;
+    return fv;
+}
+
+/// Working buffers of decode_block(), reused across the blocks one thread decodes.
+struct block_scratch {
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> residuals;
+    std::vector<uint64_t> highs;
+};
+
+/// Decode block @p b of a parsed frame into @p out (exactly the block's element count).
+template <size_t N>
+inline result<size_t> decode_block(std::span<const uint8_t> frame, const frame_view& fv, size_t b,
+                                   std::span<takum<N>> out, block_scratch& scratch) {
+    const uint64_t at = load_le(fv.index + b * 8, 8);
+    if (at > frame.size() || frame.size() - at < block_header_bytes + 4) {
+        return fail(takum_error::Kind::DomainError, "codec: block offset out of range");
+    }
+    const uint8_t* p = frame.data() + at;
+    const auto pred = static_cast<predictor>(p[0]);
+    const size_t bits = p[1];
+    const size_t ebits = p[2];
+    const size_t n = load_le(p + 4, 4);
+    const size_t exc = load_le(p + 8, 4);
+    const uint64_t anchor = load_le(p + 16, 8);
+    const uint64_t base = load_le(p + 24, 8);
+    const size_t expected_n = std::min(fv.info.block_size, fv.info.count - b * fv.info.block_size);
+    // Exceptions are stored above the low `bits` bits, so together they must fit in 64.
+    if (bits > 64 || ebits > 64 || (exc > 0 && (bits == 64 || bits + ebits > 64)) ||
+        n != expected_n || exc > n || out.size() < n ||
+        (pred != predictor::none && pred != predictor::delta && pred != predictor::xor_prev)) {
+        return fail(takum_error::Kind::DomainError, "codec: malformed block header");
+    }
+    const size_t main_words = packed_words(n, bits);
+    const size_t exc_words = packed_words(exc, ebits);
+    const size_t body = block_header_bytes + main_words * 8 + exc * 2 + exc_words * 8;
+    if (frame.size() - at < body + 4) return fail(takum_error::Kind::DomainError, "codec: truncated block");
+    if (crc32(0, std::span<const uint8_t>(p, body)) != load_le(p + body, 4)) {
+        return fail(takum_error::Kind::DomainError, "codec: block checksum mismatch");
+    }
+
+    std::vector<uint64_t>& words = scratch.words;
+    std::vector<uint64_t>& r = scratch.residuals;
+    std::vector<uint64_t>& highs = scratch.highs;
+    words.resize(std::max({words.size(), main_words, exc_words}));
+    r.resize(std::max(r.size(), n));
+    get_words(p + block_header_bytes, main_words, words.data());
+    unpack_array(bits, words.data(), n, r.data());
+    if (exc) {
+        const uint8_t* pos = p + block_header_bytes + main_words * 8;
+        highs.resize(std::max(highs.size(), exc));
+        get_words(pos + exc * 2, exc_words, words.data());
+        unpack_array(ebits, words.data(), exc, highs.data());
+        for (size_t e = 0; e < exc; ++e) {
+            const size_t i = load_le(pos + e * 2, 2);
+            if (i >= n) return fail(takum_error::Kind::DomainError, "codec: exception position out of range");
+            r[i] |= highs[e] << bits;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) r[i] += base;
+    unpredict<N>(pred, anchor, r.data(), n);
+
+    // xor_prev with a crafted anchor can leave bits above N; from_raw_bits keeps them.
+    using storage_t = typename takum<N>::storage_t;
+    constexpr uint64_t mask = low_mask(N);
+    for (size_t i = 0; i < n; ++i) out[i] = takum<N>::from_raw_bits(static_cast<storage_t>(r[i] & mask));
+    return n;
+}
+
+} // namespace internal
+
+/**
+ * @brief Compress a takum<N> stream into a self-describing frame.
+ *
+ * Blocks are encoded in parallel for large inputs; the output is identical
+ * regardless of thread count.
+ *
+ * @tparam N Takum width (≤ 64)
+ * @return Frame bytes, or DomainError if `opts.block_size` is outside 1..65536
+ */
+template <size_t N>
+inline result<std::vector<uint8_t>> compress(std::span<const takum<N>> in, const options& opts = {}) {
+    static_assert(N <= 64, "codec: only single-word takum widths are supported");
+    using namespace internal;
+    if (opts.block_size == 0 || opts.block_size > max_block_size) {
+        return fail(takum_error::Kind::DomainError, "codec: block_size must be 1..65536");
+    }
+    const size_t bs = opts.block_size;
+    const size_t blocks = (in.size() + bs - 1) / bs;
+    std::vector<std::vector<uint8_t>> encoded(blocks);
+    parallel_for(blocks, [&](size_t bb, size_t be, size_t) {
+        std::vector<uint64_t> raw(bs);
+        for (size_t b = bb; b < be; ++b) {
+            const size_t n = std::min(bs, in.size() - b * bs);
+            for (size_t i = 0; i < n; ++i) raw[i] = static_cast<uint64_t>(in[b * bs + i].storage);
+            encode_block<N>(std::span<const uint64_t>(raw.data(), n), opts.pred, encoded[b]);
+        }
+    }, std::max<size_t>(1, TAKUM_PARALLEL_GRAIN / bs));
+
+    std::vector<uint8_t> out;
+    size_t total = frame_header_bytes + blocks * 8 + 4;
+    for (const auto& e : encoded) total += e.size();
+    out.reserve(total);
+    out.insert(out.end(), frame_magic, frame_magic + 4);
+    append_le(out, frame_version, 1);
+    append_le(out, N, 1);
+    append_le(out, 0, 2);
+    append_le(out, bs, 4);
+    append_le(out, blocks, 4);
+    append_le(out, in.size(), 8);
+    uint64_t offset = frame_header_bytes + blocks * 8 + 4;
+    for (const auto& e : encoded) {
+        append_le(out, offset, 8);
+        offset += e.size();
+    }
+    append_le(out, crc32(0, out), 4);
+    for (const auto& e : encoded) out.insert(out.end(), e.begin(), e.end());
+    return out;
+}
+
+/**
+ * @brief Read and validate a frame header.
+ */
+inline result<frame_info> inspect(std::span<const uint8_t> frame) {
+    auto fv = internal::parse_frame(frame, 0);
+    if (!fv) return internal::error_of(fv);
+    return fv->info;
+}
+
+/**
+ * @brief Decompress a whole frame into @p out (parallel over blocks).
+ *
+ * @return Elements written, or DomainError if the frame is malformed, a
+ *         checksum fails, N differs or @p out is smaller than the frame
+ */
+template <size_t N>
+inline result<size_t> decompress(std::span<const uint8_t> frame, std::span<takum<N>> out) {
+    auto fv = internal::parse_frame(frame, N);
+    if (!fv) return internal::error_of(fv);
+    const frame_info& info = fv->info;
+    if (out.size() < info.count) return internal::fail(takum_error::Kind::DomainError, "codec: output too small");
+
+    std::vector<uint8_t> ok(info.block_count, 0);
+    internal::parallel_for(info.block_count, [&](size_t bb, size_t be, size_t) {
+        internal::block_scratch scratch;
+        for (size_t b = bb; b < be; ++b) {
+            ok[b] = internal::decode_block<N>(frame, *fv, b, out.subspan(b * info.block_size), scratch).has_value();
+        }
+    }, std::max<size_t>(1, TAKUM_PARALLEL_GRAIN / info.block_size));
+    if (!std::ranges::all_of(ok, [](uint8_t v) { return v != 0; })) {
+        return internal::fail(takum_error::Kind::DomainError, "codec: corrupt block");
+    }
+    return info.count;
+}
+
+/// @brief Decompress a whole frame into a new vector.
+template <size_t N>
+inline result<std::vector<takum<N>>> decompress(std::span<const uint8_t> frame) {
+    auto info = inspect(frame);
+    if (!info) return internal::error_of(info);
+    std::vector<takum<N>> out(info->count);
+    auto n = decompress<N>(frame, std::span<takum<N>>(out));
+    if (!n) return internal::error_of(n);
+    return out;
+}
+
+/**
+ * @brief Decompress only block @p block (random access via the block index).
+ *
+ * Elements [block·block_size, block·block_size + count) are written to the
+ * front of @p out.
+ *
+ * @return Elements written, or DomainError for an out-of-range block or corrupt data
+ */
+template <size_t N>
+inline result<size_t> decompress_block(std::span<const uint8_t> frame, size_t block, std::span<takum<N>> out) {
+    auto fv = internal::parse_frame(frame, N);
+    if (!fv) return internal::error_of(fv);
+    if (block >= fv->info.block_count) return internal::fail(takum_error::Kind::DomainError, "codec: block out of range");
+    internal::block_scratch scratch;
+    return internal::decode_block<N>(frame, *fv, block, out, scratch);
+}
+
+} // namespace takum::codec
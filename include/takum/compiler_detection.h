@@ -281,6 +281,23 @@
     #define TAKUM_FORCE_INLINE inline
 #endif
 
+// Never inline (keeps rarely taken paths out of callers; one copy in TakumCppCompiled)
+#if TAKUM_COMPILER_MSVC
+    #define TAKUM_NOINLINE __declspec(noinline)
+#elif TAKUM_COMPILER_GCC || TAKUM_COMPILER_CLANG
+    #define TAKUM_NOINLINE __attribute__((noinline))
+#else
+    #define TAKUM_NOINLINE
+#endif
+
+// Cold-path hint: the function is rarely called, so it is optimized for size and
+// placed away from hot code. Pair with TAKUM_NOINLINE for out-of-line rare paths.
+#if TAKUM_COMPILER_GCC || TAKUM_COMPILER_CLANG
+    #define TAKUM_COLD __attribute__((cold))
+#else
+    #define TAKUM_COLD
+#endif
+
 // Restrict keyword
 #if TAKUM_COMPILER_MSVC
     #define TAKUM_RESTRICT __restrict
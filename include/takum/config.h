@@ -16,6 +16,7 @@
  * - Φ function interpolation methods (linear vs. cubic)
  * - Lookup table sizes for hybrid approximation
  * - Diagnostic and instrumentation features
+ * - Threading of bulk (span/dataset) operations
  *
  * **Usage Example:**
  * ```cpp
@@ -29,6 +30,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "compiler_detection.h"
 
 /**
@@ -95,6 +98,108 @@
 #define TAKUM_ENABLE_PHI_DIAGNOSTICS 1
 #endif
 
+/**
+ * @def TAKUM_ENABLE_STATUS_FLAGS
+ * @brief Maintain the sticky thread-local status flags of status_flags.h.
+ *
+ * When enabled (non-zero), conversions and arithmetic OR flag_nar,
+ * flag_invalid, flag_overflow, flag_underflow and flag_inexact into a
+ * per-thread register read with `takum::test_flags`. Disable to remove the
+ * register update from every encode.
+ *
+ * @note Default: 1 (enabled) - one thread-local OR per operation
+ */
+#ifndef TAKUM_ENABLE_STATUS_FLAGS
+#define TAKUM_ENABLE_STATUS_FLAGS 1
+#endif
+
+/**
+ * @def TAKUM_ENABLE_THREADS
+ * @brief Allow bulk operations to split work across `std::thread` workers.
+ *
+ * When enabled (non-zero), dataset-level helpers such as `advise_width` run
+ * their scans on up to `std::thread::hardware_concurrency()` workers once the
+ * input exceeds TAKUM_PARALLEL_GRAIN elements. Scalar operators are unaffected.
+ *
+ * @note Default: 1 (enabled)
+ * @note Define as 0 for single-threaded targets or when the caller already
+ *       parallelises at a coarser level.
+ */
+#ifndef TAKUM_ENABLE_THREADS
+#define TAKUM_ENABLE_THREADS 1
+#endif
+
+/**
+ * @def TAKUM_PARALLEL_GRAIN
+ * @brief Minimum number of elements handed to a single worker thread.
+ *
+ * Inputs smaller than this run inline on the calling thread; larger inputs
+ * are split into at most `size / TAKUM_PARALLEL_GRAIN` chunks.
+ *
+ * @note Default: 16384 elements
+ */
+#ifndef TAKUM_PARALLEL_GRAIN
+#define TAKUM_PARALLEL_GRAIN 16384
+#endif
+
+/**
+ * @def TAKUM_DECODE_LUT_MAX_BITS
+ * @brief Widest format whose bulk decode uses a full pattern → double table.
+ *
+ * For N ≤ this value, `decode_batch<N>` looks every pattern up in a lazily
+ * built table of 2^N doubles instead of running the scalar decoder. The
+ * default covers takum16 (512 KiB table); set to 0 to disable the tables.
+ *
+ * @note Default: 16
+ */
+#ifndef TAKUM_DECODE_LUT_MAX_BITS
+#define TAKUM_DECODE_LUT_MAX_BITS 16
+#endif
+
+/**
+ * @def TAKUM_NO_LONG_DOUBLE
+ * @brief Keep `long double` out of the scalar hot paths.
+ *
+ * When enabled (non-zero), the double ↔ takum codec for N ≤ 64, `from_ell`,
+ * the addition helpers and the Φ evaluators compute ℓ and Φ in `double`
+ * (via takum::internal::wide_float) instead of x87 `long double`. Results
+ * then no longer depend on the platform's `long double` format and the math
+ * avoids slow x87 library calls. Patterns for N ≤ 32 are unchanged; takum64
+ * may differ in the last bits, within the budgets checked by
+ * test/accuracy_budget.test.cpp in both modes. Text conversion (charconv.h)
+ * and formats wider than 64 bits keep `long double`.
+ *
+ * @note Default: 0 (long double intermediates)
+ * @note Must match across a program, including TakumCppCompiled; use the
+ *       `TAKUM_NO_LONG_DOUBLE` CMake option to propagate it.
+ */
+#ifndef TAKUM_NO_LONG_DOUBLE
+#define TAKUM_NO_LONG_DOUBLE 0
+#endif
+
+/**
+ * @def TAKUM_COMPILED
+ * @brief Reuse the explicit instantiations compiled into TakumCppCompiled.
+ *
+ * When non-zero, the headers declare `extern template` instantiations of
+ * takum<N>, its arithmetic operators and the Φ evaluators and tables for the
+ * widths in TAKUM_COMPILED_WIDTHS, so including translation units stop
+ * instantiating them and link against the library's single copy instead.
+ * Linking the `TakumCppCompiled` CMake target sets it; other widths and the
+ * header-only `TakumCpp` target are unaffected.
+ *
+ * @note Default: 0 (header-only)
+ */
+#ifndef TAKUM_COMPILED
+#define TAKUM_COMPILED 0
+#endif
+
+/**
+ * @def TAKUM_COMPILED_WIDTHS
+ * @brief X-macro over the widths instantiated in TakumCppCompiled.
+ */
+#define TAKUM_COMPILED_WIDTHS(X) X(8) X(16) X(19) X(32) X(64) X(128)
+
 /**
  * @namespace takum::config
  * @brief Runtime configuration query interface for takum library settings.
@@ -129,4 +234,51 @@ constexpr int coarse_hybrid_lut_size() noexcept { return TAKUM_COARSE_LUT_SIZE;
  */
 constexpr bool phi_diagnostics() noexcept { return TAKUM_ENABLE_PHI_DIAGNOSTICS != 0; }
 
+/**
+ * @brief Query whether the sticky status flags are maintained.
+ * @return true if TAKUM_ENABLE_STATUS_FLAGS is non-zero, false otherwise
+ */
+constexpr bool status_flags() noexcept { return TAKUM_ENABLE_STATUS_FLAGS != 0; }
+
+/**
+ * @brief Query whether bulk operations may use worker threads.
+ * @return true if TAKUM_ENABLE_THREADS is non-zero, false otherwise
+ */
+constexpr bool threads() noexcept { return TAKUM_ENABLE_THREADS != 0; }
+
+/**
+ * @brief Get the minimum number of elements processed per worker thread.
+ * @return Value of TAKUM_PARALLEL_GRAIN
+ */
+constexpr size_t parallel_grain() noexcept { return TAKUM_PARALLEL_GRAIN; }
+
+/**
+ * @brief Get the widest format decoded in bulk through a full lookup table.
+ * @return Value of TAKUM_DECODE_LUT_MAX_BITS
+ */
+constexpr size_t decode_lut_max_bits() noexcept { return TAKUM_DECODE_LUT_MAX_BITS; }
+
+/**
+ * @brief Query whether the hot paths avoid `long double`.
+ * @return true if TAKUM_NO_LONG_DOUBLE is non-zero, false otherwise
+ */
+constexpr bool no_long_double() noexcept { return TAKUM_NO_LONG_DOUBLE != 0; }
+
+/**
+ * @brief Query whether the common widths come from TakumCppCompiled.
+ * @return true if TAKUM_COMPILED is non-zero, false otherwise
+ */
+constexpr bool compiled() noexcept { return TAKUM_COMPILED != 0; }
+
 } } // namespace takum::config
+
+namespace takum { namespace internal {
+
+/// Intermediate type for ℓ and Φ: `long double`, or `double` under TAKUM_NO_LONG_DOUBLE.
+#if TAKUM_NO_LONG_DOUBLE
+using wide_float = double;
+#else
+using wide_float = long double;
+#endif
+
+} } // namespace takum::internal
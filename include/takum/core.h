@@ -13,6 +13,8 @@
 #include <bit>
 #include <optional>
 #include "takum/compiler_detection.h"
+#include "takum/config.h"
+#include "takum/status_flags.h"
 #if TAKUM_HAS_STD_EXPECTED
 #include <expected>
 #else
@@ -110,6 +112,9 @@ struct takum {
     using storage_t = std::conditional_t<(N <= 32), uint32_t,
                       std::conditional_t<(N <= 64), uint64_t, std::array<uint64_t, (N+63)/64>>>;
 
+    /// Intermediate type for ℓ: `long double`, or `double` under TAKUM_NO_LONG_DOUBLE.
+    using wide_float = ::takum::internal::wide_float;
+
     /// Raw storage containing the N-bit pattern (valid bits are in the low N bits).
     storage_t storage{};
 
@@ -153,15 +158,15 @@ struct takum {
             uint64_t pat = 1ULL << (N - 1);  // Only sign bit set for NaR
             return w == pat;
         } else {
-            // Check only sign bit (MSB) set, all else zero
-            size_t msb_word = (N - 1) / 64;
-            size_t msb_bit = (N - 1) % 64;
-            uint64_t expected = 1ULL << msb_bit;
-            if (storage[msb_word] != expected) return false;
+            // Check only sign bit (MSB) set, all else zero; branch-free OR
+            // reduction over the words so bulk scans stay vectorisable.
+            constexpr size_t msb_word = (N - 1) / 64;
+            constexpr uint64_t expected = 1ULL << ((N - 1) % 64);
+            uint64_t diff = storage[msb_word] ^ expected;
             for (size_t i = 0; i < storage.size(); ++i) {
-                if (i != msb_word && storage[i] != 0) return false;
+                if (i != msb_word) diff |= storage[i];
             }
-            return true;
+            return diff == 0;
         }
     }
 
@@ -285,10 +290,10 @@ struct takum {
     }
 
     /**
-     * @brief Unary negation: flips the sign bit. NaR is its own negation.
+     * @brief Unary negation: flips the sign bit. NaR and zero are their own negation.
      */
     takum operator-() const noexcept {
-        if (is_nar()) return *this; // NaR is its own negation.
+        if (is_nar() || is_zero()) return *this; // Flipping the sign of zero would yield NaR.
         
         takum res = *this;
         if constexpr (N <= 64) {
@@ -310,15 +315,15 @@ struct takum {
      * inverse-plus-one rule used by the current takum specification.
      */
     takum reciprocal() const noexcept {
-        if (is_nar()) return nar();
+        if (is_nar()) {
+            internal::raise_status(flag_nar);
+            return nar();
+        }
 
         // Zero → NaR
-        if constexpr (std::is_integral_v<storage_t>) {
-            if (storage == 0) return nar();
-        } else {
-            bool all_zero = true;
-            for (auto w : storage) if (w != 0) { all_zero = false; break; }
-            if (all_zero) return nar();
+        if (is_zero()) {
+            internal::raise_status(flag_nar | flag_invalid);
+            return nar();
         }
 
         takum res;
@@ -467,8 +472,8 @@ struct takum {
         // Fallback: decode to double and then extract ell via log
         double v = to_double();
         if (!std::isfinite(v)) return std::numeric_limits<double>::quiet_NaN();
-        long double abs_v = fabsl(v);
-        long double ell = 2.0L * logl(abs_v);
+        wide_float abs_v = std::fabs(static_cast<wide_float>(v));
+        wide_float ell = 2 * std::log(abs_v);
         return static_cast<double>((v < 0) ? -ell : ell);
     }
 
@@ -491,20 +496,21 @@ struct takum {
             // Full multi-word packing will be implemented in a future version.
             // Placeholder for large N; full multi-word packing later
             return 0ULL;
+        } else {
+            size_t max_r = std::min<size_t>(7, N - 5);
+            bool S = false;  // positive
+            bool D = true;
+            uint32_t R = static_cast<uint32_t>(max_r);  // r = R since D=1
+            size_t p = N - 5 - max_r;
+            uint64_t c_bits = (max_r == 0) ? 0ULL : ((1ULL << max_r) - 1ULL);
+            uint64_t packed = (static_cast<uint64_t>(S) << (N - 1)) |
+                              (static_cast<uint64_t>(D) << (N - 2)) |
+                              (static_cast<uint64_t>(R) << (N - 5)) |
+                              (c_bits << p);
+            uint64_t m_max = (p > 0) ? ((1ULL << p) - 1ULL) : 0ULL;
+            packed |= m_max;
+            return packed;
         }
-        size_t max_r = std::min<size_t>(7, N - 5);
-        bool S = false;  // positive
-        bool D = true;
-        uint32_t R = static_cast<uint32_t>(max_r);  // r = R since D=1
-        size_t p = N - 5 - max_r;
-        uint64_t c_bits = (max_r == 0) ? 0ULL : ((1ULL << max_r) - 1ULL);
-        uint64_t packed = (static_cast<uint64_t>(S) << (N - 1)) |
-                          (static_cast<uint64_t>(D) << (N - 2)) |
-                          (static_cast<uint64_t>(R) << (N - 5)) |
-                          (c_bits << p);
-        uint64_t m_max = (p > 0) ? ((1ULL << p) - 1ULL) : 0ULL;
-        packed |= m_max;
-        return packed;
     }
     
     /**
@@ -513,20 +519,29 @@ struct takum {
      * Returns the logarithmic value ℓ corresponding to the maximum finite
      * representable number in this format. Used for determining dynamic range.
      *
-     * @return long double The maximum ℓ value (approximately ±255 for large N)
+     * @return The maximum ℓ value (approximately ±255 for large N), as wide_float
      * @note For N>64, uses specification bound of ±255
      * @note For smaller N, computed from the actual maximum finite pattern
+     * @note Computed once per N and cached; the encoders consult it on every call.
      */
-    static long double max_ell() noexcept {
+    static wide_float max_ell() noexcept {
+        static const wide_float cached = compute_max_ell();
+        return cached;
+    }
+
+    /**
+     * @brief Uncached max_ell(): decodes the maximum finite pattern.
+     */
+    TAKUM_COLD TAKUM_NOINLINE static wide_float compute_max_ell() noexcept {
         if constexpr (N > 64) {
             // For large N use the spec dynamic range bound: |ell| <= 255
             // (the tapered format limits ℓ to roughly ±255 in the reference spec).
-            return 255.0L;
+            return 255;
         } else {
             uint64_t bits = max_finite_storage();
             takum temp{};
             temp.storage = static_cast<storage_t>(bits);
-            return static_cast<long double>(temp.get_exact_ell());
+            return static_cast<wide_float>(temp.get_exact_ell());
         }
     }
 
@@ -554,7 +569,11 @@ struct takum {
             // If x is zero or non-finite the small path already encodes it in low bits
             // but we must still place fields at correct offsets across words.
             if (x == 0.0) return out;
-            if (!std::isfinite(x)) { out = takum::nar().storage; return out; }
+            if (!std::isfinite(x)) {
+                internal::raise_status(flag_nar | flag_invalid);
+                out = takum::nar().storage;
+                return out;
+            }
 
             bool S = std::signbit(x);
             long double abs_x = fabsl(x);
@@ -563,6 +582,7 @@ struct takum {
             long double clamp_pos = max_ell();
             // Per spec: values outside representable dynamic range map to NaR
             if (ell > clamp_pos || ell < -clamp_pos) {
+                internal::raise_status(flag_nar | (ell > 0 ? flag_overflow : flag_underflow));
                 out = takum::nar().storage;
                 return out;
             }
@@ -637,6 +657,7 @@ struct takum {
                 if (bit) frac -= 1.0L;
                 write_bit(out, i, bit);
             }
+            if (frac != 0.0L) internal::raise_status(flag_inexact);
 
             // Mask top bits just in case
             mask_to_N(out);
@@ -654,56 +675,29 @@ struct takum {
      * already known (direct ℓ-space encoder). Returns NaR for out-of-range ℓ
      * (|ℓ| > max_ell()) or when ℓ is NaN.
      */
-    static takum from_ell(bool S, long double ell_ld) noexcept {
+    TAKUM_NOINLINE static takum from_ell(bool S, wide_float ell_ld) noexcept {
         // Handle NaR/NaN
-        if (!std::isfinite((double)ell_ld)) return takum::nar();
+        if (!std::isfinite((double)ell_ld)) {
+            internal::raise_status(flag_nar | flag_invalid);
+            return takum::nar();
+        }
 
-        long double clamp_pos = max_ell();
-        if (ell_ld > clamp_pos || ell_ld < -clamp_pos) return takum::nar();
+        const wide_float clamp_pos = max_ell();
+        if (ell_ld > clamp_pos || ell_ld < -clamp_pos) {
+            internal::raise_status(flag_nar | (ell_ld > 0 ? flag_overflow : flag_underflow));
+            return takum::nar();
+        }
 
         // Zero is represented by an all-zero pattern; interpret very small
         // negative ell as zero (user-level code should handle exact zeros).
         // Here, if ell is extremely negative, produce zero.
-        if (ell_ld <= -1e300L) {
+        if (ell_ld <= -1e300) {
             return takum{}; // zero
         }
 
         if constexpr (N <= 64) {
-            // Follow encode_from_double_u64 packing but use provided ell
-            int64_t c = static_cast<int64_t>(floorl(ell_ld));
-            bool D = (c >= 0);
-            int64_t abs_c = D ? c : -c;
-            uint32_t r = (abs_c != 0)
-                ? static_cast<uint32_t>(floorl(log2l(D ? abs_c + 1 : abs_c)))
-                : 0;
-            r = std::min<uint32_t>(7, r);
-            uint32_t R = D ? r : (7U - r);
-
-            uint64_t c_bits = 0ULL;
-            if (r != 0) {
-                if (D) c_bits = static_cast<uint64_t>(c - ((1ULL << r) - 1ULL));
-                else c_bits = static_cast<uint64_t>(c + ((1ULL << (r+1)) - 1ULL));
-            }
-
-            long double m = ell_ld - static_cast<long double>(c);
-            if (m < 0.0L) m = 0.0L;
-            if (m >= 1.0L) m = 0.999999L;
-
-            size_t p = N - 5 - static_cast<size_t>(r);
-            uint64_t m_bits = 0ULL;
-            if (p > 0 && m > 0.0L) {
-                long double m_power = ldexpl(1.0L, static_cast<int>(p));
-                long double m_scaled_ld = m * m_power;
-                m_bits = static_cast<uint64_t>(floorl(m_scaled_ld + 0.5L));
-                uint64_t max_m = (p >= 64) ? ~0ULL : ((1ULL << p) - 1ULL);
-                if (m_bits > max_m) m_bits = max_m;
-            }
-
-            uint64_t packed = (static_cast<uint64_t>(S) << (N - 1)) |
-                              (static_cast<uint64_t>(D) << (N - 2)) |
-                              (static_cast<uint64_t>(R) << (N - 5));
-            packed |= (c_bits << p);
-            packed |= m_bits;
+            // Same packing as encode_from_double_u64, from the provided ell
+            const uint64_t packed = pack_ell_u64(S, ell_ld);
             takum t{};
             t.storage = static_cast<storage_t>(packed);
             return t;
@@ -779,6 +773,7 @@ struct takum {
                 if (bit) frac -= 1.0L;
                 write_bit(out, i, bit);
             }
+            if (frac != 0.0L) internal::raise_status(flag_inexact);
 
             mask_to_N(out);
             takum t{};
@@ -800,63 +795,18 @@ struct takum {
      */
     static uint64_t encode_from_double_u64(double x) noexcept {
         if constexpr (N <= 64) {
-            if (x == 0.0) return 0ULL; // Zero representation per eq. (24)
-            if (!std::isfinite(x)) return static_cast<uint64_t>(takum::nar().storage);  // NaN/Inf → NaR per NaR convention in Def. 2
+            if (x == 0.0 || !std::isfinite(x)) TAKUM_UNLIKELY return encode_special_u64(x);
 
             bool S = std::signbit(x); // Sign bit per eq. (14)
-            long double abs_x = fabsl(x);
+            wide_float abs_x = std::fabs(static_cast<wide_float>(x));
 
-            long double ell = 2.0L * logl(abs_x); // Logarithmic value ℓ = 2 * ln(|x|) for base √e, per eq. (23)
+            wide_float ell = 2 * std::log(abs_x); // Logarithmic value ℓ = 2 * ln(|x|) for base √e, per eq. (23)
 
             // Clamp |ℓ| to representable range |ℓ| < 255 per eq. (23)
-            long double clamp_pos = max_ell();
-            if (ell > clamp_pos) ell = clamp_pos;
-            if (ell < -clamp_pos) ell = -clamp_pos;
+            const wide_float clamp_pos = max_ell();
+            if (ell > clamp_pos || ell < -clamp_pos) TAKUM_UNLIKELY ell = saturate_ell(ell);
 
-            // Decompose ℓ into characteristic c = floor(ℓ) and mantissa m = ℓ - c per eq. (19) and (22)
-            int64_t c = static_cast<int64_t>(floorl(ell));
-            bool D = (c >= 0); // Direction bit: positive if c >= 0 per eq. (15)
-            int64_t abs_c = D ? c : -c;
-
-            // Regime r per eq. (17): floor(log2(|c| + D))
-            uint32_t r = (abs_c != 0)
-                ? static_cast<uint32_t>(floorl(log2l(D ? abs_c + 1 : abs_c)))
-                : 0;
-            r = std::min<uint32_t>(7, r); // Clamp to max regime 7
-            uint32_t R = D ? r : (7U - r); // Regime bits per eq. (16)
-
-            // Characteristic bits C per eq. (18), c per eq. (19)
-            uint64_t c_bits = 0ULL;
-            if (r != 0) {
-                if (D) {
-                    c_bits = static_cast<uint64_t>(c - ((1ULL << r) - 1ULL)); // D=1 case
-                } else {
-                    c_bits = static_cast<uint64_t>(c + ((1ULL << (r+1)) - 1ULL)); // D=0 case
-                }
-            }
-
-            // Mantissa m = fractional part of ℓ per eq. (22), p = N - 5 - r per eq. (20)
-            long double m = ell - static_cast<long double>(c);
-            if (m < 0.0L) m = 0.0L;
-            if (m >= 1.0L) m = 0.999999L;  // avoid overflow in scaling
-
-            size_t p = N - 5 - static_cast<size_t>(r);
-            uint64_t m_bits = 0ULL;
-            if (p > 0 && m > 0.0L) {
-                long double m_power = ldexpl(1.0L, static_cast<int>(p));
-                long double m_scaled_ld = m * m_power;
-                m_bits = static_cast<uint64_t>(floorl(m_scaled_ld + 0.5L)); // Quantize m to p bits
-                uint64_t max_m = (p >= 64) ? ~0ULL : ((1ULL << p) - 1ULL);
-                if (m_bits > max_m) m_bits = max_m; // Clamp
-            }
-
-            // Pack bit fields into storage per Def. 2 bit layout: S D R C M
-            uint64_t packed = (static_cast<uint64_t>(S) << (N - 1)) | // Sign
-                              (static_cast<uint64_t>(D) << (N - 2)) | // Direction
-                              (static_cast<uint64_t>(R) << (N - 5)); // Regime
-            packed |= (c_bits << p); // Characteristic
-            packed |= m_bits; // Mantissa
-            return packed;
+            return pack_ell_u64(S, ell);
         } else {
             // For N>64 this helper is not used; provide a safe fallback
             return 0ULL;
@@ -864,6 +814,83 @@ struct takum {
     }
 
 private:
+    /**
+     * @brief Pack sign and an in-range ℓ into the S,D,R,C,M fields (N ≤ 64),
+     * shared by encode_from_double_u64() and from_ell().
+     */
+    static uint64_t pack_ell_u64(bool S, wide_float ell) noexcept requires (N <= 64) {
+        // Decompose ℓ into characteristic c = floor(ℓ) and mantissa m = ℓ - c per eq. (19) and (22)
+        int64_t c = static_cast<int64_t>(ell); // truncation, then step down for negative fractions
+        if (static_cast<wide_float>(c) > ell) --c;
+        bool D = (c >= 0); // Direction bit: positive if c >= 0 per eq. (15)
+        int64_t abs_c = D ? c : -c;
+
+        // Regime r per eq. (17): floor(log2(|c| + D)), exact on the integer
+        uint32_t r = static_cast<uint32_t>(std::bit_width(static_cast<uint64_t>(abs_c + D))) - 1U;
+        r = std::min<uint32_t>(7, r); // Clamp to max regime 7
+        uint32_t R = D ? r : (7U - r); // Regime bits per eq. (16)
+
+        // Characteristic bits C per eq. (18), c per eq. (19)
+        uint64_t c_bits = 0ULL;
+        if (r != 0) {
+            if (D) {
+                c_bits = static_cast<uint64_t>(c - ((1ULL << r) - 1ULL)); // D=1 case
+            } else {
+                c_bits = static_cast<uint64_t>(c + ((1ULL << (r+1)) - 1ULL)); // D=0 case
+            }
+        }
+
+        // Mantissa m = fractional part of ℓ per eq. (22), p = N - 5 - r per eq. (20)
+        wide_float m = ell - static_cast<wide_float>(c);
+        if (m < 0) m = 0;
+        if (m >= 1) m = static_cast<wide_float>(0.999999L);  // avoid overflow in scaling
+
+        size_t p = N - 5 - static_cast<size_t>(r);
+        uint64_t m_bits = 0ULL;
+        if (m > 0) {
+            // p <= 59 here, so 2^p is an exact integer power and m * 2^p + 0.5 > 0
+            wide_float m_power = static_cast<wide_float>(1ULL << p);
+            wide_float m_scaled = m * m_power;
+            m_bits = static_cast<uint64_t>(m_scaled + wide_float(0.5)); // Quantize m to p bits, may reach 2^p
+            if (static_cast<wide_float>(m_bits) != m_scaled) internal::raise_status(flag_inexact);
+        }
+
+        // Pack bit fields into storage per Def. 2 bit layout: S D R C M
+        uint64_t packed = (static_cast<uint64_t>(S) << (N - 1)) | // Sign
+                          (static_cast<uint64_t>(D) << (N - 2)) | // Direction
+                          (static_cast<uint64_t>(R) << (N - 5)); // Regime
+        packed |= (c_bits << p); // Characteristic
+        // Mantissa. Patterns are monotone in ℓ, so rounding m up to 2^p carries
+        // into C/R/D and yields the next pattern (ℓ ≤ max_ell() keeps it finite).
+        packed += m_bits;
+        return packed;
+    }
+
+    /**
+     * @brief Rare inputs of encode_from_double_u64(): zero per eq. (24), and
+     * NaN/Inf → NaR per the NaR convention in Def. 2.
+     */
+    TAKUM_COLD TAKUM_NOINLINE static uint64_t encode_special_u64(double x) noexcept requires (N <= 64) {
+        if (x == 0.0) return 0ULL;
+        internal::raise_status(flag_nar | flag_invalid);
+        return static_cast<uint64_t>(takum::nar().storage);
+    }
+
+    /**
+     * @brief Clamp an out-of-range ℓ to ±max_ell() (saturating encode).
+     */
+    TAKUM_COLD TAKUM_NOINLINE static wide_float saturate_ell(wide_float ell) noexcept {
+        internal::raise_status((ell > 0 ? flag_overflow : flag_underflow) | flag_inexact);
+        return ell > 0 ? max_ell() : -max_ell();
+    }
+
+    /**
+     * @brief Rare patterns of decode_u64_to_double(): zero, or NaR → quiet NaN per eq. (24).
+     */
+    TAKUM_COLD TAKUM_NOINLINE static double decode_special(bool S) noexcept {
+        return S ? std::numeric_limits<double>::quiet_NaN() : 0.0;
+    }
+
     /**
      * @brief Generate bit mask for N-bit values.
      * @return Mask with low N bits set to 1
@@ -980,14 +1007,11 @@ private:
      * @return double The decoded value following the reference specification
      * @note Zero patterns return exactly 0.0, NaR patterns return quiet NaN
      */
-    static double decode_u64_to_double(uint64_t bits) noexcept {
-        if (bits == 0) return 0.0; // Zero per eq. (24)
-        // NaR check: S=1 and D=R=C=M=0 per Def. 2
+    static double decode_u64_to_double(uint64_t bits) noexcept requires (N <= 64) {
+        // Zero and NaR (S=1, D=R=C=M=0 per Def. 2) are the only patterns with no low bits set
         bool S = (bits >> (N - 1)) & 1ULL; // Sign per eq. (14)
-        uint64_t lower = bits & ((N >= 64) ? ~0ULL : ((1ULL << (N - 1)) - 1ULL));
-        if (S && lower == 0) {
-            return std::numeric_limits<double>::quiet_NaN(); // NaR per eq. (24)
-        }
+        uint64_t lower = bits & ((1ULL << (N - 1)) - 1ULL);
+        if (lower == 0) TAKUM_UNLIKELY return decode_special(S);
         // Extract D per eq. (15)
         bool D = (bits >> (N - 2)) & 1ULL;
         // Extract R per eq. (16), compute r per eq. (17)
@@ -1003,7 +1027,7 @@ private:
         size_t p = N - 5 - r;
         // Extract M per eq. (21), compute m per eq. (22)
         uint64_t m_bits = (p == 0) ? 0ULL : (bits & ((1ULL << p) - 1ULL));
-        double m = (p > 0) ? (static_cast<double>(m_bits) * std::pow(2.0, -static_cast<int>(p))) : 0.0;
+        double m = (p > 0) ? (static_cast<double>(m_bits) / static_cast<double>(1ULL << p)) : 0.0; // exact scale
 
         // ℓ = c + m per eq. (23)
         double ell = static_cast<double>(c) + m;
@@ -1013,6 +1037,13 @@ private:
     }
 };
 
+#if TAKUM_COMPILED
+// Instantiated once in TakumCppCompiled (src/takum_compiled.cpp).
+#define TAKUM_EXTERN_TAKUM(N) extern template struct takum<N>;
+TAKUM_COMPILED_WIDTHS(TAKUM_EXTERN_TAKUM)
+#undef TAKUM_EXTERN_TAKUM
+#endif
+
 } // namespace takum
 
 /**
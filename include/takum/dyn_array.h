@@ -0,0 +1,271 @@
+/**
+ * @file dyn_array.h
+ * @brief Runtime-width takum scalar (`takum_dyn`) and bit-packed container (`dyn_array`).
+ *
+ * `takum<N>` fixes its width at compile time. When the width is chosen per
+ * tensor or per column at runtime (for example from `advise_width()`), these
+ * types carry N as metadata instead and dispatch once per bulk operation to
+ * the precompiled static-width kernels for N ∈ {12, 16, 19, 20, 24, 28, 32,
+ * 40, 48, 56, 64}. Per-element work therefore runs in the same loops as the
+ * `takum<N>` code; only the dispatch switch is paid per call.
+ *
+ * Elements are stored bit-packed: a `dyn_array` of width N uses
+ * ⌈count·N/64⌉ words, e.g. 19 bits per element for takum19.
+ *
+ * **Usage Example:**
+ * ```cpp
+ * auto arr = takum::dyn_array::encode(advice.recommended_width, column);
+ * std::vector<double> back(arr->size());
+ * arr->decode(back);
+ * ```
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/batch.h"
+#include "takum/result.h"
+#include "takum/internal/bitpack.h"
+#include "takum/internal/parallel.h"
+#include "takum/internal/width_dispatch.h"
+
+namespace takum {
+
+/**
+ * @brief Test whether @p width is supported by the runtime-width types.
+ */
+constexpr bool is_supported_width(size_t width) noexcept {
+    return internal::is_dispatch_width(width);
+}
+
+/**
+ * @brief A single takum value whose width is runtime metadata.
+ *
+ * Holds the raw N-bit pattern in the low bits of a 64-bit word. A
+ * default-constructed value has width 0 and is not a valid takum.
+ */
+struct takum_dyn {
+    /// Raw pattern (low `width` bits).
+    uint64_t bits = 0;
+    /// Bit width N (0 for an empty value).
+    uint8_t width = 0;
+
+    constexpr takum_dyn() noexcept = default;
+    constexpr takum_dyn(size_t w, uint64_t raw) noexcept
+        : bits(raw & internal::low_mask(w ? w : 1)), width(static_cast<uint8_t>(w)) {}
+
+    /// @brief Wrap a static-width value.
+    template <size_t N>
+    static takum_dyn from(const takum<N>& v) noexcept {
+        static_assert(N <= 64, "takum_dyn: only single-word widths are supported");
+        return takum_dyn(N, static_cast<uint64_t>(v.raw_bits()));
+    }
+
+    /// @brief Encode @p x at runtime width @p w (unsupported widths are an error).
+    static result<takum_dyn> from_double(size_t w, double x) {
+        takum_dyn out;
+        bool ok = internal::dispatch_width(w, [&](auto width) {
+            out = from(takum<decltype(width)::value>(x));
+        });
+        if (!ok) return internal::fail(takum_error::Kind::DomainError, "unsupported takum width");
+        return out;
+    }
+
+    /**
+     * @brief Reinterpret as takum<N>.
+     * @note Precondition: `width == N`.
+     */
+    template <size_t N>
+    takum<N> as() const noexcept {
+        return takum<N>::from_raw_bits(static_cast<typename takum<N>::storage_t>(bits));
+    }
+
+    /// @brief Decode to host double (quiet NaN for NaR or an unsupported width).
+    double to_double() const noexcept {
+        double v = std::numeric_limits<double>::quiet_NaN();
+        internal::dispatch_width(width, [&](auto w) { v = as<decltype(w)::value>().to_double(); });
+        return v;
+    }
+
+    /// @brief True for the NaR pattern (sign bit only).
+    bool is_nar() const noexcept { return width != 0 && bits == (1ULL << (width - 1)); }
+
+    /// @brief True for the zero pattern.
+    bool is_zero() const noexcept { return width != 0 && bits == 0; }
+
+    /// @brief Same width and same pattern.
+    bool operator==(const takum_dyn& other) const noexcept = default;
+};
+
+/**
+ * @brief Bit-packed array of takum values with a runtime width.
+ *
+ * Bulk members (`encode`, `decode`, `unpack`, `convert`) dispatch once on the
+ * width and then run the static-width kernels; large inputs are split across
+ * worker threads in groups of 64 elements so no two workers share a word.
+ */
+class dyn_array {
+public:
+    /// @brief Empty array with width 0.
+    dyn_array() = default;
+
+    /// @brief All-zero array of @p count elements at @p width.
+    static result<dyn_array> zeros(size_t width, size_t count) {
+        if (!is_supported_width(width)) return internal::fail(takum_error::Kind::DomainError, "unsupported takum width");
+        return dyn_array(width, count);
+    }
+
+    /// @brief Encode @p values at runtime width @p width.
+    static result<dyn_array> encode(size_t width, std::span<const double> values) {
+        if (!is_supported_width(width)) return internal::fail(takum_error::Kind::DomainError, "unsupported takum width");
+        dyn_array out(width, values.size());
+        internal::dispatch_width(width, [&](auto w) { out.encode_impl<decltype(w)::value>(values); });
+        return out;
+    }
+
+    /// @brief Pack an existing static-width span (N must be a supported width).
+    template <size_t N>
+    static dyn_array from_takums(std::span<const takum<N>> values) {
+        static_assert(internal::is_dispatch_width(N), "dyn_array: unsupported takum width");
+        dyn_array out(N, values.size());
+        out.pack_groups<N>(values.size(), [&](size_t i) { return static_cast<uint64_t>(values[i].storage); });
+        return out;
+    }
+
+    /// @brief Bit width N of every element (0 for an empty default-constructed array).
+    size_t width() const noexcept { return width_; }
+    /// @brief Number of elements.
+    size_t size() const noexcept { return size_; }
+    /// @brief True when the array holds no elements.
+    bool empty() const noexcept { return size_ == 0; }
+    /// @brief Packed storage words (element i at bits [i·N, (i+1)·N)).
+    std::span<const uint64_t> words() const noexcept { return words_; }
+    /// @brief Bytes of packed storage.
+    size_t storage_bytes() const noexcept { return words_.size() * sizeof(uint64_t); }
+
+    /// @brief Element @p i as a runtime-width scalar.
+    takum_dyn operator[](size_t i) const noexcept {
+        return takum_dyn(width_, internal::read_packed(words_.data(), i, width_));
+    }
+
+    /**
+     * @brief Overwrite element @p i.
+     * @return false (array unchanged) if `v.width` differs from width()
+     */
+    [[nodiscard]] bool set(size_t i, takum_dyn v) noexcept {
+        if (v.width != width_ || i >= size_) return false;
+        internal::write_packed(words_.data(), i, width_, v.bits);
+        return true;
+    }
+
+    /**
+     * @brief Decode elements [first, first + out.size()) into @p out.
+     * @return Number of elements written (clipped to the array end)
+     */
+    size_t decode(std::span<double> out, size_t first = 0) const {
+        const size_t n = first < size_ ? std::min(out.size(), size_ - first) : 0;
+        internal::dispatch_width(width_, [&](auto w) { decode_impl<decltype(w)::value>(out.first(n), first); });
+        return n;
+    }
+
+    /**
+     * @brief Unpack elements [first, first + out.size()) into static-width values.
+     * @return Number of elements written; 0 if N differs from width()
+     */
+    template <size_t N>
+    size_t unpack(std::span<takum<N>> out, size_t first = 0) const noexcept {
+        if (N != width_ || first >= size_) return 0;
+        const size_t n = std::min(out.size(), size_ - first);
+        internal::unpack_bits<N>(words_.data(), first, n, [&](size_t i, uint64_t v) {
+            out[i] = takum<N>::from_raw_bits(static_cast<typename takum<N>::storage_t>(v));
+        });
+        return n;
+    }
+
+    /**
+     * @brief Re-encode every element at @p new_width.
+     *
+     * Values are converted through host double, so widening is exact up to
+     * the precision of double and narrowing rounds as `takum<M>(double)` does.
+     */
+    result<dyn_array> convert(size_t new_width) const {
+        if (!is_supported_width(new_width)) return internal::fail(takum_error::Kind::DomainError, "unsupported takum width");
+        if (new_width == width_) return *this;
+        dyn_array out(new_width, size_);
+        internal::dispatch_width(width_, [&](auto from) {
+            internal::dispatch_width(new_width, [&](auto to) {
+                out.convert_from<decltype(from)::value, decltype(to)::value>(*this);
+            });
+        });
+        return out;
+    }
+
+    /**
+     * @brief Call `f(std::integral_constant<size_t, N>{})` with N = width().
+     *
+     * Lets callers write their own static-width kernels over unpack<N>().
+     * @return false if the array is empty-width
+     */
+    template <typename F>
+    bool visit_width(F&& f) const {
+        return internal::dispatch_width(width_, std::forward<F>(f));
+    }
+
+private:
+    /// Elements per independently packable group (fills exactly N words).
+    static constexpr size_t group = 64;
+
+    dyn_array(size_t width, size_t count)
+        : width_(width), size_(count), words_(internal::packed_words(count, width), 0ULL) {}
+
+    /// Pack `get(i)` for i in [0, count) group by group, in parallel for large inputs.
+    template <size_t N, typename Get>
+    void pack_groups(size_t count, Get&& get) {
+        const size_t groups = (count + group - 1) / group;
+        internal::parallel_for(groups, [&](size_t gb, size_t ge, size_t) {
+            for (size_t g = gb; g < ge; ++g) {
+                const size_t first = g * group;
+                const size_t n = std::min(group, count - first);
+                internal::pack_bits<N>(n, [&](size_t i) { return get(first + i); }, words_.data() + g * N);
+            }
+        }, TAKUM_PARALLEL_GRAIN / group);
+    }
+
+    template <size_t N>
+    void encode_impl(std::span<const double> values) {
+        pack_groups<N>(values.size(), [&](size_t i) {
+            return static_cast<uint64_t>(takum<N>(values[i]).storage);
+        });
+    }
+
+    template <size_t N>
+    void decode_impl(std::span<double> out, size_t first) const {
+        internal::parallel_for(out.size(), [&](size_t begin, size_t end, size_t) {
+            internal::decode_packed<N>(words_.data(), first + begin, end - begin, out.data() + begin);
+        });
+    }
+
+    template <size_t From, size_t To>
+    void convert_from(const dyn_array& src) {
+        pack_groups<To>(src.size_, [&](size_t i) {
+            auto v = takum<From>::from_raw_bits(static_cast<typename takum<From>::storage_t>(
+                internal::read_packed(src.words_.data(), i, From)));
+            if (v.is_nar()) return static_cast<uint64_t>(takum<To>::nar().storage);
+            return static_cast<uint64_t>(takum<To>(v.to_double()).storage);
+        });
+    }
+
+    size_t width_ = 0;
+    size_t size_ = 0;
+    std::vector<uint64_t> words_;
+};
+
+} // namespace takum
@@ -0,0 +1,327 @@
+/**
+ * @file format.h
+ * @brief `std::formatter<takum<N>>` and iostream operators on the charconv core.
+ *
+ * Both front ends parse their options into an @ref takum::internal::format_spec
+ * and render through @ref takum::internal::format_to, which writes into a stack
+ * buffer with `to_chars` and pads into the output — no `to_double()`, no
+ * iostream number formatting, no allocation.
+ *
+ * Format spec: `[[fill]align][sign][#][0][width][.precision][type]` with a
+ * single-character fill. Types:
+ * - none: shortest round-trip (`.P` gives `%g`-style P digits);
+ * - `e` `E` `f` `F` `g` `G`: as for floating point (precision defaults to 6);
+ * - `x` `X`: the raw bit pattern in hex (`#` adds `0x`);
+ * - `l`: the logarithmic value ℓ, signed like get_exact_ell();
+ * - `v`: a field breakdown `S=… D=… R=… C=… M=0x… (c=…, p=…)`.
+ * The width and precision must be literal (no nested `{}`); precision is
+ * capped at 400.
+ *
+ * The `std::formatter` specialisation is only declared when the standard
+ * library provides `<format>`. `operator<<` honours `fixed` / `scientific` with
+ * the stream precision, `hexfloat` as the raw pattern, `showpos`, `uppercase`
+ * and width/fill/adjustment; with no floatfield it writes the shortest
+ * round-trip form rather than `%g` with 6 digits. `operator>>` reads one token
+ * with `from_chars` and sets failbit if it does not parse completely.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <version>
+
+#include "takum/core.h"
+#include "takum/charconv.h"
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+#include <format>
+#endif
+
+namespace takum {
+
+namespace internal {
+
+/// Parsed format options shared by std::formatter and the stream operators.
+struct format_spec {
+    char fill = ' ';
+    char align = 0; ///< '<', '>', '^' or 0 (numbers right-align)
+    char sign = '-';
+    bool alternate = false;
+    bool zero_pad = false;
+    int width = 0;
+    int precision = -1;
+    char type = 0;
+};
+
+inline constexpr int max_format_precision = 400;
+
+/**
+ * @brief Parse a format spec in [first, last).
+ * @return Pointer to the terminating '}' (or @p last), or nullptr if malformed
+ */
+constexpr const char* parse_format_spec(const char* first, const char* last, format_spec& spec) {
+    const char* p = first;
+    auto is_align = [](char c) { return c == '<' || c == '>' || c == '^'; };
+    if (last - p >= 2 && is_align(p[1]) && p[0] != '{' && p[0] != '}') {
+        spec.fill = p[0];
+        spec.align = p[1];
+        p += 2;
+    } else if (p != last && is_align(*p)) {
+        spec.align = *p++;
+    }
+    if (p != last && (*p == '+' || *p == '-' || *p == ' ')) spec.sign = *p++;
+    if (p != last && *p == '#') {
+        spec.alternate = true;
+        ++p;
+    }
+    if (p != last && *p == '0') {
+        spec.zero_pad = true;
+        ++p;
+    }
+    auto number = [&](int& out) {
+        int v = 0;
+        bool any = false;
+        for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+            v = std::min(v * 10 + (*p - '0'), 1 << 20);
+            any = true;
+        }
+        if (any) out = v;
+        return any;
+    };
+    number(spec.width);
+    if (p != last && *p == '.') {
+        ++p;
+        if (!number(spec.precision)) return nullptr;
+        spec.precision = std::min(spec.precision, max_format_precision);
+    }
+    if (p != last && *p != '}') {
+        constexpr std::string_view types = "eEfFgGxXlv";
+        if (types.find(*p) == std::string_view::npos) return nullptr;
+        spec.type = *p++;
+    }
+    if (p != last && *p != '}') return nullptr;
+    return p;
+}
+
+/// Field breakdown for the 'v' type.
+template <size_t N>
+inline std::to_chars_result write_fields(char* first, char* last, const takum<N>& x) noexcept {
+    const uint64_t bits = static_cast<uint64_t>(x.raw_bits());
+    const uint64_t u = bits & magnitude_mask<N>;
+    const bool D = (u >> (N - 2)) & 1u;
+    const uint32_t R = static_cast<uint32_t>((u >> (N - 5)) & 7u);
+    const uint32_t r = D ? R : 7u - R;
+    const size_t p = N - 5 - r;
+    const uint64_t c_bits = r ? (u >> p) & ((uint64_t{1} << r) - 1) : 0;
+    const int64_t c = D ? static_cast<int64_t>((uint64_t{1} << r) - 1 + c_bits)
+                        : -(int64_t{1} << (r + 1)) + 1 + static_cast<int64_t>(c_bits);
+    const uint64_t m_bits = p ? u & ((uint64_t{1} << p) - 1) : 0;
+
+    char_writer w{first, last};
+    auto text = [&](std::string_view s) {
+        for (char ch : s) w.put(ch);
+    };
+    auto integer = [&](auto v, int base) {
+        char buf[24];
+        const auto r2 = std::to_chars(buf, buf + sizeof(buf), v, base);
+        text(std::string_view(buf, static_cast<size_t>(r2.ptr - buf)));
+    };
+    text("S=");
+    integer(static_cast<unsigned>(bits >> (N - 1)), 10);
+    text(" D=");
+    integer(static_cast<unsigned>(D), 10);
+    text(" R=");
+    integer(R, 10);
+    text(" C=");
+    integer(c_bits, 10);
+    text(" M=0x");
+    integer(m_bits, 16);
+    text(" (c=");
+    integer(c, 10);
+    text(", p=");
+    integer(p, 10);
+    text(")");
+    return w.result();
+}
+
+/// Render @p x (unpadded) per @p spec into [first, last).
+template <size_t N>
+inline std::to_chars_result render(char* first, char* last, const takum<N>& x, const format_spec& spec) noexcept {
+    const char type = spec.type;
+    if (type == 'x' || type == 'X') {
+        char_writer w{first, last};
+        if (spec.alternate) {
+            w.put('0');
+            w.put(type);
+        }
+        auto r = std::to_chars(w.p, last, static_cast<uint64_t>(x.raw_bits()), 16);
+        if (r.ec != std::errc{}) return {last, std::errc::value_too_large};
+        if (type == 'X') std::transform(w.p, r.ptr, w.p, [](char c) { return static_cast<char>(std::toupper(c)); });
+        return r;
+    }
+    if (type == 'v') {
+        if (x.is_nar()) return to_chars(first, last, x, std::chars_format::general);
+        return write_fields(first, last, x);
+    }
+
+    char_writer w{first, last};
+    const bool negative = !x.is_nar() && ((static_cast<uint64_t>(x.raw_bits()) >> (N - 1)) & 1u);
+    if (!negative && !x.is_nar() && (spec.sign == '+' || spec.sign == ' ')) w.put(spec.sign);
+    if (!w.ok) return w.result();
+
+    std::to_chars_result r;
+    if (type == 'l') {
+        if (x.is_nar()) {
+            r = to_chars(w.p, last, x, std::chars_format::general);
+        } else if (x.is_zero()) {
+            constexpr std::string_view ninf = "-inf";
+            if (last - w.p < static_cast<std::ptrdiff_t>(ninf.size())) return {last, std::errc::value_too_large};
+            r = {std::copy(ninf.begin(), ninf.end(), w.p), std::errc{}};
+        } else {
+            const long double ell = ell_of_magnitude<N>(static_cast<uint64_t>(x.raw_bits()) & magnitude_mask<N>);
+            const long double signed_ell = negative ? -ell : ell;
+            r = spec.precision < 0 ? std::to_chars(w.p, last, signed_ell)
+                                   : std::to_chars(w.p, last, signed_ell, std::chars_format::general, spec.precision);
+        }
+    } else if (type == 0) {
+        r = spec.precision < 0 ? to_chars(w.p, last, x)
+                               : to_chars(w.p, last, x, std::chars_format::general, spec.precision);
+    } else {
+        const char lower = static_cast<char>(std::tolower(type));
+        const std::chars_format fmt = lower == 'e' ? std::chars_format::scientific
+                                    : lower == 'f' ? std::chars_format::fixed
+                                                   : std::chars_format::general;
+        r = to_chars(w.p, last, x, fmt, spec.precision < 0 ? 6 : spec.precision);
+    }
+    if (r.ec == std::errc{} && type >= 'A' && type <= 'Z') {
+        std::transform(first, r.ptr, first, [](char c) { return c == 'e' ? 'E' : c; });
+    }
+    return r;
+}
+
+/// Render @p x per @p spec, pad to the field width and copy to @p out.
+template <size_t N, typename OutIt>
+inline OutIt format_to(OutIt out, const takum<N>& x, const format_spec& spec) {
+    char buf[max_format_precision + 96];
+    const auto r = render(buf, buf + sizeof(buf), x, spec);
+    const std::string_view body(buf, r.ec == std::errc{} ? static_cast<size_t>(r.ptr - buf) : 0);
+    const size_t width = static_cast<size_t>(std::max(spec.width, 0));
+    const size_t pad = body.size() < width ? width - body.size() : 0;
+
+    const bool numeric = spec.type != 'x' && spec.type != 'X' && spec.type != 'v';
+    if (spec.zero_pad && !spec.align && numeric && !x.is_nar()) {
+        const size_t sign = !body.empty() && (body[0] == '-' || body[0] == '+' || body[0] == ' ') ? 1 : 0;
+        out = std::copy(body.begin(), body.begin() + static_cast<std::ptrdiff_t>(sign), out);
+        out = std::fill_n(out, pad, '0');
+        return std::copy(body.begin() + static_cast<std::ptrdiff_t>(sign), body.end(), out);
+    }
+    const char align = spec.align ? spec.align : '>';
+    const size_t before = align == '<' ? 0 : align == '^' ? pad / 2 : pad;
+    out = std::fill_n(out, before, spec.fill);
+    out = std::copy(body.begin(), body.end(), out);
+    return std::fill_n(out, pad - before, spec.fill);
+}
+
+/// Translate stream flags into a format_spec (width/fill are left to the stream).
+inline format_spec stream_spec(const std::ios_base& os) noexcept {
+    format_spec spec;
+    const auto flags = os.flags();
+    const bool upper = (flags & std::ios_base::uppercase) != 0;
+    const auto field = flags & std::ios_base::floatfield;
+    const int precision = static_cast<int>(std::min<std::streamsize>(os.precision(), max_format_precision));
+    if (field == (std::ios_base::fixed | std::ios_base::scientific)) {
+        spec.type = upper ? 'X' : 'x';
+    } else if (field == std::ios_base::fixed) {
+        spec.type = upper ? 'F' : 'f';
+        spec.precision = precision;
+    } else if (field == std::ios_base::scientific) {
+        spec.type = upper ? 'E' : 'e';
+        spec.precision = precision;
+    }
+    if (flags & std::ios_base::showpos) spec.sign = '+';
+    return spec;
+}
+
+} // namespace internal
+
+/**
+ * @brief Write @p x to @p os (shortest round-trip unless fixed/scientific is set).
+ */
+template <size_t N>
+inline std::ostream& operator<<(std::ostream& os, const takum<N>& x) {
+    char buf[internal::max_format_precision + 96];
+    const auto r = internal::render(buf, buf + sizeof(buf), x, internal::stream_spec(os));
+    if (r.ec != std::errc{}) {
+        os.setstate(std::ios_base::failbit);
+        return os;
+    }
+    return os << std::string_view(buf, static_cast<size_t>(r.ptr - buf));
+}
+
+/**
+ * @brief Read one takum token (decimal, NaR/inf/nan, or hex pattern under hexfloat).
+ */
+template <size_t N>
+inline std::istream& operator>>(std::istream& is, takum<N>& x) {
+    std::istream::sentry guard(is);
+    if (!guard) return is;
+    char buf[128];
+    size_t n = 0;
+    const bool hex = (is.flags() & std::ios_base::floatfield) == (std::ios_base::fixed | std::ios_base::scientific);
+    auto token_char = [&](int c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '.' ||
+               c == '-' || c == '+';
+    };
+    for (int c = is.rdbuf()->sgetc(); c != std::char_traits<char>::eof() && token_char(c);
+         c = is.rdbuf()->snextc()) {
+        if (n == sizeof(buf)) {
+            is.setstate(std::ios_base::failbit);
+            return is;
+        }
+        buf[n++] = static_cast<char>(c);
+    }
+    if (is.rdbuf()->sgetc() == std::char_traits<char>::eof()) is.setstate(std::ios_base::eofbit);
+    const char* first = n != 0 && buf[0] == '+' ? buf + 1 : buf;
+    takum<N> value{};
+    const auto r = from_chars(first, buf + n, value, hex ? std::chars_format::hex : std::chars_format::general);
+    if (first == buf + n || r.ec != std::errc{} || r.ptr != buf + n) {
+        is.setstate(std::ios_base::failbit);
+        return is;
+    }
+    x = value;
+    return is;
+}
+
+} // namespace takum
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+namespace std {
+
+/// std::format support for takum<N>; see format.h for the spec grammar.
+template <size_t N>
+struct formatter<takum::takum<N>, char> {
+    takum::internal::format_spec spec;
+
+    constexpr format_parse_context::iterator parse(format_parse_context& ctx) {
+        const char* first = std::to_address(ctx.begin());
+        const char* end = takum::internal::parse_format_spec(first, std::to_address(ctx.end()), spec);
+        if (!end) throw format_error("takum: invalid format spec");
+        return ctx.begin() + (end - first);
+    }
+
+    template <typename FormatContext>
+    typename FormatContext::iterator format(const takum::takum<N>& x, FormatContext& ctx) const {
+        return takum::internal::format_to(ctx.out(), x, spec);
+    }
+};
+
+} // namespace std
+#endif
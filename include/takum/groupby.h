@@ -0,0 +1,506 @@
+/**
+ * @file groupby.h
+ * @brief Group-by aggregation of takum columns keyed by integer group IDs.
+ *
+ * `group_by` aggregates rows whose IDs are dense in [0, groups) into
+ * directly indexed tables; `group_by_key` takes arbitrary integer keys and
+ * groups them either with open-addressing hash tables or by sorting
+ * (key, row) pairs. Every driver gives each worker thread its own partial
+ * table and merges the partials in chunk order at the end.
+ *
+ * Aggregates, selected with a group_agg mask:
+ *
+ * - count: non-NaR rows of the group.
+ * - sum / mean: decoded values (table lookup for N <= 16) summed with
+ *   Neumaier compensation, rounded to takum<N> once per group. Above 32 bits
+ *   values are decoded and summed in wide_float, so takum<64> keeps its
+ *   precision.
+ * - min / max: compared on the raw bits through scan.h order keys; no decode.
+ *   Like the scans, this limits grouping to N <= 64.
+ * - product: sums ℓ (integer ℓ for 12 <= N <= 32) and tracks sign parity and
+ *   zeros, so it neither overflows nor underflows before the final rounding,
+ *   which saturates like the encoder.
+ * - logsumexp: log Σ exp(x) with a running maximum.
+ *
+ * group_by_key() over keys spanning a small range (at most the row count,
+ * and at most 2^16) skips the hash or sort and indexes a dense table by
+ * `key - min`, which is what group_by() does.
+ *
+ * NaR rows are skipped, like SQL NULLs. A group without non-NaR rows has a
+ * zero sum, a product of one, and NaR min, max, mean and logsumexp.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/elementwise.h"
+#include "takum/scan.h"
+#include "takum/internal/parallel.h"
+
+namespace takum {
+
+/**
+ * @brief Aggregates computed by group_by() / group_by_key() (bit mask).
+ */
+enum group_agg : unsigned {
+    agg_count = 1u << 0,
+    agg_sum = 1u << 1,
+    agg_min = 1u << 2,
+    agg_max = 1u << 3,
+    agg_mean = 1u << 4,
+    agg_product = 1u << 5,
+    agg_logsumexp = 1u << 6,
+    agg_all = (1u << 7) - 1u
+};
+
+/**
+ * @brief How group_by_key() finds the groups.
+ */
+enum class group_strategy : uint8_t {
+    hash, ///< Per-thread open-addressing tables; best for few, repeated keys
+    sort  ///< Per-thread sorted runs merged at the end; best for many distinct keys
+};
+
+/**
+ * @brief Per-group results, one entry per group in ascending key order.
+ *
+ * Only the vectors of the requested aggregates are filled; `keys` always is.
+ */
+template <size_t N, typename Key = uint64_t>
+struct group_result {
+    std::vector<Key> keys;
+    std::vector<uint64_t> count;
+    std::vector<takum<N>> sum;
+    std::vector<takum<N>> min;
+    std::vector<takum<N>> max;
+    std::vector<takum<N>> mean;
+    std::vector<takum<N>> product;
+    std::vector<takum<N>> logsumexp;
+
+    size_t size() const noexcept { return keys.size(); }
+};
+
+namespace internal {
+
+/// @brief Running aggregates of one group.
+template <size_t N>
+struct group_state {
+    static_assert(N <= 64, "groupby: only single-word takum widths are supported");
+
+    using key_t = scan_key_t<N>;
+    using acc_t = wide_acc_t<N>;
+
+    uint64_t count = 0;
+    acc_t sum = 0;
+    acc_t comp = 0; ///< Neumaier compensation of sum
+    key_t min_key = internal::max_key<N>();
+    key_t max_key{};
+    acc_t ell = 0; ///< Σℓ of the non-zero rows
+    uint64_t negatives = 0;
+    uint64_t zeros = 0;
+    acc_t lse_max = -std::numeric_limits<acc_t>::infinity();
+    acc_t lse_sum = 0; ///< Σ exp(x - lse_max)
+
+    void add_sum(acc_t x) noexcept {
+        const acc_t t = sum + x;
+        comp += std::fabs(sum) >= std::fabs(x) ? (sum - t) + x : (x - t) + sum;
+        sum = t;
+    }
+
+    void add_lse(acc_t m, acc_t s) noexcept {
+        if (s == 0) return;
+        if (m > lse_max) {
+            lse_sum = lse_sum * std::exp(lse_max - m) + s;
+            lse_max = m;
+        } else {
+            lse_sum += s * std::exp(m - lse_max);
+        }
+    }
+
+    void merge(const group_state& o) noexcept {
+        count += o.count;
+        add_sum(o.sum);
+        comp += o.comp;
+        min_key = std::min(min_key, o.min_key);
+        max_key = std::max(max_key, o.max_key);
+        ell += o.ell;
+        negatives += o.negatives;
+        zeros += o.zeros;
+        add_lse(o.lse_max, o.lse_sum);
+    }
+};
+
+/// @brief Adds rows to group states; decodes once per row and only for the
+/// aggregates that need the value.
+template <size_t N>
+struct group_adder {
+    unsigned aggs;
+    wide_decoder<N> dec;
+    scan_key_t<N> nar = nar_key<N>();
+    bool need_value = (aggs & (agg_sum | agg_mean | agg_logsumexp)) != 0;
+
+    explicit group_adder(unsigned a) : aggs(a) {}
+
+    void operator()(group_state<N>& g, const takum<N>& t) const noexcept {
+        add(g, t, need_value ? dec(t) : wide_acc_t<N>{});
+    }
+
+    /// @brief Add row @p t whose value @p x was decoded ahead (ignored unless need_value).
+    void add(group_state<N>& g, const takum<N>& t, wide_acc_t<N> x) const noexcept {
+        const scan_key_t<N> k = order_key(t);
+        if (k == nar) TAKUM_UNLIKELY return;
+        ++g.count;
+        g.min_key = std::min(g.min_key, k);
+        g.max_key = std::max(g.max_key, k);
+        if (aggs & agg_product) add_ell(g, t);
+        if (!need_value) return;
+        g.add_sum(x);
+        if (aggs & agg_logsumexp) {
+            if (x > g.lse_max) TAKUM_UNLIKELY {
+                g.lse_sum = g.lse_sum * std::exp(g.lse_max - x) + 1;
+                g.lse_max = x;
+            } else {
+                g.lse_sum += std::exp(x - g.lse_max);
+            }
+        }
+    }
+
+    static void add_ell(group_state<N>& g, const takum<N>& t) noexcept {
+        if (t.is_zero()) {
+            ++g.zeros;
+            return;
+        }
+        g.negatives += t.signbit() ? 1 : 0;
+        if constexpr (uses_int_ell<N>) {
+            g.ell += std::ldexp(static_cast<double>(ell_fixed<N>(t.storage)), -ell_frac_bits);
+        } else if constexpr (N > 32) {
+            g.ell += ell_wide<N>(t.storage);
+        } else {
+            g.ell += 2.0 * std::log(std::fabs(t.to_double()));
+        }
+    }
+};
+
+/// @brief Append the finished aggregates of @p g to @p out.
+template <size_t N, typename Key>
+inline void emit_group(group_result<N, Key>& out, Key key, const group_state<N>& g, unsigned aggs) {
+    out.keys.push_back(key);
+    const bool empty = g.count == 0;
+    const auto total = g.sum + g.comp;
+    if (aggs & agg_count) out.count.push_back(g.count);
+    if (aggs & agg_sum) out.sum.push_back(encode_wide<N>(total));
+    if (aggs & agg_min) out.min.push_back(empty ? takum<N>::nar() : from_order_key<N>(g.min_key));
+    if (aggs & agg_max) out.max.push_back(empty ? takum<N>::nar() : from_order_key<N>(g.max_key));
+    if (aggs & agg_mean) {
+        out.mean.push_back(empty ? takum<N>::nar() : encode_wide<N>(total / static_cast<decltype(total)>(g.count)));
+    }
+    if (aggs & agg_product) {
+        if (g.zeros != 0) {
+            out.product.push_back(takum<N>{});
+        } else if (empty) {
+            out.product.push_back(takum<N>(1.0));
+        } else {
+            out.product.push_back(saturating_from_ell<N>((g.negatives & 1u) != 0, g.ell));
+        }
+    }
+    if (aggs & agg_logsumexp) {
+        out.logsumexp.push_back(empty ? takum<N>::nar() : encode_wide<N>(g.lse_max + std::log(g.lse_sum)));
+    }
+}
+
+/**
+ * @brief Open-addressing (linear probing) map from 64-bit keys to group states.
+ */
+template <size_t N>
+class group_table {
+public:
+    group_table() { rehash(64); }
+
+    group_state<N>& operator[](uint64_t key) {
+        if (2 * (used_ + 1) > slots_.size()) rehash(2 * slots_.size());
+        size_t i = slot(key);
+        while (slots_[i].used && slots_[i].key != key) i = (i + 1) & (slots_.size() - 1);
+        if (!slots_[i].used) {
+            slots_[i].used = true;
+            slots_[i].key = key;
+            ++used_;
+        }
+        return slots_[i].state;
+    }
+
+    /// @brief Call `f(key, state)` for every group, in slot order.
+    template <typename F>
+    void for_each(F&& f) const {
+        for (const auto& s : slots_) {
+            if (s.used) f(s.key, s.state);
+        }
+    }
+
+    size_t size() const noexcept { return used_; }
+
+private:
+    struct entry {
+        uint64_t key = 0;
+        bool used = false;
+        group_state<N> state;
+    };
+
+    size_t slot(uint64_t key) const noexcept {
+        // Fibonacci hashing spreads consecutive IDs across the table.
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - shift_));
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<entry> old = std::move(slots_);
+        slots_.assign(capacity, entry{});
+        shift_ = static_cast<unsigned>(std::countr_zero(capacity));
+        used_ = 0;
+        for (const auto& e : old) {
+            if (e.used) (*this)[e.key] = e.state;
+        }
+    }
+
+    std::vector<entry> slots_;
+    unsigned shift_ = 0;
+    size_t used_ = 0;
+};
+
+/// @brief Key as the 64-bit pattern the tables store, order-preserving for signed keys.
+template <std::integral Key>
+inline uint64_t group_key_bits(Key k) noexcept {
+    if constexpr (std::is_signed_v<Key>) {
+        return static_cast<uint64_t>(static_cast<int64_t>(k)) ^ (uint64_t{1} << 63);
+    } else {
+        return static_cast<uint64_t>(k);
+    }
+}
+
+template <std::integral Key>
+inline Key group_key_from_bits(uint64_t b) noexcept {
+    if constexpr (std::is_signed_v<Key>) {
+        return static_cast<Key>(static_cast<int64_t>(b ^ (uint64_t{1} << 63)));
+    } else {
+        return static_cast<Key>(b);
+    }
+}
+
+/**
+ * @brief Stable LSD radix sort of (key, row) pairs by key, 8 bits per pass.
+ *
+ * One counting pass builds all eight digit histograms; digits on which every
+ * key agrees are skipped, so small or clustered key ranges take one or two
+ * passes.
+ */
+inline void radix_sort_by_key(std::vector<std::pair<uint64_t, size_t>>& rows) {
+    size_t hist[8][256] = {};
+    for (const auto& r : rows) {
+        for (unsigned d = 0; d < 8; ++d) ++hist[d][(r.first >> (8 * d)) & 0xFF];
+    }
+    std::vector<std::pair<uint64_t, size_t>> tmp(rows.size());
+    for (unsigned d = 0; d < 8; ++d) {
+        if (rows.empty() || hist[d][(rows[0].first >> (8 * d)) & 0xFF] == rows.size()) continue;
+        size_t offset[256];
+        size_t sum = 0;
+        for (size_t b = 0; b < 256; ++b) {
+            offset[b] = sum;
+            sum += hist[d][b];
+        }
+        for (const auto& r : rows) tmp[offset[(r.first >> (8 * d)) & 0xFF]++] = r;
+        rows.swap(tmp);
+    }
+}
+
+/// group_by_key() indexes a dense table when the keys span fewer values than this.
+inline constexpr uint64_t max_dense_key_span = uint64_t{1} << 16;
+
+/// Rows decoded at a time by dense_group_states().
+inline constexpr size_t dense_decode_block = 256;
+
+/**
+ * @brief States of @p groups directly indexed groups: row i goes to group
+ * `index_of(i)` unless that is out of range. Every worker fills its own
+ * table; the tables are merged in chunk order. With @p seen non-null,
+ * `(*seen)[g]` records whether any row (NaR or not) went to group g.
+ */
+template <size_t N, typename IndexOf>
+inline std::vector<group_state<N>> dense_group_states(std::span<const takum<N>> values, size_t n, size_t groups,
+                                                      unsigned aggs, IndexOf index_of,
+                                                      std::vector<uint8_t>* seen = nullptr) {
+    const group_adder<N> add(aggs);
+    std::vector<std::vector<group_state<N>>> partial(worker_count(n));
+    std::vector<std::vector<uint8_t>> partial_seen(seen ? partial.size() : 0);
+    parallel_for(n, [&](size_t begin, size_t end, size_t w) {
+        auto& table = partial[w];
+        table.resize(groups);
+        // Locals rather than captured references keep the row loop free of reloads.
+        const group_adder<N> local = add;
+        group_state<N>* states = table.data();
+        const takum<N>* x = values.data();
+        uint8_t* hit = nullptr;
+        if (seen) {
+            partial_seen[w].assign(groups, 0);
+            hit = partial_seen[w].data();
+        }
+        // Decoding a block ahead keeps the decode loop free of the table updates.
+        wide_acc_t<N> decoded[dense_decode_block] = {};
+        for (size_t b = begin; b < end; b += dense_decode_block) {
+            const size_t m = std::min(dense_decode_block, end - b);
+            if (local.need_value) {
+                for (size_t j = 0; j < m; ++j) decoded[j] = local.dec(x[b + j]);
+            }
+            for (size_t j = 0; j < m; ++j) {
+                const uint64_t g = index_of(b + j);
+                if (g < groups) TAKUM_LIKELY {
+                    if (hit) hit[g] = 1;
+                    local.add(states[g], x[b + j], decoded[j]);
+                }
+            }
+        }
+    });
+    std::vector<group_state<N>>& total = partial[0];
+    total.resize(groups);
+    if (seen) seen->assign(groups, 0);
+    for (size_t w = 0; w < partial.size(); ++w) {
+        if (partial[w].size() != groups) continue;
+        if (w != 0) {
+            for (size_t g = 0; g < groups; ++g) total[g].merge(partial[w][g]);
+        }
+        if (seen) {
+            for (size_t g = 0; g < groups; ++g) (*seen)[g] |= partial_seen[w][g];
+        }
+    }
+    return std::move(total);
+}
+
+} // namespace internal
+
+/**
+ * @brief Aggregate @p values by dense group IDs in [0, @p groups).
+ *
+ * Processes `min(values.size(), ids.size())` rows; rows whose ID is out of
+ * range are ignored. Every worker fills its own table of @p groups states,
+ * so the memory is `workers × groups` states: prefer group_by_key() when
+ * @p groups is large compared with the row count.
+ *
+ * @return Results for every group 0 .. groups-1, empty or not
+ */
+template <size_t N, std::integral Id>
+inline group_result<N, Id> group_by(std::span<const takum<N>> values, std::span<const Id> ids, size_t groups,
+                                     unsigned aggs = agg_all) {
+    const size_t n = std::min(values.size(), ids.size());
+    const Id* id = ids.data();
+    // Negative IDs wrap out of range.
+    const auto total = internal::dense_group_states<N>(values, n, groups, aggs,
+                                                       [id](size_t i) { return static_cast<uint64_t>(id[i]); });
+    group_result<N, Id> out;
+    for (size_t g = 0; g < groups; ++g) internal::emit_group(out, static_cast<Id>(g), total[g], aggs);
+    return out;
+}
+
+/**
+ * @brief Aggregate @p values by arbitrary integer @p keys.
+ *
+ * Processes `min(values.size(), keys.size())` rows. Both strategies give
+ * identical groups; their results can differ only in the last bit of the
+ * compensated sums, whose merge order differs.
+ *
+ * @return One entry per distinct key, in ascending key order
+ */
+template <size_t N, std::integral Key>
+inline group_result<N, Key> group_by_key(std::span<const takum<N>> values, std::span<const Key> keys,
+                                          unsigned aggs = agg_all, group_strategy strategy = group_strategy::hash) {
+    using state = internal::group_state<N>;
+    using run = std::vector<std::pair<uint64_t, state>>;
+    const size_t n = std::min(values.size(), keys.size());
+    const Key* key = keys.data();
+
+    // Keys in a small range: index a dense table by key - lo instead.
+    std::vector<uint64_t> lo(internal::worker_count(n), ~uint64_t{0}), hi(lo.size(), 0);
+    internal::parallel_for(n, [&](size_t begin, size_t end, size_t w) {
+        uint64_t l = ~uint64_t{0}, h = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const uint64_t b = internal::group_key_bits(key[i]);
+            l = std::min(l, b);
+            h = std::max(h, b);
+        }
+        lo[w] = l;
+        hi[w] = h;
+    });
+    const uint64_t min_bits = n ? *std::min_element(lo.begin(), lo.end()) : 0;
+    const uint64_t max_bits = n ? *std::max_element(hi.begin(), hi.end()) : 0;
+    if (n != 0 && max_bits - min_bits < std::min<uint64_t>(n, internal::max_dense_key_span)) {
+        const size_t groups = static_cast<size_t>(max_bits - min_bits) + 1;
+        std::vector<uint8_t> seen;
+        const auto states = internal::dense_group_states<N>(
+            values, n, groups, aggs, [key, min_bits](size_t i) { return internal::group_key_bits(key[i]) - min_bits; },
+            &seen);
+        group_result<N, Key> out;
+        for (size_t g = 0; g < groups; ++g) {
+            if (seen[g]) internal::emit_group(out, internal::group_key_from_bits<Key>(min_bits + g), states[g], aggs);
+        }
+        return out;
+    }
+
+    const internal::group_adder<N> add(aggs);
+    std::vector<run> partial(internal::worker_count(n));
+
+    if (strategy == group_strategy::hash) {
+        internal::parallel_for(n, [&](size_t begin, size_t end, size_t w) {
+            internal::group_table<N> table;
+            for (size_t i = begin; i < end; ++i) add(table[internal::group_key_bits(keys[i])], values[i]);
+            run& r = partial[w];
+            r.reserve(table.size());
+            table.for_each([&](uint64_t k, const state& s) { r.emplace_back(k, s); });
+            std::sort(r.begin(), r.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        });
+    } else {
+        internal::parallel_for(n, [&](size_t begin, size_t end, size_t w) {
+            std::vector<std::pair<uint64_t, size_t>> rows(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                rows[i - begin] = {internal::group_key_bits(keys[i]), i - begin};
+            }
+            internal::radix_sort_by_key(rows);
+            run& r = partial[w];
+            for (const auto& [k, row] : rows) {
+                if (r.empty() || r.back().first != k) r.emplace_back(k, state{});
+                add(r.back().second, values[begin + row]);
+            }
+        });
+    }
+
+    // Merge the sorted per-worker runs in chunk order.
+    run merged = std::move(partial[0]);
+    for (size_t w = 1; w < partial.size(); ++w) {
+        run next;
+        next.reserve(merged.size() + partial[w].size());
+        size_t a = 0, b = 0;
+        while (a < merged.size() || b < partial[w].size()) {
+            if (b == partial[w].size() || (a < merged.size() && merged[a].first < partial[w][b].first)) {
+                next.push_back(std::move(merged[a++]));
+            } else if (a == merged.size() || partial[w][b].first < merged[a].first) {
+                next.push_back(std::move(partial[w][b++]));
+            } else {
+                merged[a].second.merge(partial[w][b++].second);
+                next.push_back(std::move(merged[a++]));
+            }
+        }
+        merged = std::move(next);
+    }
+    group_result<N, Key> out;
+    for (const auto& [k, s] : merged) internal::emit_group(out, internal::group_key_from_bits<Key>(k), s, aggs);
+    return out;
+}
+
+} // namespace takum
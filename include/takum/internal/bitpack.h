@@ -0,0 +1,154 @@
+/**
+ * @file bitpack.h
+ * @brief Dense packing of W-bit raw takum patterns into 64-bit words.
+ *
+ * Element i occupies bits [i·W, (i+1)·W) of a little-endian word stream, so
+ * a group of 64 elements always fills exactly W words. Bulk writers exploit
+ * that: groups of 64 can be packed independently (and in parallel) without
+ * two writers ever touching the same word.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace takum::internal {
+
+/// @brief Number of 64-bit words needed to hold @p count values of @p width bits.
+constexpr size_t packed_words(size_t count, size_t width) noexcept {
+    return (count * width + 63) / 64;
+}
+
+/// @brief Mask selecting the low @p width bits (width in 1..64).
+constexpr uint64_t low_mask(size_t width) noexcept {
+    return width >= 64 ? ~0ULL : ((1ULL << width) - 1ULL);
+}
+
+/**
+ * @brief Read element @p index of a packed stream of @p width-bit values.
+ */
+inline uint64_t read_packed(const uint64_t* words, size_t index, size_t width) noexcept {
+    const size_t bit = index * width;
+    const size_t w = bit / 64;
+    const size_t off = bit % 64;
+    uint64_t v = words[w] >> off;
+    if (off + width > 64) v |= words[w + 1] << (64 - off);
+    return v & low_mask(width);
+}
+
+/**
+ * @brief Overwrite element @p index of a packed stream of @p width-bit values.
+ */
+inline void write_packed(uint64_t* words, size_t index, size_t width, uint64_t value) noexcept {
+    const size_t bit = index * width;
+    const size_t w = bit / 64;
+    const size_t off = bit % 64;
+    const uint64_t mask = low_mask(width);
+    value &= mask;
+    words[w] = (words[w] & ~(mask << off)) | (value << off);
+    if (off + width > 64) {
+        const size_t spill = off + width - 64;
+        words[w + 1] = (words[w + 1] & ~low_mask(spill)) | (value >> (64 - off));
+    }
+}
+
+/**
+ * @brief Pack @p count values (low W bits of each) into @p out starting at bit 0.
+ *
+ * Writes exactly packed_words(count, W) words; trailing bits of the last word
+ * are zero.
+ *
+ * @tparam W Bit width of each value (1..64)
+ * @tparam Get Callable `uint64_t(size_t i)` returning value i
+ */
+template <size_t W, typename Get>
+inline void pack_bits(size_t count, Get&& get, uint64_t* out) noexcept {
+    static_assert(W >= 1 && W <= 64, "pack_bits: width must be 1..64");
+    uint64_t acc = 0;
+    size_t fill = 0;
+    size_t o = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t v = static_cast<uint64_t>(get(i)) & low_mask(W);
+        acc |= v << fill;
+        fill += W;
+        if (fill >= 64) {
+            out[o++] = acc;
+            fill -= 64;
+            acc = fill ? (v >> (W - fill)) : 0ULL;
+        }
+    }
+    if (fill) out[o] = acc;
+}
+
+/**
+ * @brief Unpack values [first, first + count) of a W-bit stream via `put(i, value)`.
+ *
+ * @tparam W Bit width of each value (1..64)
+ * @tparam Put Callable `void(size_t i, uint64_t value)`; i counts from 0
+ */
+template <size_t W, typename Put>
+inline void unpack_bits(const uint64_t* words, size_t first, size_t count, Put&& put) noexcept {
+    static_assert(W >= 1 && W <= 64, "unpack_bits: width must be 1..64");
+    const size_t bit = first * W;
+    const uint64_t* w = words + bit / 64;
+    size_t off = bit % 64;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t v = w[0] >> off;
+        if (off + W > 64) v |= w[1] << (64 - off);
+        put(i, v & low_mask(W));
+        off += W;
+        w += off / 64;
+        off %= 64;
+    }
+}
+
+namespace detail {
+
+template <size_t W>
+void pack_array(const uint64_t* in, size_t count, uint64_t* out) noexcept {
+    pack_bits<W>(count, [in](size_t i) { return in[i]; }, out);
+}
+
+template <size_t W>
+void unpack_array(const uint64_t* words, size_t count, uint64_t* out) noexcept {
+    unpack_bits<W>(words, 0, count, [out](size_t i, uint64_t v) { out[i] = v; });
+}
+
+using pack_fn = void (*)(const uint64_t*, size_t, uint64_t*) noexcept;
+
+inline constexpr auto pack_array_table = []<size_t... I>(std::index_sequence<I...>) {
+    return std::array<pack_fn, 64>{&pack_array<I + 1>...};
+}(std::make_index_sequence<64>{});
+
+inline constexpr auto unpack_array_table = []<size_t... I>(std::index_sequence<I...>) {
+    return std::array<pack_fn, 64>{&unpack_array<I + 1>...};
+}(std::make_index_sequence<64>{});
+
+} // namespace detail
+
+/**
+ * @brief Pack @p count values at a runtime @p width (0..64) via the fixed-width kernels.
+ *
+ * Width 0 writes nothing (every value must then be zero).
+ */
+inline void pack_array(size_t width, const uint64_t* in, size_t count, uint64_t* out) noexcept {
+    if (width != 0) detail::pack_array_table[width - 1](in, count, out);
+}
+
+/**
+ * @brief Unpack @p count values of runtime @p width (0..64) starting at bit 0.
+ *
+ * Width 0 yields zeros.
+ */
+inline void unpack_array(size_t width, const uint64_t* words, size_t count, uint64_t* out) noexcept {
+    if (width == 0) {
+        for (size_t i = 0; i < count; ++i) out[i] = 0;
+        return;
+    }
+    detail::unpack_array_table[width - 1](words, count, out);
+}
+
+} // namespace takum::internal
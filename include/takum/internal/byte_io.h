@@ -0,0 +1,41 @@
+/**
+ * @file byte_io.h
+ * @brief Little-endian integer (de)serialisation shared by the file formats.
+ *
+ * Header fields of every on-disk format in the library are little-endian
+ * regardless of host; these helpers read and write them byte by byte, which
+ * compilers lower to plain loads/stores on little-endian targets.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace takum::internal {
+
+/// @brief Write the low @p bytes bytes of @p v at @p p, least significant first.
+inline void store_le(uint8_t* p, uint64_t v, size_t bytes) noexcept {
+    for (size_t i = 0; i < bytes; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+/// @brief Read a @p bytes-byte little-endian unsigned integer from @p p.
+inline uint64_t load_le(const uint8_t* p, size_t bytes) noexcept {
+    uint64_t v = 0;
+    for (size_t i = 0; i < bytes; ++i) v |= uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+/// @brief Append the low @p bytes bytes of @p v to @p out, least significant first.
+inline void append_le(std::vector<uint8_t>& out, uint64_t v, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+/// @brief Reverse the byte order of every @p unit-byte word in @p bytes[0, size).
+inline void byteswap_units(uint8_t* bytes, size_t size, size_t unit) noexcept {
+    for (size_t at = 0; at + unit <= size; at += unit) std::reverse(bytes + at, bytes + at + unit);
+}
+
+} // namespace takum::internal
@@ -0,0 +1,151 @@
+/**
+ * @file file_map.h
+ * @brief Read-only memory mapping of a whole file (POSIX mmap / Win32 file mapping).
+ *
+ * Used by the on-disk array formats for zero-copy loads. On platforms with
+ * neither API the file is read into an owned buffer instead, so callers see
+ * the same interface everywhere.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "takum/compiler_detection.h"
+
+#if TAKUM_PLATFORM_WINDOWS
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif TAKUM_PLATFORM_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace takum::internal {
+
+/**
+ * @brief Move-only read-only view of a file's bytes.
+ */
+class file_map {
+public:
+    file_map() = default;
+    file_map(const file_map&) = delete;
+    file_map& operator=(const file_map&) = delete;
+    file_map(file_map&& other) noexcept { swap(other); }
+    file_map& operator=(file_map&& other) noexcept {
+        if (this != &other) {
+            release();
+            swap(other);
+        }
+        return *this;
+    }
+    ~file_map() { release(); }
+
+    /**
+     * @brief Map @p path read-only.
+     * @return false if the file cannot be opened or mapped
+     */
+    bool open(const std::string& path) {
+        release();
+#if TAKUM_PLATFORM_WINDOWS
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER sz{};
+        if (!GetFileSizeEx(file, &sz)) {
+            CloseHandle(file);
+            return false;
+        }
+        size_ = static_cast<size_t>(sz.QuadPart);
+        if (size_ != 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+        if (size_ != 0 && !data_) {
+            size_ = 0;
+            return false;
+        }
+        return true;
+#elif TAKUM_PLATFORM_UNIX
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ != 0) {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return false;
+            }
+            data_ = static_cast<const uint8_t*>(p);
+        }
+        ::close(fd);
+        return true;
+#else
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return false;
+        uint8_t chunk[1 << 16];
+        size_t got = 0;
+        while ((got = std::fread(chunk, 1, sizeof(chunk), f)) != 0) fallback_.insert(fallback_.end(), chunk, chunk + got);
+        const bool ok = !std::ferror(f);
+        std::fclose(f);
+        data_ = fallback_.data();
+        size_ = fallback_.size();
+        return ok;
+#endif
+    }
+
+    /// @brief True for a real OS mapping (false for the read-into-buffer fallback).
+    static constexpr bool is_os_mapping() noexcept { return TAKUM_PLATFORM_WINDOWS || TAKUM_PLATFORM_UNIX; }
+
+    /// @brief Mapped bytes (empty for an empty or unopened file).
+    std::span<const uint8_t> bytes() const noexcept { return {data_, size_}; }
+
+private:
+    void release() noexcept {
+        if (!data_) return;
+#if TAKUM_PLATFORM_WINDOWS
+        UnmapViewOfFile(data_);
+#elif TAKUM_PLATFORM_UNIX
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+#else
+        fallback_.clear();
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void swap(file_map& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        fallback_.swap(other.fallback_);
+    }
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint8_t> fallback_; ///< Only used without an OS mapping API
+};
+
+} // namespace takum::internal
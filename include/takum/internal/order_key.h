@@ -0,0 +1,73 @@
+/**
+ * @file order_key.h
+ * @brief Unsigned keys that order takum patterns by value.
+ *
+ * The takum patterns here are sign-magnitude, so neither the signed nor the
+ * unsigned storage integer orders them by value. order_key() maps a pattern
+ * to an unsigned key that does; the scans, zone maps, bit-sliced columns,
+ * group-by min/max and the .tka block index all compare through it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "takum/core.h"
+
+namespace takum::internal {
+
+/// @brief Unsigned order key: the storage word of the pattern.
+template <size_t N>
+using scan_key_t = typename takum<N>::storage_t;
+
+/**
+ * @brief Order key of a pattern, so that real values compare by value.
+ *
+ * Takum patterns are sign-magnitude here, so the key sets the sign bit of
+ * non-negative patterns and complements negative ones (the IEEE
+ * total-order trick). NaR lands between the negatives and zero; the
+ * kernels exclude it explicitly.
+ *
+ * Only single-word widths have keys: the multiword codec does not encode
+ * the mantissa monotonically, so no order on the bits of a takum<N> with
+ * N > 64 is its value order.
+ */
+template <size_t N>
+inline scan_key_t<N> order_key(const takum<N>& t) noexcept {
+    static_assert(N <= 64, "order_key: only single-word takum widths are supported");
+    using storage_t = typename takum<N>::storage_t;
+    constexpr storage_t sign = storage_t{1} << (N - 1);
+    constexpr storage_t mask = sign | (sign - 1);
+    const storage_t s = t.storage & mask;
+    // Branch-free: flip only the sign bit of non-negative patterns, all bits of negative ones.
+    const storage_t negative = static_cast<storage_t>(0) - static_cast<storage_t>(s >> (N - 1));
+    return static_cast<storage_t>(s ^ (sign | (negative & (sign - 1))));
+}
+
+/// @brief Pattern with order key @p k (inverse of order_key()).
+template <size_t N>
+inline takum<N> from_order_key(const scan_key_t<N>& k) noexcept {
+    static_assert(N <= 64, "order_key: only single-word takum widths are supported");
+    using storage_t = typename takum<N>::storage_t;
+    constexpr storage_t sign = storage_t{1} << (N - 1);
+    const storage_t non_negative = static_cast<storage_t>(0) - static_cast<storage_t>(k >> (N - 1));
+    takum<N> t;
+    t.storage = static_cast<storage_t>(k ^ (sign | (~non_negative & (sign - 1))));
+    return t;
+}
+
+/// @brief Key of the NaR pattern.
+template <size_t N>
+inline scan_key_t<N> nar_key() noexcept {
+    return order_key(takum<N>::nar());
+}
+
+/// @brief Largest order key (all ones); the empty-range start for running minima.
+template <size_t N>
+inline scan_key_t<N> max_key() noexcept {
+    static_assert(N <= 64, "order_key: only single-word takum widths are supported");
+    return static_cast<scan_key_t<N>>(~scan_key_t<N>{});
+}
+
+} // namespace takum::internal
@@ -0,0 +1,85 @@
+/**
+ * @file parallel.h
+ * @brief Minimal fork/join helper used by the bulk (span-based) APIs.
+ *
+ * Splits an index range into contiguous chunks and runs each chunk on its own
+ * `std::thread`, with the calling thread taking the first chunk. Work below
+ * TAKUM_PARALLEL_GRAIN elements, or builds with TAKUM_ENABLE_THREADS=0, run
+ * inline so small inputs never pay thread start-up costs.
+ *
+ * The helper is deliberately tiny: no pool, no global state. Callers that need
+ * per-thread partial results size them with worker_count() and index them with
+ * the worker id passed to the body. Status flags (status_flags.h) raised on
+ * worker threads are folded into the calling thread's register.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "takum/config.h"
+#include "takum/status_flags.h"
+
+namespace takum::internal {
+
+/**
+ * @brief Number of workers parallel_for() will use for @p n elements.
+ *
+ * @param n Number of elements in the range
+ * @param grain Minimum elements per worker
+ * @return Worker count in [1, hardware_concurrency]
+ */
+inline size_t worker_count(size_t n, size_t grain = TAKUM_PARALLEL_GRAIN) noexcept {
+#if TAKUM_ENABLE_THREADS
+    if (grain == 0) grain = 1;
+    size_t hw = std::thread::hardware_concurrency();
+    if (hw == 0) hw = 1;
+    size_t wanted = n / grain;
+    return std::max<size_t>(1, std::min(hw, wanted));
+#else
+    (void)n; (void)grain;
+    return 1;
+#endif
+}
+
+/**
+ * @brief Run `f(begin, end, worker)` over contiguous chunks of [0, n).
+ *
+ * Chunks are balanced to within one element and passed to workers in order,
+ * so worker `w` always sees the w-th chunk. Returns after every chunk has
+ * completed.
+ *
+ * @param n Number of elements in the range
+ * @param f Callable invoked as `f(size_t begin, size_t end, size_t worker)`
+ * @param grain Minimum elements per worker (see worker_count())
+ */
+template <typename F>
+inline void parallel_for(size_t n, F&& f, size_t grain = TAKUM_PARALLEL_GRAIN) {
+    if (n == 0) return;
+    const size_t workers = worker_count(n, grain);
+    if (workers == 1) {
+        f(size_t{0}, n, size_t{0});
+        return;
+    }
+    const size_t base = n / workers;
+    const size_t extra = n % workers;
+    auto chunk_begin = [&](size_t w) { return w * base + std::min(w, extra); };
+
+    std::vector<std::thread> pool;
+    std::vector<unsigned> flags(workers, 0u);
+    pool.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) {
+        pool.emplace_back([&f, &flags, b = chunk_begin(w), e = chunk_begin(w + 1), w] {
+            f(b, e, w);
+            flags[w] = test_flags();
+        });
+    }
+    f(size_t{0}, chunk_begin(1), size_t{0});
+    for (auto& t : pool) t.join();
+    for (unsigned fl : flags) raise_flags(fl);
+}
+
+} // namespace takum::internal
@@ -100,7 +100,7 @@ inline uint64_t time_ns(F&& f, size_t iters = 1000) {
  * @details
  * **Sweep Pattern:**
  * - Uniform sampling over domain [-0.5, 0.5]
- * - Processes samples * sizeof(long double) bytes of computation
+ * - Processes samples * sizeof(wide_float) bytes of computation
  * - Accumulates results to prevent dead code elimination
  * - Exercises typical usage patterns for Φ evaluation
  *
@@ -118,14 +118,13 @@ inline uint64_t time_ns(F&& f, size_t iters = 1000) {
  * @note Combine with time_ns() for complete performance profiling
  */
 template <size_t N>
-inline long double sweep_sum(size_t samples = 1024) {
-    long double acc = 0.0L;
+inline wide_float sweep_sum(size_t samples = 1024) {
+    wide_float acc = 0.0;
     for (size_t i = 0; i < samples; ++i) {
-        long double t = -0.5L + (static_cast<long double>(i) / static_cast<long double>(samples));
+        wide_float t = -0.5 + (static_cast<wide_float>(i) / static_cast<wide_float>(samples));
         acc += phi_eval<N>(t).value;
     }
     return acc;
 }
-}
 
-} // namespace takum::internal::phi::bench
\ No newline at end of file
+} // namespace takum::internal::phi::bench
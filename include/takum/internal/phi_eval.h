@@ -17,7 +17,7 @@
 //    takum16/32 without changing callers.
 //
 // The polynomial coefficients in poly_coeffs[][] are stored in Q16 fixed-point
-// (see generated header). We evaluate using Horner in long double for precision.
+// (see generated header). We evaluate using Horner in wide_float (long double unless TAKUM_NO_LONG_DOUBLE).
 // Interval mapping: incoming t is clamped to [-0.5, 0). Intervals partition that
 // range uniformly (NUM_INTERVALS). Each interval i covers [ -0.5 + i*step , -0.5 + (i+1)*step ).
 // Step = 0.5 / NUM_INTERVALS.
@@ -35,25 +35,25 @@ namespace takum::internal::phi {
 
 // PhiEvalResult now in phi_types.h
 
-inline PhiEvalResult phi_poly_eval(long double t) noexcept {
+inline PhiEvalResult phi_poly_eval(wide_float t) noexcept {
     // Generated coefficients cover the full domain [-0.5, +0.5] uniformly.
-    if (t > 0.5L) t = 0.5L;
-    if (t < -0.5L) t = -0.5L;
-    constexpr long double domain_min = -0.5L;
-    constexpr long double domain_max = 0.5L;
-    constexpr long double span = domain_max - domain_min; // 1.0
-    long double u = (t - domain_min) / span; // in [0,1]
-    long double f_index = u * static_cast<long double>(NUM_INTERVALS);
+    if (t > 0.5) t = 0.5;
+    if (t < -0.5) t = -0.5;
+    constexpr wide_float domain_min = -0.5;
+    constexpr wide_float domain_max = 0.5;
+    constexpr wide_float span = domain_max - domain_min; // 1.0
+    wide_float u = (t - domain_min) / span; // in [0,1]
+    wide_float f_index = u * static_cast<wide_float>(NUM_INTERVALS);
     int idx = static_cast<int>(f_index);
     if (idx >= NUM_INTERVALS) idx = NUM_INTERVALS - 1;
     const int32_t* coeff = poly_coeffs[idx];
-    long double scale = 1.0L / static_cast<long double>(1ULL << Q_FRAC_BITS);
-    long double acc = 0.0L;
+    wide_float scale = 1.0 / static_cast<wide_float>(1ULL << Q_FRAC_BITS);
+    wide_float acc = 0.0;
     for (int d = POLY_DEGREE; d >= 0; --d) {
-        long double c = static_cast<long double>(coeff[d]) * scale;
+        wide_float c = static_cast<wide_float>(coeff[d]) * scale;
         acc = acc * t + c;
     }
-    long double eb = static_cast<long double>(max_errors[idx]);
+    wide_float eb = static_cast<wide_float>(max_errors[idx]);
     return { acc, eb, idx };
 }
 
@@ -69,54 +69,54 @@ constexpr int HYBRID_LUT_SIZE = TAKUM_COARSE_LUT_SIZE; // macro-configurable
 static_assert(HYBRID_LUT_SIZE > 0 && HYBRID_LUT_SIZE <= 4096,
     "HYBRID_LUT_SIZE must be in (0, 4096] for phi_hybrid_eval");
 struct HybridCoarseLUT {
-    std::array<long double, HYBRID_LUT_SIZE + 1> v{}; // endpoints inclusive
+    std::array<wide_float, HYBRID_LUT_SIZE + 1> v{}; // endpoints inclusive
     // NOTE: This constructor cannot be constexpr because it calls phi_poly_eval(t),
     // which is not declared constexpr. Making it a normal runtime constructor
     // ensures correct initialization while retaining the lazy static initialization
     // semantics we want.
     HybridCoarseLUT() noexcept : v{} {
         for (int i = 0; i <= HYBRID_LUT_SIZE; ++i) {
-            long double t = -0.5L + (static_cast<long double>(i) / HYBRID_LUT_SIZE);
+            wide_float t = -0.5 + (static_cast<wide_float>(i) / HYBRID_LUT_SIZE);
             auto poly = phi_poly_eval(t); // runtime seed
             v[i] = poly.value;
         }
     }
 };
-inline const HybridCoarseLUT& coarse_hybrid_table() {
+TAKUM_NOINLINE inline const HybridCoarseLUT& coarse_hybrid_table() {
     static const HybridCoarseLUT tbl{}; // lazily constructed at first use
     return tbl;
 }
 
-inline PhiEvalResult phi_hybrid_eval(long double t) noexcept {
+inline PhiEvalResult phi_hybrid_eval(wide_float t) noexcept {
     // Clamp
-    if (t > 0.5L) t = 0.5L; else if (t < -0.5L) t = -0.5L;
+    if (t > 0.5) t = 0.5; else if (t < -0.5) t = -0.5;
     // Coarse interval
-    long double u = (t + 0.5L); // [0,1]
-    long double coarse_f = u * HYBRID_LUT_SIZE;
+    wide_float u = (t + 0.5); // [0,1]
+    wide_float coarse_f = u * HYBRID_LUT_SIZE;
     int ci = static_cast<int>(coarse_f);
     if (ci >= HYBRID_LUT_SIZE) ci = HYBRID_LUT_SIZE - 1;
-    long double cfrac = coarse_f - static_cast<long double>(ci);
+    wide_float cfrac = coarse_f - static_cast<wide_float>(ci);
     const auto& cv = coarse_hybrid_table().v;
-    long double base0 = cv[ci];
-    long double base1 = cv[ci + 1];
-    long double coarse_interp = base0 + (base1 - base0) * cfrac;
+    wide_float base0 = cv[ci];
+    wide_float base1 = cv[ci + 1];
+    wide_float coarse_interp = base0 + (base1 - base0) * cfrac;
 
     // Fine polynomial interval refinement
     auto poly_res = phi_poly_eval(t);
-    long double residual = poly_res.value - coarse_interp;
+    wide_float residual = poly_res.value - coarse_interp;
     // Conservative combined error: poly_res.abs_error + interpolation diff scaling
-    long double eb = poly_res.abs_error + fabsl(residual) * 0.25L + 5e-6L;
+    wide_float eb = poly_res.abs_error + std::fabs(residual) * 0.25 + 5e-6;
     return { coarse_interp + residual, eb, ci };
 }
 } // namespace detail
 
 // Public internal API used by arithmetic (subject to refinement):
-inline long double phi(long double t) noexcept { return phi_poly_eval(t).value; }
+inline wide_float phi(wide_float t) noexcept { return phi_poly_eval(t).value; }
 
 // Precision-dispatching evaluator returning PhiEvalResult.
 // For small N (<=16, <=32) use LUT; else polynomial (future: hybrid).
 template <size_t N>
-inline PhiEvalResult phi_eval(long double t) noexcept {
+inline PhiEvalResult phi_eval(wide_float t) noexcept {
     if constexpr (N <= 16) {
         return phi_lut_1024(t);
     } else if constexpr (N <= 32) {
@@ -128,7 +128,7 @@ inline PhiEvalResult phi_eval(long double t) noexcept {
 
 // Convenience value-only accessor
 template <size_t N>
-inline long double phi_v(long double t) noexcept { return phi_eval<N>(t).value; }
+inline wide_float phi_v(wide_float t) noexcept { return phi_eval<N>(t).value; }
 
 // @deprecated This feature toggle is deprecated. Use the configuration macros
 // in config.h instead. Define TAKUM_ENABLE_FAST_ADD before including headers.
@@ -140,20 +140,20 @@ inline long double phi_v(long double t) noexcept { return phi_eval<N>(t).value;
 // Helper: check whether accumulated Φ error stays within λ(p) budget (informational for now)
 template <size_t N>
 inline bool within_phi_budget(const PhiEvalResult& r) noexcept {
-    return r.abs_error <= precision::lambda_p<N>();
+    return r.abs_error <= static_cast<wide_float>(precision::lambda_p<N>());
 }
 
-// Diagnostics counters (non-atomic to keep header-only & constexpr-friendly).
+// Diagnostics counters (per thread and non-atomic, so threaded callers never race).
 struct PhiDiagCounters {
     unsigned long eval_calls = 0;
     unsigned long budget_ok = 0;
     unsigned long budget_fail = 0;
-    long double worst_error = 0.0L;
+    wide_float worst_error = 0.0;
 };
 
 template <size_t N>
 inline PhiDiagCounters& phi_diag() {
-    static PhiDiagCounters c{};
+    static thread_local PhiDiagCounters c{};
     return c;
 }
 
@@ -169,4 +169,13 @@ inline void record_phi(const PhiEvalResult& r, bool ok) {
 #endif
 }
 
+#if TAKUM_COMPILED
+// Instantiated once in TakumCppCompiled (src/takum_compiled.cpp), tables included.
+extern template const std::array<uint32_t, 1025>& detail::get_lut<1024>();
+extern template const std::array<uint32_t, 4097>& detail::get_lut<4096>();
+#define TAKUM_EXTERN_PHI(N) extern template PhiEvalResult phi_eval<N>(wide_float) noexcept;
+TAKUM_COMPILED_WIDTHS(TAKUM_EXTERN_PHI)
+#undef TAKUM_EXTERN_PHI
+#endif
+
 } // namespace takum::internal::phi
@@ -60,11 +60,11 @@ namespace takum::internal::phi {
  */
 namespace detail {
     /// @brief Minimum value of the Φ function domain [-0.5, 0.5]
-    constexpr long double domain_min = -0.5L;
+    constexpr wide_float domain_min = -0.5;
     /// @brief Maximum value of the Φ function domain [-0.5, 0.5]  
-    constexpr long double domain_max =  0.5L;
+    constexpr wide_float domain_max =  0.5;
     /// @brief Total span of the Φ function domain (always 1.0)
-    constexpr long double span = domain_max - domain_min; // 1.0
+    constexpr wide_float span = domain_max - domain_min; // 1.0
 
     /**
      * @brief Reference implementation of the Φ (Gaussian-log) function.
@@ -76,10 +76,10 @@ namespace detail {
      * @param x Input value, typically in domain [-0.5, 0.5]
      * @return Φ(x) value in range [0, 1]
      *
-     * @note Uses long double precision for maximum accuracy in LUT generation
+     * @note Uses wide_float (long double unless TAKUM_NO_LONG_DOUBLE) for LUT generation
      */
-    inline long double phi_ref(long double x) {
-        return 0.5L * (1.0L + std::erfl(x / std::sqrt(2.0L)));
+    inline wide_float phi_ref(wide_float x) {
+        return 0.5 * (1.0 + std::erf(x / std::sqrt(wide_float(2))));
     }
 
     /**
@@ -110,8 +110,8 @@ namespace detail {
          */
         constexpr LutHolder() : data{} {
             for (size_t i = 0; i <= S; ++i) {
-                long double t = domain_min + (span * static_cast<long double>(i) / static_cast<long double>(S));
-                long double v = phi_ref(t);
+                wide_float t = domain_min + (span * static_cast<wide_float>(i) / static_cast<wide_float>(S));
+                wide_float v = phi_ref(t);
                 if (v < 0) v = 0; // clamp safety: floor
                 if (v > 1) v = 1; // clamp safety: ceiling
                 uint32_t q = static_cast<uint32_t>(std::llround(v * (1ull << 16)));
@@ -133,19 +133,19 @@ namespace detail {
      * @note Thread-safe due to static initialization guarantees in C++11+
      */
     template <size_t S>
-    inline const std::array<uint32_t, S+1>& get_lut() {
+    TAKUM_NOINLINE inline const std::array<uint32_t, S+1>& get_lut() {
         static const LutHolder<S> holder{}; // constexpr ctor
         return holder.data;
     }
 
     /**
-     * @brief Converts Q16 fixed-point value to long double.
+     * @brief Converts Q16 fixed-point value to wide_float.
      *
      * @param q Q16 fixed-point value (16 fractional bits)
-     * @return Equivalent long double value in range [0, 1]
+     * @return Equivalent wide_float value in range [0, 1]
      */
-    inline long double q16_to_ld(uint32_t q) {
-        return static_cast<long double>(q) / static_cast<long double>(1ull << 16);
+    inline wide_float q16_to_ld(uint32_t q) {
+        return static_cast<wide_float>(q) / static_cast<wide_float>(1ull << 16);
     }
 
     /**
@@ -171,20 +171,20 @@ namespace detail {
      * @note Input values outside [-0.5, 0.5] are automatically clamped to domain bounds
      */
     template <size_t S>
-    inline PhiEvalResult phi_lut_linear(long double t) noexcept {
+    inline PhiEvalResult phi_lut_linear(wide_float t) noexcept {
         if (t < domain_min) t = domain_min;
         if (t > domain_max) t = domain_max;
-        long double u = (t - domain_min) / span; // [0,1]
-        long double f_index = u * static_cast<long double>(S);
+        wide_float u = (t - domain_min) / span; // [0,1]
+        wide_float f_index = u * static_cast<wide_float>(S);
         size_t i = static_cast<size_t>(f_index);
         if (i >= S) i = S - 1; // last interval
-        long double frac = f_index - static_cast<long double>(i);
+        wide_float frac = f_index - static_cast<wide_float>(i);
         const auto& lut = get_lut<S>();
-        long double v0 = q16_to_ld(lut[i]);
-        long double v1 = q16_to_ld(lut[i+1]);
-        long double value = v0 + (v1 - v0) * frac;
+        wide_float v0 = q16_to_ld(lut[i]);
+        wide_float v1 = q16_to_ld(lut[i+1]);
+        wide_float value = v0 + (v1 - v0) * frac;
         // Conservative linear interpolation error bound: half interval slope magnitude
-        long double eb = fabsl(v1 - v0) * 0.5L + 1e-7L; // small slack
+        wide_float eb = std::fabs(v1 - v0) * 0.5 + 1e-7; // small slack
         return { value, eb, static_cast<int>(i) };
     }
 
@@ -219,56 +219,56 @@ namespace detail {
      * @note Input values outside [-0.5, 0.5] are automatically clamped to domain bounds
      */
     template <size_t S>
-    inline PhiEvalResult phi_lut_cubic(long double t) noexcept {
+    inline PhiEvalResult phi_lut_cubic(wide_float t) noexcept {
 #ifndef TAKUM_ENABLE_CUBIC_PHI_LUT
         return phi_lut_linear<S>(t);
 #else
         if (t < domain_min) t = domain_min;
         if (t > domain_max) t = domain_max;
-        long double u = (t - domain_min) / span; // [0,1]
-        long double f_index = u * static_cast<long double>(S);
+        wide_float u = (t - domain_min) / span; // [0,1]
+        wide_float f_index = u * static_cast<wide_float>(S);
         size_t i = static_cast<size_t>(f_index);
         if (i >= S) i = S - 1;
-        long double frac = f_index - static_cast<long double>(i);
+        wide_float frac = f_index - static_cast<wide_float>(i);
         const auto& lut = get_lut<S>();
 
-        auto sample = [&](ptrdiff_t idx) -> long double {
+        auto sample = [&](ptrdiff_t idx) -> wide_float {
             if (idx < 0) idx = 0;
             if (idx > static_cast<ptrdiff_t>(S)) idx = static_cast<ptrdiff_t>(S);
             return q16_to_ld(lut[static_cast<size_t>(idx)]);
         };
-        long double y0 = sample(static_cast<ptrdiff_t>(i) - 1);
-        long double y1 = sample(static_cast<ptrdiff_t>(i));
-        long double y2 = sample(static_cast<ptrdiff_t>(i) + 1);
-        long double y3 = sample(static_cast<ptrdiff_t>(i) + 2);
-        long double f = frac;
-        long double f2 = f * f;
-        long double f3 = f2 * f;
+        wide_float y0 = sample(static_cast<ptrdiff_t>(i) - 1);
+        wide_float y1 = sample(static_cast<ptrdiff_t>(i));
+        wide_float y2 = sample(static_cast<ptrdiff_t>(i) + 1);
+        wide_float y3 = sample(static_cast<ptrdiff_t>(i) + 2);
+        wide_float f = frac;
+        wide_float f2 = f * f;
+        wide_float f3 = f2 * f;
         // Catmull-Rom spline (centripetal equivalent for uniform spacing)
-        long double value = 0.5L * ((2.0L * y1) + (-y0 + y2) * f +
-                            (2.0L*y0 - 5.0L*y1 + 4.0L*y2 - y3) * f2 +
-                            (-y0 + 3.0L*y1 - 3.0L*y2 + y3) * f3);
+        wide_float value = 0.5 * ((2.0 * y1) + (-y0 + y2) * f +
+                            (2.0*y0 - 5.0*y1 + 4.0*y2 - y3) * f2 +
+                            (-y0 + 3.0*y1 - 3.0*y2 + y3) * f3);
         // Estimate error: use second finite difference magnitude
-        long double d2 = fabsl(y2 - 2.0L*y1 + y0) + fabsl(y3 - 2.0L*y2 + y1);
-        long double linear_seg = fabsl(y2 - y1);
-        long double eb = (d2 * 0.125L) + (linear_seg * 0.05L) + 5e-7L;
+        wide_float d2 = std::fabs(y2 - 2.0*y1 + y0) + std::fabs(y3 - 2.0*y2 + y1);
+        wide_float linear_seg = std::fabs(y2 - y1);
+        wide_float eb = (d2 * 0.125) + (linear_seg * 0.05) + 5e-7;
         // Sanity: ensure not tighter than linear bound times 0.3 unless extremely smooth
-        long double linear_bound = fabsl(y2 - y1) * 0.5L + 1e-7L;
-        if (eb < linear_bound * 0.3L) eb = linear_bound * 0.3L;
+        wide_float linear_bound = std::fabs(y2 - y1) * 0.5 + 1e-7;
+        if (eb < linear_bound * 0.3) eb = linear_bound * 0.3;
         return { value, eb, static_cast<int>(i) };
 #endif
     }
 }
 
 // Public small-precision LUT evaluators (S = LUT size)
-inline PhiEvalResult phi_lut_1024(long double t) noexcept {
+inline PhiEvalResult phi_lut_1024(wide_float t) noexcept {
 #ifdef TAKUM_ENABLE_CUBIC_PHI_LUT
     return detail::phi_lut_cubic<1024>(t);
 #else
     return detail::phi_lut_linear<1024>(t);
 #endif
 }
-inline PhiEvalResult phi_lut_4096(long double t) noexcept {
+inline PhiEvalResult phi_lut_4096(wide_float t) noexcept {
 #ifdef TAKUM_ENABLE_CUBIC_PHI_LUT
     return detail::phi_lut_cubic<4096>(t);
 #else
@@ -21,6 +21,8 @@
 
 #include <cstdint>
 
+#include "takum/config.h"
+
 /**
  * @namespace takum::internal::phi
  * @brief Internal implementation namespace for Φ (Gaussian-log) function evaluation.
@@ -57,10 +59,10 @@ namespace takum::internal::phi {
  */
 struct PhiEvalResult {
     /// @brief Approximated Φ(t) function value
-    long double value;
+    wide_float value;
     
     /// @brief Conservative absolute error bound: |true_phi(t) - value| ≤ abs_error
-    long double abs_error;
+    wide_float abs_error;
     
     /// @brief Interval/cell index for debugging and performance analysis
     /// @details Semantics depend on evaluation strategy:
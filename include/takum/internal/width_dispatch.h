@@ -0,0 +1,61 @@
+/**
+ * @file width_dispatch.h
+ * @brief Runtime → compile-time width dispatch for single-word takum formats.
+ *
+ * `takum<N>` fixes its width at compile time, but dataset tooling (width
+ * advice, runtime-width containers, converters) chooses N at runtime. This
+ * header holds the one list of widths that get precompiled kernels and the
+ * switch that maps a runtime width onto `std::integral_constant<size_t, N>`.
+ *
+ * Only single-word widths (12 ≤ N ≤ 64) are listed: they share the packed
+ * integer codec and cover the float16..float64 storage range.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace takum::internal {
+
+/// @brief Widths with precompiled runtime-dispatch kernels, narrowest first.
+using dispatch_widths = std::index_sequence<12, 16, 19, 20, 24, 28, 32, 40, 48, 56, 64>;
+
+/// @brief The dispatch widths as a constexpr array (same order as dispatch_widths).
+inline constexpr auto dispatch_width_table = []<size_t... Ns>(std::index_sequence<Ns...>) {
+    return std::array<size_t, sizeof...(Ns)>{Ns...};
+}(dispatch_widths{});
+
+/**
+ * @brief Test whether @p width has a precompiled dispatch kernel.
+ */
+constexpr bool is_dispatch_width(size_t width) noexcept {
+    for (size_t w : dispatch_width_table) if (w == width) return true;
+    return false;
+}
+
+/**
+ * @brief Invoke `f(std::integral_constant<size_t, N>{})` for the N equal to @p width.
+ *
+ * @return false (without calling @p f) when @p width is not a dispatch width
+ */
+template <typename F>
+inline bool dispatch_width(size_t width, F&& f) {
+    return [&]<size_t... Ns>(std::index_sequence<Ns...>) {
+        return ((width == Ns ? (f(std::integral_constant<size_t, Ns>{}), true) : false) || ...);
+    }(dispatch_widths{});
+}
+
+/**
+ * @brief Invoke `f(std::integral_constant<size_t, N>{})` for every dispatch width, narrowest first.
+ */
+template <typename F>
+inline void for_each_dispatch_width(F&& f) {
+    [&]<size_t... Ns>(std::index_sequence<Ns...>) {
+        (f(std::integral_constant<size_t, Ns>{}), ...);
+    }(dispatch_widths{});
+}
+
+} // namespace takum::internal
@@ -0,0 +1,413 @@
+/**
+ * @file mapped_array.h
+ * @brief Self-describing binary array file format with zero-copy memory-mapped loads.
+ *
+ * A `.tka` file stores takum<N> raw patterns exactly as they sit in memory,
+ * behind a small header, so loading is an mmap instead of a decode/encode
+ * round trip through text or doubles.
+ *
+ * **File layout** (header integers little-endian):
+ * ```
+ * 0   "TKA1"            magic
+ * 4   u8  version       (1)
+ * 5   u8  byte order    of element data and block index: 1 = little, 2 = big
+ * 6   u16 N
+ * 8   u32 element bytes (sizeof(takum<N>))
+ * 12  u32 rank
+ * 16  u64 element count
+ * 24  u64 data offset   (multiple of 64)
+ * 32  u64 index offset  (0 = no block index)
+ * 40  u64 block size    (elements per index block, 0 = no block index)
+ * 48  u64 block count
+ * 56  u32 0
+ * 60  u32 CRC-32 of bytes [0, 60) followed by the shape
+ * 64  rank × u64 shape
+ *     zero padding up to the data offset
+ *     count × element     raw storage
+ *     block_count × {element min, element max, u64 NaR count}   (optional)
+ * ```
+ * The optional block index records the minimum and maximum real value and
+ * the number of NaRs of each block, so range queries can skip blocks without
+ * touching their data.
+ *
+ * `mapped_array<N>` maps the file and exposes `std::span<const takum<N>>`
+ * directly over the mapping. Files written on a host of the other byte order
+ * are byte-swapped into an owned buffer instead (`zero_copy()` is false).
+ * `mapped_array_writer<N>` streams appends and finalises the header and
+ * index on `finish()`.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/result.h"
+#include "takum/internal/byte_io.h"
+#include "takum/internal/checksum.h"
+#include "takum/internal/file_map.h"
+#include "takum/internal/order_key.h"
+
+namespace takum {
+
+/// @brief Per-block statistics stored in the optional block index.
+template <size_t N>
+struct block_summary {
+    takum<N> min = takum<N>::nar(); ///< Smallest real value (NaR if the block is all NaR)
+    takum<N> max = takum<N>::nar(); ///< Largest real value (NaR if the block is all NaR)
+    uint64_t nar_count = 0;         ///< Number of NaR elements
+};
+
+namespace internal {
+
+inline constexpr uint8_t tka_magic[4] = {'T', 'K', 'A', '1'};
+inline constexpr uint8_t tka_version = 1;
+inline constexpr size_t tka_fixed_header = 64;
+inline constexpr size_t tka_alignment = 64;
+
+inline constexpr uint8_t native_byte_order() noexcept {
+    return std::endian::native == std::endian::little ? 1 : 2;
+}
+
+/// Storage word size that byte order applies to.
+template <size_t N>
+inline constexpr size_t tka_swap_unit = sizeof(takum<N>) < 8 ? sizeof(takum<N>) : 8;
+
+/// Bytes from the start of the file to the (aligned) data section.
+inline size_t tka_data_offset(size_t rank) noexcept {
+    const size_t head = tka_fixed_header + rank * 8;
+    return (head + tka_alignment - 1) / tka_alignment * tka_alignment;
+}
+
+/// Decoded fixed header.
+struct tka_header {
+    uint8_t byte_order = 0;
+    size_t width = 0;
+    size_t element_bytes = 0;
+    uint64_t count = 0;
+    uint64_t data_offset = 0;
+    uint64_t index_offset = 0;
+    uint64_t block_size = 0;
+    uint64_t block_count = 0;
+    std::vector<uint64_t> shape;
+};
+
+/// Serialise the header and shape into a buffer of data_offset bytes.
+inline std::vector<uint8_t> tka_encode_header(const tka_header& h) {
+    std::vector<uint8_t> out(h.data_offset, 0);
+    std::memcpy(out.data(), tka_magic, 4);
+    out[4] = tka_version;
+    out[5] = h.byte_order;
+    store_le(out.data() + 6, h.width, 2);
+    store_le(out.data() + 8, h.element_bytes, 4);
+    store_le(out.data() + 12, h.shape.size(), 4);
+    store_le(out.data() + 16, h.count, 8);
+    store_le(out.data() + 24, h.data_offset, 8);
+    store_le(out.data() + 32, h.index_offset, 8);
+    store_le(out.data() + 40, h.block_size, 8);
+    store_le(out.data() + 48, h.block_count, 8);
+    for (size_t d = 0; d < h.shape.size(); ++d) store_le(out.data() + tka_fixed_header + d * 8, h.shape[d], 8);
+    uint32_t crc = crc32(0, std::span<const uint8_t>(out.data(), 60));
+    crc = crc32(crc, std::span<const uint8_t>(out.data() + tka_fixed_header, h.shape.size() * 8));
+    store_le(out.data() + 60, crc, 4);
+    return out;
+}
+
+/// Parse and validate the header of a mapped file.
+inline result<tka_header> tka_decode_header(std::span<const uint8_t> file) {
+    if (file.size() < tka_fixed_header || std::memcmp(file.data(), tka_magic, 4) != 0) {
+        return fail(takum_error::Kind::DomainError, "mapped_array: not a takum array file");
+    }
+    const uint8_t* p = file.data();
+    if (p[4] != tka_version) return fail(takum_error::Kind::DomainError, "mapped_array: unsupported version");
+    tka_header h;
+    h.byte_order = p[5];
+    h.width = load_le(p + 6, 2);
+    h.element_bytes = load_le(p + 8, 4);
+    const size_t rank = load_le(p + 12, 4);
+    h.count = load_le(p + 16, 8);
+    h.data_offset = load_le(p + 24, 8);
+    h.index_offset = load_le(p + 32, 8);
+    h.block_size = load_le(p + 40, 8);
+    h.block_count = load_le(p + 48, 8);
+    if (rank > 64 || file.size() < tka_fixed_header + rank * 8) {
+        return fail(takum_error::Kind::DomainError, "mapped_array: truncated header");
+    }
+    uint32_t crc = crc32(0, file.first(60));
+    crc = crc32(crc, file.subspan(tka_fixed_header, rank * 8));
+    if (crc != load_le(p + 60, 4)) return fail(takum_error::Kind::DomainError, "mapped_array: header checksum mismatch");
+    h.shape.resize(rank);
+    for (size_t d = 0; d < rank; ++d) h.shape[d] = load_le(p + tka_fixed_header + d * 8, 8);
+
+    const uint64_t elements = std::accumulate(h.shape.begin(), h.shape.end(), uint64_t{1}, std::multiplies<>());
+    if ((h.byte_order != 1 && h.byte_order != 2) || h.data_offset % tka_alignment != 0 ||
+        h.data_offset < tka_fixed_header + rank * 8 || elements != h.count || h.element_bytes == 0) {
+        return fail(takum_error::Kind::DomainError, "mapped_array: malformed header");
+    }
+    if (h.data_offset > file.size() || (file.size() - h.data_offset) / h.element_bytes < h.count) {
+        return fail(takum_error::Kind::DomainError, "mapped_array: truncated data");
+    }
+    if (h.block_size != 0) {
+        const uint64_t entry = 2 * h.element_bytes + 8;
+        if (h.block_count != (h.count + h.block_size - 1) / h.block_size || h.index_offset > file.size() ||
+            (file.size() - h.index_offset) / entry < h.block_count) {
+            return fail(takum_error::Kind::DomainError, "mapped_array: malformed block index");
+        }
+    }
+    return h;
+}
+
+} // namespace internal
+
+/**
+ * @brief Read-only takum<N> array backed by a memory-mapped `.tka` file.
+ */
+template <size_t N>
+class mapped_array {
+    static_assert(std::is_trivially_copyable_v<takum<N>> && std::is_standard_layout_v<takum<N>>,
+                  "mapped_array: takum<N> must be trivially copyable");
+
+public:
+    mapped_array() = default;
+
+    /**
+     * @brief Map @p path.
+     *
+     * Fails with DomainError if the file is missing, malformed, or holds a
+     * width other than N.
+     */
+    static result<mapped_array> open(const std::string& path) {
+        mapped_array out;
+        if (!out.map_.open(path)) return internal::fail(takum_error::Kind::DomainError, "mapped_array: cannot open file");
+        const auto file = out.map_.bytes();
+        auto h = internal::tka_decode_header(file);
+        if (!h) return internal::error_of(h);
+        if (h->width != N || h->element_bytes != sizeof(takum<N>)) {
+            return internal::fail(takum_error::Kind::DomainError, "mapped_array: file width does not match N");
+        }
+        out.header_ = std::move(*h);
+        const size_t data_bytes = out.header_.count * sizeof(takum<N>);
+        const size_t index_bytes = out.header_.block_count * (2 * sizeof(takum<N>) + 8);
+
+        if (out.header_.byte_order == internal::native_byte_order()) {
+            out.data_ = reinterpret_cast<const takum<N>*>(file.data() + out.header_.data_offset);
+            if (out.header_.block_size) out.index_ = file.data() + out.header_.index_offset;
+        } else {
+            // Foreign byte order: swap into owned storage.
+            out.owned_.resize(data_bytes + index_bytes + alignof(takum<N>));
+            uint8_t* dst = out.owned_aligned();
+            std::memcpy(dst, file.data() + out.header_.data_offset, data_bytes);
+            internal::byteswap_units(dst, data_bytes, internal::tka_swap_unit<N>);
+            out.data_ = reinterpret_cast<const takum<N>*>(dst);
+            if (out.header_.block_size) {
+                uint8_t* idx = dst + data_bytes;
+                const size_t entry = 2 * sizeof(takum<N>) + 8;
+                std::memcpy(idx, file.data() + out.header_.index_offset, index_bytes);
+                for (size_t b = 0; b < out.header_.block_count; ++b) {
+                    internal::byteswap_units(idx + b * entry, 2 * sizeof(takum<N>), internal::tka_swap_unit<N>);
+                    internal::byteswap_units(idx + b * entry + 2 * sizeof(takum<N>), 8, 8);
+                }
+                out.index_ = idx;
+            }
+        }
+        return out;
+    }
+
+    /// @brief All elements, viewed in place over the mapping when zero_copy().
+    std::span<const takum<N>> values() const noexcept { return {data_, static_cast<size_t>(header_.count)}; }
+    /// @brief Element @p i.
+    const takum<N>& operator[](size_t i) const noexcept { return data_[i]; }
+    /// @brief Number of elements.
+    size_t size() const noexcept { return static_cast<size_t>(header_.count); }
+    /// @brief Array shape (product equals size()).
+    std::span<const uint64_t> shape() const noexcept { return header_.shape; }
+    /// @brief True when values() points into the OS file mapping (no copy was made).
+    bool zero_copy() const noexcept { return owned_.empty() && internal::file_map::is_os_mapping(); }
+
+    /// @brief True if the file carries a block index.
+    bool has_block_index() const noexcept { return header_.block_size != 0; }
+    /// @brief Elements per index block (0 without an index).
+    size_t block_size() const noexcept { return static_cast<size_t>(header_.block_size); }
+    /// @brief Number of index blocks.
+    size_t block_count() const noexcept { return static_cast<size_t>(header_.block_count); }
+
+    /// @brief Statistics of index block @p b (requires has_block_index()).
+    block_summary<N> block(size_t b) const noexcept {
+        block_summary<N> s;
+        const uint8_t* e = index_ + b * (2 * sizeof(takum<N>) + 8);
+        std::memcpy(&s.min, e, sizeof(takum<N>));
+        std::memcpy(&s.max, e + sizeof(takum<N>), sizeof(takum<N>));
+        std::memcpy(&s.nar_count, e + 2 * sizeof(takum<N>), 8);
+        return s;
+    }
+
+private:
+    uint8_t* owned_aligned() noexcept {
+        const auto addr = reinterpret_cast<uintptr_t>(owned_.data());
+        return owned_.data() + (alignof(takum<N>) - addr % alignof(takum<N>)) % alignof(takum<N>);
+    }
+
+    internal::file_map map_;
+    internal::tka_header header_;
+    std::vector<uint8_t> owned_;
+    const takum<N>* data_ = nullptr;
+    const uint8_t* index_ = nullptr;
+};
+
+/**
+ * @brief Streaming writer for `.tka` files.
+ *
+ * Elements are appended in native byte order; `finish()` writes the block
+ * index and the final header. A writer destroyed without `finish()` still
+ * finalises the file (errors are then silently dropped).
+ */
+template <size_t N>
+class mapped_array_writer {
+public:
+    mapped_array_writer() = default;
+    mapped_array_writer(const mapped_array_writer&) = delete;
+    mapped_array_writer& operator=(const mapped_array_writer&) = delete;
+    mapped_array_writer(mapped_array_writer&& other) noexcept { swap(other); }
+    mapped_array_writer& operator=(mapped_array_writer&& other) noexcept {
+        if (this != &other) {
+            close_silently();
+            swap(other);
+        }
+        return *this;
+    }
+    ~mapped_array_writer() { close_silently(); }
+
+    /**
+     * @brief Create (truncate) @p path.
+     *
+     * @param shape Final array shape; empty means a 1-D array of whatever was appended
+     * @param block_size Elements per block-index entry; 0 disables the index
+     */
+    static result<mapped_array_writer> create(const std::string& path, std::span<const uint64_t> shape = {},
+                                              size_t block_size = 4096) {
+        mapped_array_writer w;
+        w.file_ = std::fopen(path.c_str(), "wb");
+        if (!w.file_) return internal::fail(takum_error::Kind::DomainError, "mapped_array_writer: cannot create file");
+        w.header_.byte_order = internal::native_byte_order();
+        w.header_.width = N;
+        w.header_.element_bytes = sizeof(takum<N>);
+        w.header_.shape.assign(shape.begin(), shape.end());
+        w.header_.block_size = block_size;
+        w.header_.data_offset = internal::tka_data_offset(shape.empty() ? 1 : shape.size());
+        // Placeholder header; rewritten by finish().
+        const std::vector<uint8_t> zeros(w.header_.data_offset, 0);
+        if (std::fwrite(zeros.data(), 1, zeros.size(), w.file_) != zeros.size()) {
+            return internal::fail(takum_error::Kind::DomainError, "mapped_array_writer: write failed");
+        }
+        return w;
+    }
+
+    /// @brief Append @p values; returns false on an I/O error.
+    [[nodiscard]] bool append(std::span<const takum<N>> values) {
+        if (!file_) return false;
+        if (header_.block_size) {
+            for (const auto& v : values) summarise(v);
+        }
+        header_.count += values.size();
+        return std::fwrite(values.data(), sizeof(takum<N>), values.size(), file_) == values.size();
+    }
+
+    /// @brief Append one value; returns false on an I/O error.
+    [[nodiscard]] bool append(const takum<N>& value) { return append(std::span<const takum<N>>(&value, 1)); }
+
+    /// @brief Elements appended so far.
+    size_t size() const noexcept { return static_cast<size_t>(header_.count); }
+
+    /**
+     * @brief Write the block index and final header and close the file.
+     * @return Element count, or DomainError on I/O failure or if the shape
+     *         given to create() does not match the number of elements
+     */
+    result<size_t> finish() {
+        if (!file_) return internal::fail(takum_error::Kind::DomainError, "mapped_array_writer: not open");
+        if (header_.shape.empty()) header_.shape = {header_.count};
+        const uint64_t elements =
+            std::accumulate(header_.shape.begin(), header_.shape.end(), uint64_t{1}, std::multiplies<>());
+        bool ok = elements == header_.count;
+
+        if (header_.block_size) {
+            if (in_block_) index_.push_back(current_);
+            header_.block_count = index_.size();
+            header_.index_offset = header_.data_offset + header_.count * sizeof(takum<N>);
+            for (const auto& s : index_) {
+                ok = ok && std::fwrite(&s.min, sizeof(takum<N>), 1, file_) == 1;
+                ok = ok && std::fwrite(&s.max, sizeof(takum<N>), 1, file_) == 1;
+                ok = ok && std::fwrite(&s.nar_count, 8, 1, file_) == 1;
+            }
+        }
+        const auto head = internal::tka_encode_header(header_);
+        ok = ok && std::fseek(file_, 0, SEEK_SET) == 0;
+        ok = ok && std::fwrite(head.data(), 1, head.size(), file_) == head.size();
+        ok = (std::fclose(file_) == 0) && ok;
+        file_ = nullptr;
+        if (!ok) return internal::fail(takum_error::Kind::DomainError, "mapped_array_writer: finish failed");
+        return static_cast<size_t>(header_.count);
+    }
+
+private:
+    // Block extremes go by value: operator< compares the sign-magnitude
+    // patterns as signed integers and misorders negatives. Multi-word
+    // patterns are not monotone in value, so those compare decoded.
+    static bool value_less(const takum<N>& a, const takum<N>& b) noexcept {
+        if constexpr (N <= 64) {
+            return internal::order_key(a) < internal::order_key(b);
+        } else {
+            return a.to_double() < b.to_double();
+        }
+    }
+
+    void summarise(const takum<N>& v) {
+        if (!in_block_) {
+            current_ = {};
+            in_block_ = true;
+        }
+        if (v.is_nar()) {
+            ++current_.nar_count;
+        } else {
+            if (current_.min.is_nar() || value_less(v, current_.min)) current_.min = v;
+            if (current_.max.is_nar() || value_less(current_.max, v)) current_.max = v;
+        }
+        if (++in_current_ == header_.block_size) {
+            index_.push_back(current_);
+            in_block_ = false;
+            in_current_ = 0;
+        }
+    }
+
+    void close_silently() noexcept {
+        if (file_) (void)finish();
+    }
+
+    void swap(mapped_array_writer& other) noexcept {
+        std::swap(file_, other.file_);
+        std::swap(header_, other.header_);
+        std::swap(index_, other.index_);
+        std::swap(current_, other.current_);
+        std::swap(in_block_, other.in_block_);
+        std::swap(in_current_, other.in_current_);
+    }
+
+    std::FILE* file_ = nullptr;
+    internal::tka_header header_;
+    std::vector<block_summary<N>> index_;
+    block_summary<N> current_;
+    bool in_block_ = false;
+    uint64_t in_current_ = 0;
+};
+
+} // namespace takum
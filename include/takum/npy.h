@@ -0,0 +1,585 @@
+/**
+ * @file npy.h
+ * @brief NumPy `.npy` / `.npz` reader and writer for takum arrays.
+ *
+ * **Writing:** `save_npy` stores raw takum patterns in the smallest unsigned
+ * integer type that holds N bits (u1, u2, u4 or u8, little-endian). With
+ * `npy_layout::structured` (the default) the dtype is a one-field record named
+ * after the format, e.g. `[('takum24', '<u4')]`, so the width travels with
+ * the file and NumPy users see `arr['takum24']` as the pattern array;
+ * `npy_layout::raw` writes a plain `'<u4'` array. `save_npz` bundles several
+ * arrays in an uncompressed (stored) zip, as `numpy.savez` does.
+ *
+ * **Reading:** `load_npy` / `load_npz` accept
+ * - takum structured dtypes (the field name must match N),
+ * - raw unsigned pattern arrays (`u1`/`u2`/`u4`/`u8`, either byte order),
+ * - `f4` / `f8` arrays, converted with the parallel batch encoder.
+ *
+ * When the stored element type is exactly `takum<N>`'s storage in native byte
+ * order (e.g. `<u4` for takum32 on little-endian hosts) and suitably aligned,
+ * the returned `npy_array` views the memory-mapped file without copying.
+ *
+ * Fortran-ordered arrays with more than one dimension and compressed
+ * (`savez_compressed`) archives are rejected with DomainError.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/batch.h"
+#include "takum/result.h"
+#include "takum/internal/byte_io.h"
+#include "takum/internal/checksum.h"
+#include "takum/internal/file_map.h"
+
+namespace takum::io {
+
+template <size_t N>
+class npy_array;
+
+namespace internal {
+using namespace ::takum::internal;
+
+template <size_t N>
+result<npy_array<N>> load_npy_bytes(file_map&& map, std::span<const uint8_t> npy);
+} // namespace internal
+
+/// @brief dtype written by save_npy / save_npz.
+enum class npy_layout {
+    structured, ///< `[('takumN', '<uK')]` record dtype carrying the width
+    raw         ///< Plain `'<uK'` pattern array
+};
+
+/**
+ * @brief A loaded array: shape plus takum<N> values (mapped or owned).
+ */
+template <size_t N>
+class npy_array {
+public:
+    /// @brief Elements in C order.
+    std::span<const takum<N>> values() const noexcept {
+        return mapped_ ? std::span<const takum<N>>(mapped_, count_) : std::span<const takum<N>>(owned_);
+    }
+    /// @brief Element @p i.
+    const takum<N>& operator[](size_t i) const noexcept { return values()[i]; }
+    /// @brief Number of elements.
+    size_t size() const noexcept { return count_; }
+    /// @brief Array shape (empty for a 0-d array).
+    std::span<const uint64_t> shape() const noexcept { return shape_; }
+    /// @brief True when values() points into the memory-mapped file.
+    bool zero_copy() const noexcept { return mapped_ != nullptr && internal::file_map::is_os_mapping(); }
+
+private:
+    template <size_t M>
+    friend result<npy_array<M>> internal::load_npy_bytes(internal::file_map&&, std::span<const uint8_t>);
+
+    internal::file_map map_;
+    const takum<N>* mapped_ = nullptr;
+    std::vector<takum<N>> owned_;
+    std::vector<uint64_t> shape_;
+    size_t count_ = 0;
+};
+
+/// @brief One array of an .npz archive for save_npz.
+template <size_t N>
+struct npz_entry {
+    std::string name;                ///< Array name (".npy" is appended in the archive)
+    std::span<const takum<N>> values; ///< Elements in C order
+    std::vector<uint64_t> shape = {}; ///< Shape; empty means 1-D
+};
+
+namespace internal {
+
+inline constexpr uint8_t npy_magic[6] = {0x93, 'N', 'U', 'M', 'P', 'Y'};
+
+/// Bytes per stored pattern for width N.
+inline constexpr size_t npy_pattern_bytes(size_t n) noexcept {
+    return n <= 8 ? 1 : n <= 16 ? 2 : n <= 32 ? 4 : 8;
+}
+
+/// Element kinds load_npy understands.
+enum class npy_kind { pattern, float32, float64 };
+
+/// Parsed .npy preamble.
+struct npy_header {
+    npy_kind kind = npy_kind::pattern;
+    size_t item_bytes = 0;
+    bool little_endian = true;
+    size_t takum_width = 0; ///< From a structured 'takumN' field; 0 for raw arrays
+    bool fortran_order = false;
+    std::vector<uint64_t> shape;
+    size_t data_offset = 0; ///< From the start of the .npy bytes
+    size_t count = 0;
+};
+
+/// Build the complete preamble (magic, version, length, padded dict).
+inline std::vector<uint8_t> npy_preamble(const std::string& descr, std::span<const uint64_t> shape) {
+    std::string dict = "{'descr': " + descr + ", 'fortran_order': False, 'shape': (";
+    for (size_t d = 0; d < shape.size(); ++d) {
+        dict += std::to_string(shape[d]);
+        if (shape.size() == 1 || d + 1 < shape.size()) dict += ",";
+        if (d + 1 < shape.size()) dict += " ";
+    }
+    dict += "), }";
+    // Pad with spaces so the data starts on a 64-byte boundary; the dict ends in '\n'.
+    const bool v2 = dict.size() + 1 + 10 > 65535;
+    const size_t fixed = v2 ? 12 : 10;
+    const size_t total = (fixed + dict.size() + 1 + 63) / 64 * 64;
+    dict.append(total - fixed - dict.size() - 1, ' ');
+    dict += '\n';
+
+    std::vector<uint8_t> out(npy_magic, npy_magic + 6);
+    out.push_back(v2 ? 2 : 1);
+    out.push_back(0);
+    append_le(out, dict.size(), v2 ? 4 : 2);
+    out.insert(out.end(), dict.begin(), dict.end());
+    return out;
+}
+
+/// Parse a dtype string such as '<u4', '|u1' or '>f8'.
+inline bool npy_parse_typestr(std::string_view t, npy_header& h) {
+    if (t.size() < 3) return false;
+    const char order = t[0];
+    if (order != '<' && order != '>' && order != '|' && order != '=') return false;
+    const char kind = t[1];
+    size_t bytes = 0;
+    for (char c : t.substr(2)) {
+        if (c < '0' || c > '9') return false;
+        bytes = bytes * 10 + static_cast<size_t>(c - '0');
+    }
+    h.item_bytes = bytes;
+    h.little_endian = order == '<' || (order != '>' && std::endian::native == std::endian::little);
+    if (kind == 'u' && (bytes == 1 || bytes == 2 || bytes == 4 || bytes == 8)) {
+        h.kind = npy_kind::pattern;
+    } else if (kind == 'f' && bytes == 4) {
+        h.kind = npy_kind::float32;
+    } else if (kind == 'f' && bytes == 8) {
+        h.kind = npy_kind::float64;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/// Next quoted string at or after @p pos (advances @p pos past it).
+inline std::string_view npy_next_quoted(std::string_view s, size_t& pos) {
+    const size_t a = s.find_first_of("'\"", pos);
+    if (a == std::string_view::npos) return {};
+    const size_t b = s.find(s[a], a + 1);
+    if (b == std::string_view::npos) return {};
+    pos = b + 1;
+    return s.substr(a + 1, b - a - 1);
+}
+
+/// Parse the .npy preamble of @p bytes.
+inline result<npy_header> npy_parse(std::span<const uint8_t> bytes) {
+    auto bad = [] { return fail(takum_error::Kind::DomainError, "npy: malformed header"); };
+    if (bytes.size() < 10 || std::memcmp(bytes.data(), npy_magic, 6) != 0) {
+        return fail(takum_error::Kind::DomainError, "npy: not a .npy file");
+    }
+    const uint8_t major = bytes[6];
+    if (major < 1 || major > 3) return fail(takum_error::Kind::DomainError, "npy: unsupported format version");
+    const size_t len_bytes = major == 1 ? 2 : 4;
+    if (bytes.size() < 8 + len_bytes) return bad();
+    const size_t dict_len = load_le(bytes.data() + 8, len_bytes);
+    npy_header h;
+    h.data_offset = 8 + len_bytes + dict_len;
+    if (bytes.size() < h.data_offset) return bad();
+    const std::string_view dict(reinterpret_cast<const char*>(bytes.data() + 8 + len_bytes), dict_len);
+
+    // 'descr': either '<u4' or [('takumN', '<u4')]
+    size_t pos = dict.find("'descr'");
+    if (pos == std::string_view::npos) return bad();
+    pos = dict.find(':', pos);
+    if (pos == std::string_view::npos) return bad();
+    const size_t value = dict.find_first_not_of(' ', pos + 1);
+    if (value == std::string_view::npos) return bad();
+    if (dict[value] == '[') {
+        const size_t close = dict.find(']', value);
+        if (close == std::string_view::npos) return bad();
+        const std::string_view fields = dict.substr(value, close - value);
+        size_t fp = 0;
+        const std::string_view name = npy_next_quoted(fields, fp);
+        const std::string_view type = npy_next_quoted(fields, fp);
+        size_t extra = fp;
+        if (!npy_next_quoted(fields, extra).empty()) {
+            return fail(takum_error::Kind::DomainError, "npy: only single-field takum records are supported");
+        }
+        if (name.size() < 6 || name.substr(0, 5) != "takum") {
+            return fail(takum_error::Kind::DomainError, "npy: record field is not a takum pattern");
+        }
+        for (char c : name.substr(5)) {
+            if (c < '0' || c > '9') return bad();
+            h.takum_width = h.takum_width * 10 + static_cast<size_t>(c - '0');
+        }
+        if (!npy_parse_typestr(type, h) || h.kind != npy_kind::pattern) return bad();
+    } else {
+        size_t vp = value;
+        if (!npy_parse_typestr(npy_next_quoted(dict, vp), h)) {
+            return fail(takum_error::Kind::DomainError, "npy: unsupported dtype");
+        }
+    }
+
+    pos = dict.find("'fortran_order'");
+    if (pos == std::string_view::npos) return bad();
+    const size_t flag = dict.find_first_not_of(' ', dict.find(':', pos) + 1);
+    if (flag == std::string_view::npos) return bad();
+    h.fortran_order = dict[flag] == 'T';
+
+    pos = dict.find("'shape'");
+    if (pos == std::string_view::npos) return bad();
+    const size_t open = dict.find('(', pos);
+    const size_t close = dict.find(')', open);
+    if (open == std::string_view::npos || close == std::string_view::npos) return bad();
+    uint64_t dim = 0;
+    bool in_number = false;
+    for (char c : dict.substr(open + 1, close - open - 1)) {
+        if (c >= '0' && c <= '9') {
+            dim = dim * 10 + static_cast<uint64_t>(c - '0');
+            in_number = true;
+        } else if (c == ',') {
+            if (!in_number) return bad();
+            h.shape.push_back(dim);
+            dim = 0;
+            in_number = false;
+        } else if (c != ' ' && c != 'L') {
+            return bad();
+        }
+    }
+    if (in_number) h.shape.push_back(dim);
+    h.count = std::accumulate(h.shape.begin(), h.shape.end(), size_t{1}, std::multiplies<>());
+    if (h.fortran_order && h.shape.size() > 1) {
+        return fail(takum_error::Kind::DomainError, "npy: Fortran-ordered arrays are not supported");
+    }
+    if ((bytes.size() - h.data_offset) / h.item_bytes < h.count) {
+        return fail(takum_error::Kind::DomainError, "npy: truncated data");
+    }
+    return h;
+}
+
+/// Serialise a complete .npy image of @p values.
+template <size_t N>
+inline std::vector<uint8_t> npy_image(std::span<const takum<N>> values, std::span<const uint64_t> shape, npy_layout layout) {
+    constexpr size_t item = npy_pattern_bytes(N);
+    const std::string type = std::string(item == 1 ? "'|u" : "'<u") + std::to_string(item) + "'";
+    const std::string descr = layout == npy_layout::structured
+        ? "[('takum" + std::to_string(N) + "', " + type + ")]"
+        : type;
+    const uint64_t flat[1] = {values.size()};
+    auto out = npy_preamble(descr, shape.empty() ? std::span<const uint64_t>(flat) : shape);
+    const size_t at = out.size();
+    out.resize(at + values.size() * item);
+    if constexpr (item == sizeof(takum<N>) && std::endian::native == std::endian::little) {
+        if (!values.empty()) std::memcpy(out.data() + at, values.data(), values.size() * item);
+    } else {
+        for (size_t i = 0; i < values.size(); ++i) {
+            store_le(out.data() + at + i * item, static_cast<uint64_t>(values[i].storage), item);
+        }
+    }
+    return out;
+}
+
+inline bool write_file(const std::string& path, std::span<const uint8_t> bytes) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+}
+
+/// Location of one stored member of a zip archive.
+struct zip_member {
+    std::string name;
+    uint64_t data_offset = 0;
+    uint64_t size = 0;
+    uint16_t method = 0;
+};
+
+/// List the members of a zip archive (zip64 aware).
+inline result<std::vector<zip_member>> zip_members(std::span<const uint8_t> z) {
+    auto bad = [] { return fail(takum_error::Kind::DomainError, "npz: malformed zip archive"); };
+    // [at, at + len) lies inside the archive, written so that no sum can wrap.
+    auto fits = [&](uint64_t at, uint64_t len) { return len <= z.size() && at <= z.size() - len; };
+    if (z.size() < 22) return bad();
+    size_t eocd = z.size() - 22;
+    const size_t stop = z.size() > 22 + 65535 ? z.size() - 22 - 65535 : 0;
+    while (load_le(z.data() + eocd, 4) != 0x06054b50) {
+        if (eocd == stop) return bad();
+        --eocd;
+    }
+    uint64_t entries = load_le(z.data() + eocd + 10, 2);
+    uint64_t cd = load_le(z.data() + eocd + 16, 4);
+    if ((entries == 0xFFFF || cd == 0xFFFFFFFF) && eocd >= 20 && load_le(z.data() + eocd - 20, 4) == 0x07064b50) {
+        const uint64_t z64 = load_le(z.data() + eocd - 20 + 8, 8);
+        if (!fits(z64, 56) || load_le(z.data() + z64, 4) != 0x06064b50) return bad();
+        entries = load_le(z.data() + z64 + 32, 8);
+        cd = load_le(z.data() + z64 + 48, 8);
+    }
+
+    std::vector<zip_member> out;
+    uint64_t p = cd;
+    for (uint64_t e = 0; e < entries; ++e) {
+        if (!fits(p, 46) || load_le(z.data() + p, 4) != 0x02014b50) return bad();
+        zip_member m;
+        m.method = static_cast<uint16_t>(load_le(z.data() + p + 10, 2));
+        uint64_t csize = load_le(z.data() + p + 20, 4);
+        uint64_t usize = load_le(z.data() + p + 24, 4);
+        const size_t name_len = load_le(z.data() + p + 28, 2);
+        const size_t extra_len = load_le(z.data() + p + 30, 2);
+        const size_t comment_len = load_le(z.data() + p + 32, 2);
+        uint64_t local = load_le(z.data() + p + 42, 4);
+        if (!fits(p, 46 + name_len + extra_len)) return bad();
+        m.name.assign(reinterpret_cast<const char*>(z.data() + p + 46), name_len);
+        // Zip64 extended information: present fields follow the order usize, csize, offset.
+        const uint64_t extra_end = p + 46 + name_len + extra_len;
+        for (uint64_t x = p + 46 + name_len; extra_end - x >= 4;) {
+            const uint64_t id = load_le(z.data() + x, 2);
+            const uint64_t len = load_le(z.data() + x + 2, 2);
+            if (len > extra_end - x - 4) return bad();
+            if (id == 0x0001) {
+                uint64_t f = x + 4;
+                const uint64_t field_end = f + len;
+                auto field = [&](uint64_t& v) {
+                    if (field_end - f < 8) return false;
+                    v = load_le(z.data() + f, 8);
+                    f += 8;
+                    return true;
+                };
+                if (usize == 0xFFFFFFFF && !field(usize)) return bad();
+                if (csize == 0xFFFFFFFF && !field(csize)) return bad();
+                if (local == 0xFFFFFFFF && !field(local)) return bad();
+            }
+            x += 4 + len;
+        }
+        if (!fits(local, 30) || load_le(z.data() + local, 4) != 0x04034b50) return bad();
+        const uint64_t header = 30 + load_le(z.data() + local + 26, 2) + load_le(z.data() + local + 28, 2);
+        m.size = m.method == 0 ? usize : csize;
+        if (!fits(local, header) || !fits(local + header, m.size)) return bad();
+        m.data_offset = local + header;
+        out.push_back(std::move(m));
+        p += 46 + name_len + extra_len + comment_len;
+    }
+    return out;
+}
+
+/// True when no pattern in @p p[0, n) has bits set above N (always so when N fills the word).
+template <size_t N>
+inline bool patterns_fit(const takum<N>* p, size_t n) noexcept {
+    using storage_t = typename takum<N>::storage_t;
+    if constexpr (N == 8 * sizeof(storage_t)) {
+        return true;
+    } else {
+        constexpr auto high = static_cast<storage_t>(~low_mask(N));
+        storage_t any = 0;
+        for (size_t i = 0; i < n; ++i) any |= p[i].storage & high;
+        return any == 0;
+    }
+}
+
+/**
+ * @brief Build an npy_array from the .npy bytes @p npy inside mapping @p map.
+ *
+ * Shared by load_npy (whole file) and load_npz (one stored member).
+ */
+template <size_t N>
+result<npy_array<N>> load_npy_bytes(file_map&& map, std::span<const uint8_t> npy) {
+    static_assert(N <= 64, "npy: only single-word takum widths are supported");
+    auto h = npy_parse(npy);
+    if (!h) return error_of(h);
+    if (h->takum_width != 0 && h->takum_width != N) {
+        return fail(takum_error::Kind::DomainError, "npy: file holds a different takum width");
+    }
+    if (h->kind == npy_kind::pattern && h->item_bytes != npy_pattern_bytes(N)) {
+        return fail(takum_error::Kind::DomainError, "npy: pattern item size does not match the takum width");
+    }
+
+    npy_array<N> out;
+    out.shape_ = h->shape;
+    out.count_ = h->count;
+    const uint8_t* data = npy.data() + h->data_offset;
+    const bool native = h->little_endian == (std::endian::native == std::endian::little) || h->item_bytes == 1;
+
+    if (h->kind == npy_kind::pattern) {
+        // Mapped patterns with stray bits above N take the masking copy below.
+        if (h->item_bytes == sizeof(takum<N>) && native &&
+            reinterpret_cast<uintptr_t>(data) % alignof(takum<N>) == 0 &&
+            patterns_fit<N>(reinterpret_cast<const takum<N>*>(data), h->count)) {
+            out.mapped_ = reinterpret_cast<const takum<N>*>(data);
+            out.map_ = std::move(map);
+            return out;
+        }
+        out.owned_.resize(h->count);
+        using storage_t = typename takum<N>::storage_t;
+        for (size_t i = 0; i < h->count; ++i) {
+            uint64_t v = load_le(data + i * h->item_bytes, h->item_bytes);
+            if (!h->little_endian && h->item_bytes > 1) {
+                v = std::byteswap(v) >> (64 - 8 * h->item_bytes);
+            }
+            out.owned_[i] = takum<N>::from_raw_bits(static_cast<storage_t>(v & low_mask(N)));
+        }
+        return out;
+    }
+
+    // Floating point: gather into native order, then encode in parallel.
+    out.owned_.resize(h->count);
+    auto convert = [&](auto tag) {
+        using Real = decltype(tag);
+        std::vector<Real> host(h->count);
+        if (h->count) std::memcpy(host.data(), data, h->count * sizeof(Real));
+        if (!native) byteswap_units(reinterpret_cast<uint8_t*>(host.data()), host.size() * sizeof(Real), sizeof(Real));
+        encode_batch<N, Real>(std::span<const Real>(host), std::span<takum<N>>(out.owned_));
+    };
+    if (h->kind == npy_kind::float32) convert(float{});
+    else convert(double{});
+    return out;
+}
+
+} // namespace internal
+
+/**
+ * @brief Write @p values as a .npy file.
+ *
+ * @param shape Array shape in C order (empty means 1-D); its product must equal values.size()
+ * @return Bytes written, or DomainError on shape mismatch or I/O failure
+ */
+template <size_t N>
+inline result<size_t> save_npy(const std::string& path, std::span<const takum<N>> values,
+                               std::span<const uint64_t> shape = {}, npy_layout layout = npy_layout::structured) {
+    static_assert(N <= 64, "npy: only single-word takum widths are supported");
+    if (!shape.empty() && std::accumulate(shape.begin(), shape.end(), uint64_t{1}, std::multiplies<>()) != values.size()) {
+        return internal::fail(takum_error::Kind::DomainError, "npy: shape does not match element count");
+    }
+    const auto image = internal::npy_image<N>(values, shape, layout);
+    if (!internal::write_file(path, image)) return internal::fail(takum_error::Kind::DomainError, "npy: write failed");
+    return image.size();
+}
+
+/**
+ * @brief Load a .npy file as takum<N> (zero-copy when the dtype matches the storage).
+ */
+template <size_t N>
+inline result<npy_array<N>> load_npy(const std::string& path) {
+    internal::file_map map;
+    if (!map.open(path)) return internal::fail(takum_error::Kind::DomainError, "npy: cannot open file");
+    const auto bytes = map.bytes();
+    return internal::load_npy_bytes<N>(std::move(map), bytes);
+}
+
+/**
+ * @brief Write several arrays into an uncompressed .npz archive.
+ *
+ * @return Bytes written, or DomainError on shape mismatch, I/O failure or
+ *         an archive exceeding 4 GiB (zip64 output is not implemented)
+ */
+template <size_t N>
+inline result<size_t> save_npz(const std::string& path, std::span<const npz_entry<N>> entries,
+                               npy_layout layout = npy_layout::structured) {
+    using internal::append_le;
+    std::vector<uint8_t> zip, central;
+    for (const auto& e : entries) {
+        if (!e.shape.empty() &&
+            std::accumulate(e.shape.begin(), e.shape.end(), uint64_t{1}, std::multiplies<>()) != e.values.size()) {
+            return internal::fail(takum_error::Kind::DomainError, "npz: shape does not match element count");
+        }
+        const auto image = internal::npy_image<N>(e.values, e.shape, layout);
+        const std::string name = e.name + ".npy";
+        const uint32_t crc = internal::crc32(0, image);
+        const uint64_t local = zip.size();
+        if (local + image.size() + 30 + name.size() > 0xFFFFFFFFull) {
+            return internal::fail(takum_error::Kind::Overflow, "npz: archives over 4 GiB are not supported");
+        }
+        // Local file header: version 2.0, stored, DOS date 1980-01-01.
+        append_le(zip, 0x04034b50, 4);
+        append_le(zip, 20, 2);
+        append_le(zip, 0, 2);
+        append_le(zip, 0, 2);
+        append_le(zip, 0, 2);
+        append_le(zip, 0x21, 2);
+        append_le(zip, crc, 4);
+        append_le(zip, image.size(), 4);
+        append_le(zip, image.size(), 4);
+        append_le(zip, name.size(), 2);
+        append_le(zip, 0, 2);
+        zip.insert(zip.end(), name.begin(), name.end());
+        zip.insert(zip.end(), image.begin(), image.end());
+
+        append_le(central, 0x02014b50, 4);
+        append_le(central, 20, 2);
+        append_le(central, 20, 2);
+        append_le(central, 0, 2);
+        append_le(central, 0, 2);
+        append_le(central, 0, 2);
+        append_le(central, 0x21, 2);
+        append_le(central, crc, 4);
+        append_le(central, image.size(), 4);
+        append_le(central, image.size(), 4);
+        append_le(central, name.size(), 2);
+        append_le(central, 0, 2);
+        append_le(central, 0, 2);
+        append_le(central, 0, 2);
+        append_le(central, 0, 2);
+        append_le(central, 0, 4);
+        append_le(central, local, 4);
+        central.insert(central.end(), name.begin(), name.end());
+    }
+    const uint64_t cd_offset = zip.size();
+    zip.insert(zip.end(), central.begin(), central.end());
+    append_le(zip, 0x06054b50, 4);
+    append_le(zip, 0, 2);
+    append_le(zip, 0, 2);
+    append_le(zip, entries.size(), 2);
+    append_le(zip, entries.size(), 2);
+    append_le(zip, central.size(), 4);
+    append_le(zip, cd_offset, 4);
+    append_le(zip, 0, 2);
+    if (!internal::write_file(path, zip)) return internal::fail(takum_error::Kind::DomainError, "npz: write failed");
+    return zip.size();
+}
+
+/**
+ * @brief Names of the arrays in an .npz archive (without the ".npy" suffix).
+ */
+inline result<std::vector<std::string>> list_npz(const std::string& path) {
+    internal::file_map map;
+    if (!map.open(path)) return internal::fail(takum_error::Kind::DomainError, "npz: cannot open file");
+    auto members = internal::zip_members(map.bytes());
+    if (!members) return internal::error_of(members);
+    std::vector<std::string> names;
+    for (const auto& m : *members) {
+        const bool npy = m.name.size() > 4 && m.name.compare(m.name.size() - 4, 4, ".npy") == 0;
+        names.push_back(npy ? m.name.substr(0, m.name.size() - 4) : m.name);
+    }
+    return names;
+}
+
+/**
+ * @brief Load array @p name from an .npz archive (zero-copy when possible).
+ */
+template <size_t N>
+inline result<npy_array<N>> load_npz(const std::string& path, std::string_view name) {
+    internal::file_map map;
+    if (!map.open(path)) return internal::fail(takum_error::Kind::DomainError, "npz: cannot open file");
+    const auto bytes = map.bytes();
+    auto members = internal::zip_members(bytes);
+    if (!members) return internal::error_of(members);
+    for (const auto& m : *members) {
+        if (m.name != name && m.name != std::string(name) + ".npy") continue;
+        if (m.method != 0) return internal::fail(takum_error::Kind::DomainError, "npz: compressed archives are not supported");
+        return internal::load_npy_bytes<N>(std::move(map), bytes.subspan(m.data_offset, m.size));
+    }
+    return internal::fail(takum_error::Kind::DomainError, "npz: no such array");
+}
+
+} // namespace takum::io
@@ -0,0 +1,355 @@
+/**
+ * @file numeric.h
+ * @brief Prefix sums and prefix products over spans of takum<N>.
+ *
+ * `inclusive_scan` / `exclusive_scan` write running sums and
+ * `inclusive_product_scan` / `exclusive_product_scan` running products of
+ * the first min(in.size(), out.size()) elements. @p out may alias @p in.
+ *
+ * Every scan uses the two-pass decomposition over fixed blocks of scan_block
+ * elements: the first pass totals each block, a short serial pass turns the
+ * totals into block offsets, and the second pass rescans each block from its
+ * offset and rounds every running value to takum<N> once. Both passes split
+ * across worker threads above TAKUM_PARALLEL_GRAIN elements (a single worker
+ * fuses them into one pass with the same arithmetic); the block boundaries do
+ * not move with the thread count, so neither do the results.
+ *
+ * Sums are carried in `double` for N <= 32 and internal::wide_float above,
+ * never re-rounded to N bits between steps the way a serial `acc = acc + x`
+ * loop is. scan_carry::compensated adds a Neumaier compensation term to the
+ * carry, which keeps the error of long sums near one rounding instead of
+ * letting it grow with the length.
+ *
+ * Products are sums of ℓ. For 12 <= N <= 32 the fixed-point ℓ of each pattern
+ * (elementwise.h) is summed in integers, so every prefix is exact until its
+ * single rounding (to nearest in ℓ, ties to even). Up to N = 64 the same holds
+ * with a 64-bit fraction (ell_fixed64); other widths sum 2·ln|x|. The sign is
+ * tracked as a parity, a zero makes every later product zero, and
+ * out-of-range products saturate like the encoder.
+ *
+ * A NaR makes every later output NaR and raises flag_nar, as the scalar
+ * operators do.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/elementwise.h"
+#include "takum/status_flags.h"
+#include "takum/internal/parallel.h"
+
+namespace takum {
+
+/// @brief How the running value of a scan is carried between elements.
+enum class scan_carry {
+    wide,        ///< Plain sum in the wide accumulator
+    compensated, ///< Neumaier-compensated sum
+};
+
+/// @brief Elements per block of the two-pass scans.
+inline constexpr size_t scan_block = 4096;
+
+namespace internal {
+
+/// @brief Running sum, optionally with Neumaier compensation.
+template <typename A, bool Compensated>
+struct scan_sum {
+    A sum = 0;
+    A comp = 0; ///< Lost low-order part of sum (Compensated only)
+
+    void add(A x) noexcept {
+        const A t = sum + x;
+        if constexpr (Compensated) comp += std::fabs(sum) >= std::fabs(x) ? (sum - t) + x : (x - t) + sum;
+        sum = t;
+    }
+
+    void add(const scan_sum& o) noexcept {
+        add(o.sum);
+        comp += o.comp;
+    }
+
+    A value() const noexcept { return sum + comp; }
+};
+
+/// @brief Scan step for sums; NaR decodes to NaN, which poisons the carry.
+template <size_t N, bool Compensated>
+struct sum_step {
+    using acc_t = wide_acc_t<N>;
+    using state = scan_sum<acc_t, Compensated>;
+
+    wide_decoder<N> dec;
+
+    acc_t load(const takum<N>& x) const noexcept { return dec(x); }
+
+    takum<N> emit(const state& s, unsigned& flags) const noexcept {
+        const acc_t v = s.value();
+        // A NaR input, not an invalid operation: only flag_nar, like operator+.
+        if (std::isnan(v)) TAKUM_UNLIKELY {
+            flags |= flag_nar;
+            return takum<N>::nar();
+        }
+        return encode_wide<N>(v);
+    }
+};
+
+/// @brief Fixed-point ℓ = whole + frac·2^-64, which holds the ℓ of every 33..64-bit pattern exactly.
+struct ell_fixed64 {
+    /// @brief Bound of the integer part, far beyond the ±255 range.
+    static constexpr int64_t limit = int64_t{1} << 62;
+
+    int64_t whole = 0;
+    uint64_t frac = 0;
+
+    void add(const ell_fixed64& o) noexcept {
+        const uint64_t f = frac + o.frac;
+        whole = std::clamp(whole + o.whole + (f < frac ? 1 : 0), -limit, limit);
+        frac = f;
+    }
+};
+
+/// @brief ell_fixed64 of a 33..64-bit pattern whose low N-1 bits are non-zero.
+template <size_t N>
+inline ell_fixed64 ell_fixed64_of(uint64_t bits) noexcept {
+    constexpr uint64_t low_mask = (uint64_t{1} << (N - 1)) - 1u;
+    const uint64_t low = bits & low_mask;
+    const uint64_t D = low >> (N - 2);
+    const uint64_t R = (low >> (N - 5)) & 7u;
+    const uint64_t r = D ? R : 7u - R;
+    const uint64_t p = N - 5 - r; // 21..59
+    const uint64_t c_bits = (low >> p) & ((uint64_t{1} << r) - 1u);
+    ell_fixed64 e;
+    e.whole = D ? static_cast<int64_t>((uint64_t{1} << r) - 1u + c_bits)
+                : static_cast<int64_t>(c_bits) - static_cast<int64_t>(uint64_t{2} << r) + 1;
+    e.frac = (low & ((uint64_t{1} << p) - 1u)) << (64 - p);
+    return e;
+}
+
+/**
+ * @brief Pattern for sign @p S and ℓ @p e, rounded to nearest in ℓ (ties to
+ * even) and saturated like pack_ell_fixed, whose 64-bit counterpart it is.
+ */
+template <size_t N>
+inline uint64_t pack_ell_fixed64(uint32_t S, ell_fixed64 e, unsigned& flags) noexcept {
+    // ±(255 - 2^-(N-12)), the largest magnitude: c = ±254 / -255 with the shortest mantissa.
+    constexpr uint64_t ulp_max = uint64_t{1} << (64 - (N - 12));
+    if (e.whole > 254 || (e.whole == 254 && e.frac > 0 - ulp_max)) TAKUM_UNLIKELY {
+        flags |= flag_overflow | flag_inexact;
+        e = {254, 0 - ulp_max};
+    } else if (e.whole < -255 || (e.whole == -255 && e.frac < ulp_max)) TAKUM_UNLIKELY {
+        flags |= flag_underflow | flag_inexact;
+        e = {-255, ulp_max};
+    }
+    const int64_t c = e.whole; // floor, as frac ≥ 0
+    const uint64_t D = c >= 0 ? 1u : 0u;
+    const uint64_t abs_c = static_cast<uint64_t>(c >= 0 ? c : -c);
+    const uint64_t r = static_cast<uint64_t>(std::bit_width(abs_c + D)) - 1u;
+    const uint64_t R = D ? r : 7u - r;
+    const uint64_t c_bits = static_cast<uint64_t>(D ? c - ((int64_t{1} << r) - 1) : c + (int64_t{2} << r) - 1);
+    const uint64_t p = N - 5 - r;
+    const uint64_t shift = 64 - p; // 5..52 dropped fraction bits
+    const uint64_t rest = e.frac & ((uint64_t{1} << shift) - 1u);
+    const uint64_t half = uint64_t{1} << (shift - 1);
+    const uint64_t truncated = (D << (N - 2)) | (R << (N - 5)) | (c_bits << p) | (e.frac >> shift);
+    // Ties to even pattern; a carry out of the mantissa correctly bumps the characteristic.
+    const uint64_t packed = truncated + ((rest > half || (rest == half && (truncated & 1u))) ? 1u : 0u);
+    flags |= rest != 0 ? flag_inexact : 0u;
+    return packed | (uint64_t{S} << (N - 1));
+}
+
+/// @brief Running product as Σℓ, sign parity and zero/NaR flags.
+template <size_t N, bool Compensated>
+struct product_state {
+    /// @brief Σℓ in fixed point up to 64 bits (integer where the ℓ kernel applies), wide float above.
+    using ell_t = std::conditional_t<uses_int_ell<N>, int64_t,
+                                     std::conditional_t<(N > 32 && N <= 64), ell_fixed64,
+                                                        scan_sum<wide_acc_t<N>, Compensated>>>;
+
+    /// @brief Bound of the integer carry: |Σℓ| < 2^30, far beyond the ±255 range.
+    static constexpr int64_t ell_limit = int64_t{1} << 62;
+
+    ell_t ell{};
+    uint32_t negative = 0;
+    uint32_t zero = 0;
+    uint32_t nar = 0;
+
+    void add(const product_state& o) noexcept {
+        if constexpr (uses_int_ell<N>) {
+            ell = std::clamp(ell + o.ell, -ell_limit, ell_limit);
+        } else {
+            ell.add(o.ell);
+        }
+        negative ^= o.negative;
+        zero |= o.zero;
+        nar |= o.nar;
+    }
+};
+
+/// @brief Scan step for products.
+template <size_t N, bool Compensated>
+struct product_step {
+    using state = product_state<N, Compensated>;
+
+    add_decoder<N> dec;
+
+    /// @brief State of the one-element product @p x.
+    state load(const takum<N>& x) const noexcept {
+        state s;
+        if constexpr (uses_int_ell<N>) {
+            // Branch-free: ell_fixed is harmless on the zero and NaR patterns,
+            // whose contribution is masked off.
+            constexpr uint32_t low_mask = (uint32_t{1} << (N - 1)) - 1u;
+            const uint32_t bits = x.storage;
+            const uint32_t special = (bits & low_mask) == 0 ? 1u : 0u;
+            const uint32_t sign = bits >> (N - 1);
+            const int64_t l = ell_fixed<N>(bits);
+            s.ell = special ? 0 : l;
+            s.negative = sign & (special ^ 1u);
+            s.zero = special & (sign ^ 1u);
+            s.nar = special & sign;
+        } else {
+            if (x.is_nar() || x.is_zero()) TAKUM_UNLIKELY {
+                (x.is_nar() ? s.nar : s.zero) = 1;
+                return s;
+            }
+            if constexpr (N > 32 && N <= 64) {
+                s.ell = ell_fixed64_of<N>(x.storage);
+            } else {
+                s.ell.add(2 * std::log(std::fabs(static_cast<wide_acc_t<N>>(dec(x)))));
+            }
+            s.negative = x.signbit() ? 1u : 0u;
+        }
+        return s;
+    }
+
+    takum<N> emit(const state& s, unsigned& flags) const noexcept {
+        if (s.nar) TAKUM_UNLIKELY return takum<N>::nar();
+        if (s.zero) TAKUM_UNLIKELY return takum<N>{};
+        if constexpr (uses_int_ell<N>) {
+            return takum<N>::from_raw_bits(pack_ell_fixed<N>(s.negative, s.ell, flags));
+        } else if constexpr (N > 32 && N <= 64) {
+            return takum<N>::from_raw_bits(pack_ell_fixed64<N>(s.negative, s.ell, flags));
+        } else {
+            return saturating_from_ell<N>(s.negative != 0, s.ell.value());
+        }
+    }
+};
+
+/**
+ * @brief Two-pass blocked scan of @p in into @p out with @p step.
+ *
+ * `Step::state` is the running value: `step.load(x)` gives the contribution
+ * of one element, `state.add(...)` folds in a contribution or a block total
+ * and `step.emit(state, flags)` rounds the running value to an output.
+ */
+template <bool Exclusive, size_t N, typename Step>
+inline void blocked_scan(std::span<const takum<N>> in, std::span<takum<N>> out, const Step& step) {
+    using state = typename Step::state;
+    const size_t n = std::min(in.size(), out.size());
+    if (n == 0) return;
+    const size_t blocks = (n + scan_block - 1) / scan_block;
+    const size_t grain = std::max<size_t>(1, TAKUM_PARALLEL_GRAIN / scan_block);
+
+    // Scan block b from @p s; @p total (if given) also sums the block alone.
+    auto scan_block_from = [&](size_t b, state s, state* total, unsigned& flags) {
+        const size_t end = std::min(n, (b + 1) * scan_block);
+        for (size_t i = b * scan_block; i < end; ++i) {
+            const auto item = step.load(in[i]); // read before out[i] is written (aliasing)
+            if constexpr (Exclusive) out[i] = step.emit(s, flags);
+            s.add(item);
+            if (total) total->add(item);
+            if constexpr (!Exclusive) out[i] = step.emit(s, flags);
+        }
+    };
+
+    if (worker_count(blocks, grain) == 1) {
+        // One pass: the same block totals and offsets as below, so the same
+        // outputs, without decoding every element twice.
+        unsigned flags = 0;
+        state offset{};
+        for (size_t b = 0; b < blocks; ++b) {
+            state total{};
+            scan_block_from(b, offset, &total, flags);
+            offset.add(total);
+        }
+        raise_status(flags);
+        return;
+    }
+
+    // offset[b] first holds the total of block b - 1 (the last block's total
+    // is never needed), then the running value at the start of block b.
+    std::vector<state> offset(blocks);
+    parallel_for(blocks - 1, [&](size_t b_begin, size_t b_end, size_t) {
+        for (size_t b = b_begin; b < b_end; ++b) {
+            state s{};
+            const size_t end = (b + 1) * scan_block;
+            for (size_t i = b * scan_block; i < end; ++i) s.add(step.load(in[i]));
+            offset[b + 1] = s;
+        }
+    }, grain);
+    for (size_t b = 1; b < blocks; ++b) {
+        state s = offset[b - 1];
+        s.add(offset[b]);
+        offset[b] = s;
+    }
+
+    parallel_for(blocks, [&](size_t b_begin, size_t b_end, size_t) {
+        unsigned flags = 0;
+        for (size_t b = b_begin; b < b_end; ++b) scan_block_from(b, offset[b], nullptr, flags);
+        raise_status(flags);
+    }, grain);
+}
+
+template <bool Exclusive, template <size_t, bool> class Step, size_t N>
+inline void dispatch_scan(std::span<const takum<N>> in, std::span<takum<N>> out, scan_carry carry) {
+    if (carry == scan_carry::compensated) {
+        blocked_scan<Exclusive, N>(in, out, Step<N, true>{});
+    } else {
+        blocked_scan<Exclusive, N>(in, out, Step<N, false>{});
+    }
+}
+
+} // namespace internal
+
+/// @brief `out[i] = in[0] + … + in[i]`.
+template <size_t N>
+inline void inclusive_scan(std::span<const takum<N>> in, std::span<takum<N>> out,
+                           scan_carry carry = scan_carry::wide) {
+    internal::dispatch_scan<false, internal::sum_step>(in, out, carry);
+}
+
+/// @brief `out[0] = 0`, `out[i] = in[0] + … + in[i - 1]`.
+template <size_t N>
+inline void exclusive_scan(std::span<const takum<N>> in, std::span<takum<N>> out,
+                           scan_carry carry = scan_carry::wide) {
+    internal::dispatch_scan<true, internal::sum_step>(in, out, carry);
+}
+
+/**
+ * @brief `out[i] = in[0] · … · in[i]`.
+ *
+ * @p carry only matters below 12 and above 64 bits, where ℓ is summed in
+ * floating point; the fixed-point ℓ carry is exact.
+ */
+template <size_t N>
+inline void inclusive_product_scan(std::span<const takum<N>> in, std::span<takum<N>> out,
+                                   scan_carry carry = scan_carry::wide) {
+    internal::dispatch_scan<false, internal::product_step>(in, out, carry);
+}
+
+/// @brief `out[0] = 1`, `out[i] = in[0] · … · in[i - 1]`.
+template <size_t N>
+inline void exclusive_product_scan(std::span<const takum<N>> in, std::span<takum<N>> out,
+                                   scan_carry carry = scan_carry::wide) {
+    internal::dispatch_scan<true, internal::product_step>(in, out, carry);
+}
+
+} // namespace takum
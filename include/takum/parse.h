@@ -0,0 +1,313 @@
+/**
+ * @file parse.h
+ * @brief Bulk decimal parsing of delimited text straight into takum<N>.
+ *
+ * `parse_many(text, out)` reads numbers separated by commas, spaces, tabs or
+ * line breaks (runs of delimiters count as one, so empty CSV fields are
+ * skipped) and writes the nearest takum<N> of each, as `from_chars` would.
+ *
+ * The per-token path follows fast_float: digits are consumed eight at a time
+ * with SWAR (one 64-bit load, one validity test and three multiplies per
+ * eight digits) into a 19-digit integer, and the value never passes through
+ * a `double`. For N ≤ 40 the takum's ℓ quantum is coarse enough that
+ * ℓ = 2 ln|v| evaluated in double precision rounds to the same pattern as the
+ * long double path unless it lands within the double's error of a rounding
+ * midpoint; those rare tokens, wider formats, overlong mantissas and the NaR
+ * spellings go through `from_chars`' own rounding, so the results are
+ * bit-identical to it.
+ *
+ * Large inputs are split at delimiter boundaries into one piece per worker.
+ * A first parallel pass counts tokens per piece, a prefix sum gives each
+ * piece its output offset, and a second pass parses the pieces in parallel
+ * (see internal/parallel.h; inline when TAKUM_ENABLE_THREADS=0).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/charconv.h"
+#include "takum/internal/parallel.h"
+
+namespace takum {
+
+/**
+ * @brief Outcome of parse_many().
+ *
+ * On success `ptr` is the end of the text and `ec` is empty. On failure `ptr`
+ * points at the start of the offending token, `count` values before it are
+ * valid, and `ec` is `invalid_argument` (not a number),
+ * `result_out_of_range` (beyond the takum range) or `value_too_large` (more
+ * tokens than `out` holds; `count == out.size()`).
+ */
+struct parse_many_result {
+    size_t count = 0;
+    const char* ptr = nullptr;
+    std::errc ec{};
+};
+
+namespace internal {
+
+/// Minimum text bytes per worker before parse_many() splits the input.
+inline constexpr size_t parse_grain_bytes = size_t{1} << 20;
+
+/// Field separators accepted by parse_many().
+constexpr bool is_parse_delimiter(char c) noexcept {
+    return c == ',' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+/// Eight text bytes as a little-endian word.
+inline uint64_t load8(const char* p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    if constexpr (std::endian::native == std::endian::big) v = std::byteswap(v);
+    return v;
+}
+
+/// True when all eight bytes of @p v are ASCII digits.
+constexpr bool is_eight_digits(uint64_t v) noexcept {
+    return ((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+/// Value of eight ASCII digits (first digit in the low byte).
+constexpr uint32_t parse_eight_digits(uint64_t v) noexcept {
+    constexpr uint64_t mask = 0x000000FF000000FF;
+    constexpr uint64_t mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+    constexpr uint64_t mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(v);
+}
+
+/**
+ * @brief Round digits × 10^exp10 (digits > 0) to a magnitude pattern in double precision.
+ *
+ * Returns false, leaving @p u unspecified, when ℓ falls within the double
+ * error bound of a rounding midpoint or of the range ends; the caller then
+ * uses magnitude_of_decimal().
+ */
+template <size_t N>
+inline bool magnitude_of_decimal_fast(uint64_t digits, int exp10, uint64_t& u) noexcept {
+    static_assert(N <= 40, "double-precision ℓ is only decisive for N <= 40");
+    const double log_digits = std::log(static_cast<double>(digits));
+    const double log_scale = exp10 * 2.302585092994045684;
+    const double ell = 2.0 * (log_digits + log_scale);
+
+    static const double min_ell = static_cast<double>(make_ell_range<N>().min) + 1e-6;
+    static const double max_ell = static_cast<double>(make_ell_range<N>().max) - 1e-6;
+    if (!(ell > min_ell && ell < max_ell)) return false;
+
+    int64_t c = static_cast<int64_t>(ell);
+    if (static_cast<double>(c) > ell) --c;
+    const bool D = c >= 0;
+    const uint32_t r = std::min<uint32_t>(
+        7u, static_cast<uint32_t>(std::bit_width(static_cast<uint64_t>(D ? c + 1 : -c))) - 1u);
+    const uint32_t R = D ? r : 7u - r;
+    const size_t p = N - 5 - r;
+    const uint64_t c_bits = r == 0 ? 0
+        : D ? static_cast<uint64_t>(c - ((int64_t{1} << r) - 1))
+            : static_cast<uint64_t>(c + ((int64_t{1} << (r + 1)) - 1));
+    const double unit = static_cast<double>(uint64_t{1} << p);
+    const double scaled = (ell - static_cast<double>(c)) * unit;
+    const auto m_bits = static_cast<uint64_t>(scaled);
+    const double frac = scaled - static_cast<double>(m_bits);
+    // The digits→double, log, e·ln10 and sum roundings stay below 2^-51 of the terms' magnitudes.
+    if (std::fabs(frac - 0.5) <= (log_digits + std::fabs(log_scale) + 1.0) * 0x1p-49 * unit) return false;
+    u = (uint64_t{D} << (N - 2)) | (uint64_t{R} << (N - 5)) | (c_bits << p) | m_bits;
+    if (frac > 0.5) ++u;
+    return true;
+}
+
+/**
+ * @brief Parse one number starting at @p first; stops at the first character it cannot use.
+ *
+ * Same grammar and result as from_chars(first, last, value) plus an optional
+ * leading '+'; falls back to it for anything but plain decimals of up to 19
+ * significant digits.
+ */
+template <size_t N>
+inline std::from_chars_result parse_number(const char* first, const char* last, takum<N>& value) noexcept {
+    using storage_t = typename takum<N>::storage_t;
+    const char* p = first;
+    const bool negative = p != last && *p == '-';
+    if (p != last && (*p == '-' || *p == '+')) ++p;
+    const char* body = p;
+    // from_chars has no leading '+'.
+    auto slow = [&] { return from_chars(first + (first != last && *first == '+' ? 1 : 0), last, value); };
+
+    uint64_t digits = 0;
+    int kept = 0;
+    int exp10 = 0;
+    while (p != last && *p == '0') ++p;
+    while (last - p >= 8 && kept <= max_decimal_digits - 8) {
+        const uint64_t w = load8(p);
+        if (!is_eight_digits(w)) break;
+        digits = digits * 100000000 + parse_eight_digits(w);
+        kept += 8;
+        p += 8;
+    }
+    for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+        if (kept == max_decimal_digits) return slow();
+        digits = digits * 10 + static_cast<uint64_t>(*p - '0');
+        ++kept;
+    }
+    bool any = p != body;
+    if (p != last && *p == '.') {
+        const char* point = ++p;
+        if (digits == 0) {
+            while (p != last && *p == '0') ++p;
+            exp10 -= static_cast<int>(p - point);
+        }
+        while (last - p >= 8 && kept <= max_decimal_digits - 8) {
+            const uint64_t w = load8(p);
+            if (!is_eight_digits(w)) break;
+            digits = digits * 100000000 + parse_eight_digits(w);
+            kept += 8;
+            exp10 -= 8;
+            p += 8;
+        }
+        for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+            if (kept == max_decimal_digits) return slow();
+            digits = digits * 10 + static_cast<uint64_t>(*p - '0');
+            ++kept;
+            --exp10;
+        }
+        any = any || p != point;
+    }
+    // No digits: NaR spellings or garbage, both decided by from_chars.
+    if (!any) return slow();
+
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        const bool exp_negative = q != last && *q == '-';
+        if (q != last && (*q == '-' || *q == '+')) ++q;
+        if (q != last && *q >= '0' && *q <= '9') {
+            int e = 0;
+            for (; q != last && *q >= '0' && *q <= '9'; ++q) e = std::min(e * 10 + (*q - '0'), 100000);
+            exp10 += exp_negative ? -e : e;
+            p = q;
+        }
+    }
+
+    if (digits == 0) {
+        value = takum<N>{};
+        return {p, std::errc{}};
+    }
+    uint64_t u = 0;
+    bool done = false;
+    if constexpr (N <= 40) done = magnitude_of_decimal_fast<N>(digits, exp10, u);
+    if (!done) {
+        if (const std::errc ec = magnitude_of_decimal<N>(digits, exp10, u); ec != std::errc{}) return {p, ec};
+    }
+    value = takum<N>::from_raw_bits(static_cast<storage_t>((negative ? uint64_t{1} << (N - 1) : 0) | u));
+    return {p, std::errc{}};
+}
+
+/// Number of tokens in [first, last).
+inline size_t count_tokens(const char* first, const char* last) noexcept {
+    size_t n = 0;
+    bool in_token = false;
+    for (const char* p = first; p != last; ++p) {
+        const bool delim = is_parse_delimiter(*p);
+        n += !delim && !in_token;
+        in_token = !delim;
+    }
+    return n;
+}
+
+/// Parse every token of [first, last) into out[0, cap).
+template <size_t N>
+inline parse_many_result parse_range(const char* first, const char* last, takum<N>* out, size_t cap) noexcept {
+    parse_many_result res{0, last, std::errc{}};
+    const char* p = first;
+    for (;;) {
+        while (p != last && is_parse_delimiter(*p)) ++p;
+        if (p == last) return res;
+        if (res.count == cap) return {res.count, p, std::errc::value_too_large};
+        takum<N> v;
+        const auto r = parse_number<N>(p, last, v);
+        if (r.ec != std::errc{}) return {res.count, p, r.ec};
+        if (r.ptr != last && !is_parse_delimiter(*r.ptr)) return {res.count, p, std::errc::invalid_argument};
+        out[res.count++] = v;
+        p = r.ptr;
+    }
+}
+
+/**
+ * @brief Parse @p text as @p pieces pieces split at delimiter boundaries.
+ *
+ * Counts tokens per piece, prefix-sums the counts into output offsets and
+ * parses the pieces, both passes through parallel_for() with one piece per
+ * worker. Errors resolve to the first failing piece in text order.
+ */
+template <size_t N>
+inline parse_many_result parse_pieces(std::string_view text, std::span<takum<N>> out, size_t pieces) {
+    const char* const first = text.data();
+    const char* const last = first + text.size();
+    if (pieces <= 1) return parse_range<N>(first, last, out.data(), out.size());
+
+    // Piece w starts just after a delimiter so that no token straddles two pieces.
+    std::vector<const char*> bounds(pieces + 1, last);
+    bounds[0] = first;
+    for (size_t w = 1; w < pieces; ++w) {
+        const char* b = std::max(first + text.size() / pieces * w, bounds[w - 1]);
+        while (b != first && b != last && !is_parse_delimiter(b[-1])) ++b;
+        bounds[w] = b;
+    }
+
+    std::vector<size_t> offset(pieces + 1, 0);
+    parallel_for(pieces, [&](size_t begin, size_t end, size_t) {
+        for (size_t w = begin; w < end; ++w) offset[w + 1] = count_tokens(bounds[w], bounds[w + 1]);
+    }, 1);
+    for (size_t w = 0; w < pieces; ++w) offset[w + 1] += offset[w];
+
+    std::vector<parse_many_result> results(pieces);
+    parallel_for(pieces, [&](size_t begin, size_t end, size_t) {
+        for (size_t w = begin; w < end; ++w) {
+            const size_t at = std::min(offset[w], out.size());
+            results[w] = parse_range<N>(bounds[w], bounds[w + 1], out.data() + at, out.size() - at);
+        }
+    }, 1);
+
+    for (size_t w = 0; w < pieces; ++w) {
+        if (results[w].ec != std::errc{}) {
+            return {std::min(offset[w], out.size()) + results[w].count, results[w].ptr, results[w].ec};
+        }
+    }
+    return {offset[pieces], last, std::errc{}};
+}
+
+} // namespace internal
+
+/**
+ * @brief Parse the delimited decimal numbers in @p text into @p out.
+ *
+ * Tokens use the from_chars() grammar (optional sign, digits with an optional
+ * '.', optional exponent, or "nar" / "nan" / "inf" for NaR) and are separated
+ * by any run of ',', ' ', '\\t', '\\r' or '\\n'. Each value is rounded exactly
+ * as from_chars() rounds it. Inputs of several MiB are parsed in parallel; on
+ * failure, elements of @p out past the returned count may have been overwritten.
+ *
+ * @param text Input text (need not be NUL-terminated)
+ * @param out Destination; the i-th token is written to out[i]
+ * @return Number of values written, and on failure the offending token and error
+ */
+template <size_t N>
+inline parse_many_result parse_many(std::string_view text, std::span<takum<N>> out) {
+    static_assert(N >= 12 && N <= 64, "takum::parse_many: supported for 12 <= N <= 64");
+    return internal::parse_pieces<N>(text, out, internal::worker_count(text.size(), internal::parse_grain_bytes));
+}
+
+} // namespace takum
@@ -0,0 +1,165 @@
+/**
+ * @file polynomial.h
+ * @brief Batched polynomial and rational function evaluation over takum spans.
+ *
+ * `polyval(coeffs, x, out)` writes `out[i] = c0 + c1·x[i] + … + cd·x[i]^d`
+ * (coefficients in ascending order, as in Boost.Math and
+ * numpy.polynomial) and `ratval(num, den, x, out)` the quotient of two such
+ * polynomials, for i < min(x.size(), out.size()). @p out may alias @p x.
+ *
+ * The coefficients are decoded once. Points are decoded 256 at a time
+ * (through the table for N <= 16) into the wide accumulator — `double` up to
+ * 32 bits, internal::wide_float above — and Horner's rule runs across the
+ * block with the points as the inner loop, which the compiler vectorises
+ * (and contracts to FMA where the target and flags allow). Each point is
+ * rounded to takum<N> once at the end instead of after each of its
+ * 2·degree operations. Above 32 bits neither the decode nor the rounding
+ * goes through `double`, so takum<64> results keep their precision. With
+ * many independent points per block Horner's dependency chain is already
+ * hidden, so Estrin's scheme would only add multiplications.
+ *
+ * The `std::array` overloads fix the degree at compile time, so the Horner
+ * loop unrolls and the coefficients stay in registers.
+ *
+ * NaR inputs or coefficients give NaR, as does a zero denominator in ratval.
+ * Results beyond the takum range saturate like the encoder.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/elementwise.h"
+#include "takum/status_flags.h"
+#include "takum/internal/parallel.h"
+
+namespace takum {
+
+namespace internal {
+
+/// @brief Points decoded and evaluated together.
+inline constexpr size_t poly_block = 256;
+
+/// @brief Decode @p coeffs into the wide accumulator.
+template <size_t N, typename Out>
+inline void decode_coeffs(std::span<const takum<N>> coeffs, Out& out) {
+    const wide_decoder<N> dec;
+    for (size_t k = 0; k < coeffs.size(); ++k) out[k] = dec(coeffs[k]);
+}
+
+/// @brief `p[j] = Σ c[k]·x[j]^k` over one block (empty coefficients give 0).
+template <typename A, typename Coeffs>
+inline void horner_block(const Coeffs& c, const A* x, A* p, size_t len) noexcept {
+    const size_t d = c.size();
+    if (d == 0) {
+        std::fill(p, p + len, A(0));
+        return;
+    }
+    std::fill(p, p + len, c[d - 1]);
+    for (size_t k = d - 1; k-- > 0;) {
+        const A ck = c[k];
+        for (size_t j = 0; j < len; ++j) p[j] = p[j] * x[j] + ck;
+    }
+}
+
+/// @brief Round a wide result to takum<N>; infinities saturate instead of becoming NaR.
+template <size_t N, typename A>
+inline takum<N> round_wide(A v) noexcept {
+    if (std::isinf(v)) TAKUM_UNLIKELY {
+        return takum<N>(std::copysign(std::numeric_limits<double>::max(), static_cast<double>(v)));
+    }
+    return encode_wide<N>(v);
+}
+
+/**
+ * @brief Shared driver: p (and q when @p den is non-null) per block, then round.
+ */
+template <size_t N, typename Coeffs>
+inline void poly_kernel(const Coeffs& num, const std::type_identity_t<Coeffs>* den, std::span<const takum<N>> x,
+                        std::span<takum<N>> out) {
+    using A = wide_acc_t<N>;
+    const size_t n = std::min(x.size(), out.size());
+    parallel_for(n, [&](size_t begin, size_t end, size_t) {
+        const wide_decoder<N> dec;
+        A xs[poly_block], p[poly_block], q[poly_block];
+        for (size_t base = begin; base < end; base += poly_block) {
+            const size_t len = std::min(poly_block, end - base);
+            for (size_t j = 0; j < len; ++j) xs[j] = dec(x[base + j]);
+            horner_block(num, xs, p, len);
+            if (den == nullptr) {
+                for (size_t j = 0; j < len; ++j) out[base + j] = round_wide<N>(p[j]);
+                continue;
+            }
+            horner_block(*den, xs, q, len);
+            for (size_t j = 0; j < len; ++j) {
+                if (q[j] == 0) TAKUM_UNLIKELY {
+                    raise_status(flag_nar | flag_invalid);
+                    out[base + j] = takum<N>::nar();
+                    continue;
+                }
+                out[base + j] = round_wide<N>(p[j] / q[j]);
+            }
+        }
+    });
+}
+
+} // namespace internal
+
+/// @brief `out[i] = Σ coeffs[k]·x[i]^k` for i < min(sizes).
+template <size_t N>
+inline void polyval(std::span<const takum<N>> coeffs, std::span<const takum<N>> x, std::span<takum<N>> out) {
+    std::vector<internal::wide_acc_t<N>> c(coeffs.size());
+    internal::decode_coeffs<N>(coeffs, c);
+    internal::poly_kernel<N>(c, nullptr, x, out);
+}
+
+/// @brief polyval() with the degree (K - 1) fixed at compile time.
+template <size_t N, size_t K>
+inline void polyval(const std::array<takum<N>, K>& coeffs, std::span<const takum<N>> x, std::span<takum<N>> out) {
+    std::array<internal::wide_acc_t<N>, K> c;
+    internal::decode_coeffs<N>(std::span<const takum<N>>(coeffs), c);
+    internal::poly_kernel<N>(c, nullptr, x, out);
+}
+
+/// @brief Σ coeffs[k]·x^k at a single point, rounded once.
+template <size_t N>
+inline takum<N> polyval(std::span<const takum<N>> coeffs, const takum<N>& x) {
+    takum<N> r;
+    polyval<N>(coeffs, std::span<const takum<N>>(&x, 1), std::span<takum<N>>(&r, 1));
+    return r;
+}
+
+/**
+ * @brief `out[i] = p(x[i]) / q(x[i])` with p, q given by ascending
+ * coefficients @p num and @p den; a zero denominator gives NaR.
+ */
+template <size_t N>
+inline void ratval(std::span<const takum<N>> num, std::span<const takum<N>> den, std::span<const takum<N>> x,
+                   std::span<takum<N>> out) {
+    std::vector<internal::wide_acc_t<N>> p(num.size()), q(den.size());
+    internal::decode_coeffs<N>(num, p);
+    internal::decode_coeffs<N>(den, q);
+    internal::poly_kernel<N>(p, &q, x, out);
+}
+
+/// @brief ratval() with both degrees fixed at compile time (padded to the larger).
+template <size_t N, size_t KP, size_t KQ>
+inline void ratval(const std::array<takum<N>, KP>& num, const std::array<takum<N>, KQ>& den,
+                   std::span<const takum<N>> x, std::span<takum<N>> out) {
+    constexpr size_t K = std::max(KP, KQ);
+    std::array<internal::wide_acc_t<N>, K> p{}, q{};
+    internal::decode_coeffs<N>(std::span<const takum<N>>(num), p);
+    internal::decode_coeffs<N>(std::span<const takum<N>>(den), q);
+    internal::poly_kernel<N>(p, &q, x, out);
+}
+
+} // namespace takum
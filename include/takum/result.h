@@ -0,0 +1,65 @@
+/**
+ * @file result.h
+ * @brief Result type for fallible (non-arithmetic) takum APIs.
+ *
+ * Container factories, file formats and parsers can fail for reasons that
+ * are not NaR (unsupported width, malformed input, I/O errors). They report
+ * those failures the same way the safe arithmetic variants do:
+ * `std::expected<T, takum_error>` on C++23 toolchains and `std::optional<T>`
+ * as the pre-C++23 fallback. `takum::result<T>` names whichever applies so
+ * each API is written once.
+ */
+
+#pragma once
+
+#include <optional>
+
+#include "takum/core.h"
+
+namespace takum {
+
+#if TAKUM_HAS_STD_EXPECTED
+/// @brief `std::expected<T, takum_error>` (C++23) or `std::optional<T>` (fallback).
+template <typename T>
+using result = std::expected<T, takum_error>;
+#else
+template <typename T>
+using result = std::optional<T>;
+#endif
+
+namespace internal {
+
+/**
+ * @brief Build the failure value for any `result<T>`.
+ *
+ * Returns `std::unexpected(takum_error{kind, message})` when std::expected is
+ * available and `std::nullopt` otherwise; both convert to `result<T>`.
+ */
+#if TAKUM_HAS_STD_EXPECTED
+inline std::unexpected<takum_error> fail(takum_error::Kind kind, const char* message) noexcept {
+    return std::unexpected(takum_error{kind, message});
+}
+#else
+inline std::nullopt_t fail(takum_error::Kind, const char*) noexcept {
+    return std::nullopt;
+}
+#endif
+
+/**
+ * @brief Forward the failure of @p r (which must hold an error) to another `result<U>`.
+ */
+#if TAKUM_HAS_STD_EXPECTED
+template <typename T>
+inline std::unexpected<takum_error> error_of(const result<T>& r) noexcept {
+    return std::unexpected(r.error());
+}
+#else
+template <typename T>
+inline std::nullopt_t error_of(const result<T>&) noexcept {
+    return std::nullopt;
+}
+#endif
+
+} // namespace internal
+
+} // namespace takum
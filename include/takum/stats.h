@@ -0,0 +1,222 @@
+/**
+ * @file stats.h
+ * @brief Streaming, mergeable moment statistics over takum values.
+ *
+ * `stats::running_moments<N>` keeps count, mean and the second to fourth
+ * central moment sums, plus min and max, in a state that can be updated one
+ * value at a time (Welford / Terriberry), fed whole spans, and merged with
+ * another state (Chan et al., Pébay's higher-order terms). Moments accumulate
+ * in `double` for N <= 32 and in internal::wide_float above, so they are
+ * always wider than the data; min and max are tracked on raw bits through
+ * the scan.h order keys, which limits the class to N <= 64.
+ *
+ * The span update decodes 256-value blocks (table lookup for N <= 16), takes
+ * each block's moments in two passes and merges them into the state, which
+ * is both faster and more accurate than per-value updates. Large spans are
+ * split across worker threads and the partial states merged in order.
+ *
+ * NaR values are skipped and counted in nar_count(). Statistics of an empty
+ * state are NaR; a constant stream has exact mean, zero variance and NaR
+ * skewness and kurtosis.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/elementwise.h"
+#include "takum/scan.h"
+#include "takum/internal/parallel.h"
+
+namespace takum::stats {
+
+/**
+ * @brief Mergeable running count, mean, variance, skewness, kurtosis, min and max.
+ */
+template <size_t N>
+class running_moments {
+    static_assert(N <= 64, "stats: only single-word takum widths are supported");
+
+public:
+    /// @brief Accumulator type, wider than takum<N>.
+    using acc_t = internal::wide_acc_t<N>;
+
+    /// @brief Values per block in the span update.
+    static constexpr size_t block = 256;
+
+    running_moments() = default;
+
+    /// @brief Add one value (NaR is counted and skipped).
+    void update(const takum<N>& x) noexcept {
+        const key_t k = internal::order_key(x);
+        if (k == internal::nar_key<N>()) TAKUM_UNLIKELY {
+            ++nar_;
+            return;
+        }
+        track(k);
+        // Terriberry's single-value update of the central moment sums.
+        const acc_t v = internal::wide_decoder<N>{}(x);
+        const acc_t n1 = static_cast<acc_t>(n_);
+        ++n_;
+        const acc_t n = static_cast<acc_t>(n_);
+        const acc_t delta = v - mean_;
+        const acc_t delta_n = delta / n;
+        const acc_t delta_n2 = delta_n * delta_n;
+        const acc_t term1 = delta * delta_n * n1;
+        mean_ += delta_n;
+        m4_ += term1 * delta_n2 * (n * n - 3 * n + 3) + 6 * delta_n2 * m2_ - 4 * delta_n * m3_;
+        m3_ += term1 * delta_n * (n - 2) - 3 * delta_n * m2_;
+        m2_ += term1;
+    }
+
+    /// @brief Add every value of @p xs (threaded above TAKUM_PARALLEL_GRAIN).
+    void update(std::span<const takum<N>> xs) {
+        std::vector<running_moments> partial(internal::worker_count(xs.size()));
+        internal::parallel_for(xs.size(), [&](size_t begin, size_t end, size_t w) {
+            partial[w].update_serial(xs.subspan(begin, end - begin));
+        });
+        for (const auto& p : partial) merge(p);
+    }
+
+    /// @brief Fold @p other into this state, as if its values had been added here.
+    void merge(const running_moments& other) noexcept {
+        nar_ += other.nar_;
+        if (other.n_ == 0) return;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        combine(static_cast<acc_t>(other.n_), other.mean_, other.m2_, other.m3_, other.m4_);
+        n_ += other.n_;
+    }
+
+    /// @brief Forget every value.
+    void reset() noexcept { *this = running_moments{}; }
+
+    /// @brief Number of non-NaR values.
+    uint64_t count() const noexcept { return n_; }
+    /// @brief Number of NaR values skipped.
+    uint64_t nar_count() const noexcept { return nar_; }
+
+    /// @brief Arithmetic mean.
+    takum<N> mean() const noexcept {
+        if (n_ == 0) return takum<N>::nar();
+        return constant() ? internal::from_order_key<N>(min_) : round(mean_);
+    }
+
+    /// @brief Variance with @p ddof delta degrees of freedom (0: population, 1: sample).
+    takum<N> variance(unsigned ddof = 0) const noexcept {
+        if (n_ <= ddof) return takum<N>::nar();
+        return constant() ? takum<N>(0.0) : round(m2_ / static_cast<acc_t>(n_ - ddof));
+    }
+
+    /// @brief Square root of variance(ddof).
+    takum<N> stddev(unsigned ddof = 0) const noexcept {
+        if (n_ <= ddof) return takum<N>::nar();
+        if (constant()) return takum<N>(0.0);
+        return round(std::sqrt(m2_ / static_cast<acc_t>(n_ - ddof)));
+    }
+
+    /// @brief Population skewness g1 = √n·M3 / M2^1.5.
+    takum<N> skewness() const noexcept {
+        if (n_ == 0 || constant() || m2_ <= 0) return takum<N>::nar();
+        return round(std::sqrt(static_cast<acc_t>(n_)) * m3_ / (m2_ * std::sqrt(m2_)));
+    }
+
+    /// @brief Population excess kurtosis g2 = n·M4 / M2² − 3.
+    takum<N> kurtosis() const noexcept {
+        if (n_ == 0 || constant() || m2_ <= 0) return takum<N>::nar();
+        return round(static_cast<acc_t>(n_) * m4_ / (m2_ * m2_) - 3);
+    }
+
+    /// @brief Smallest value (exact; NaR when empty).
+    takum<N> min() const noexcept { return n_ == 0 ? takum<N>::nar() : internal::from_order_key<N>(min_); }
+    /// @brief Largest value (exact; NaR when empty).
+    takum<N> max() const noexcept { return n_ == 0 ? takum<N>::nar() : internal::from_order_key<N>(max_); }
+
+private:
+    using key_t = internal::scan_key_t<N>;
+
+    // Every value had the same bits: exact answers, rather than the rounding
+    // residue the decoded moments would leave.
+    bool constant() const noexcept { return min_ == max_; }
+
+    static takum<N> round(acc_t v) noexcept { return internal::encode_wide<N>(v); }
+
+    void track(const key_t& k) noexcept {
+        min_ = std::min(min_, k);
+        max_ = std::max(max_, k);
+    }
+
+    /// @brief Chan/Pébay merge of a group of @p nb values into the state (n_ not updated).
+    void combine(acc_t nb, acc_t mean_b, acc_t m2b, acc_t m3b, acc_t m4b) noexcept {
+        const acc_t na = static_cast<acc_t>(n_);
+        if (n_ == 0) {
+            mean_ = mean_b;
+            m2_ = m2b;
+            m3_ = m3b;
+            m4_ = m4b;
+            return;
+        }
+        const acc_t n = na + nb;
+        const acc_t delta = mean_b - mean_;
+        const acc_t delta_n = delta / n;
+        const acc_t delta2 = delta * delta;
+        const acc_t nab = na * nb;
+        m4_ += m4b + delta2 * delta2 * nab * (na * na - nab + nb * nb) / (n * n * n) +
+               6 * delta2 * (na * na * m2b + nb * nb * m2_) / (n * n) + 4 * delta_n * (na * m3b - nb * m3_);
+        m3_ += m3b + delta2 * delta * nab * (na - nb) / (n * n) + 3 * delta_n * (na * m2b - nb * m2_);
+        m2_ += m2b + delta2 * nab / n;
+        mean_ += delta_n * nb;
+    }
+
+    /// @brief Block-wise two-pass update over @p xs on the calling thread.
+    void update_serial(std::span<const takum<N>> xs) noexcept {
+        const internal::wide_decoder<N> dec;
+        const key_t nar = internal::nar_key<N>();
+        acc_t v[block];
+        for (size_t base = 0; base < xs.size(); base += block) {
+            const size_t len = std::min(block, xs.size() - base);
+            size_t m = 0;
+            for (size_t i = 0; i < len; ++i) {
+                const takum<N>& x = xs[base + i];
+                const key_t k = internal::order_key(x);
+                if (k == nar) TAKUM_UNLIKELY {
+                    ++nar_;
+                    continue;
+                }
+                track(k);
+                v[m++] = dec(x);
+            }
+            if (m == 0) continue;
+            acc_t sum = 0;
+            for (size_t i = 0; i < m; ++i) sum += v[i];
+            const acc_t mean_b = sum / static_cast<acc_t>(m);
+            acc_t s2 = 0, s3 = 0, s4 = 0;
+            for (size_t i = 0; i < m; ++i) {
+                const acc_t d = v[i] - mean_b;
+                const acc_t d2 = d * d;
+                s2 += d2;
+                s3 += d2 * d;
+                s4 += d2 * d2;
+            }
+            combine(static_cast<acc_t>(m), mean_b, s2, s3, s4);
+            n_ += m;
+        }
+    }
+
+    uint64_t n_ = 0;
+    uint64_t nar_ = 0;
+    acc_t mean_ = 0;
+    acc_t m2_ = 0; ///< Σ(x − mean)²
+    acc_t m3_ = 0; ///< Σ(x − mean)³
+    acc_t m4_ = 0; ///< Σ(x − mean)⁴
+    key_t min_ = internal::max_key<N>();
+    key_t max_{};
+};
+
+} // namespace takum::stats
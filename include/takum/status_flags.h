@@ -0,0 +1,124 @@
+/**
+ * @file status_flags.h
+ * @brief Sticky, thread-local status flags for takum operations (fenv-style).
+ *
+ * Conversions and arithmetic OR a status_flag into a per-thread register
+ * whenever they produce NaR, saturate or round. Flags stay set until cleared,
+ * so a hot loop can run the unchecked operators and test once per batch:
+ *
+ * ```cpp
+ * takum::clear_flags();
+ * takum::mul<32>(x, y, out);
+ * if (takum::test_flags(takum::flag_nar | takum::flag_overflow)) { ... }
+ * ```
+ *
+ * The span kernels (elementwise.h, batch.h) fold the flags raised on their
+ * worker threads back into the calling thread. Sign operations (unary minus,
+ * abs) never raise flags. Compiling with TAKUM_ENABLE_STATUS_FLAGS=0 turns
+ * every raise into a no-op; test_flags() then always returns 0.
+ *
+ * flag_inexact is conservative wherever a value goes through the double
+ * encoder, which computes ℓ with a logarithm: conversions from double and
+ * the scalar operators that re-encode a host-double result raise it unless
+ * that ℓ is exactly on a pattern, which few results exact in ℓ are. The
+ * integer ℓ kernels (mul/div and the product scans for 12 <= N <= 32)
+ * decide it exactly.
+ */
+
+#pragma once
+
+#include "takum/config.h"
+
+namespace takum {
+
+/**
+ * @brief Bits of the status register.
+ */
+enum status_flag : unsigned {
+    flag_nar = 1u << 0,       ///< An operation returned NaR (including NaR operands).
+    flag_invalid = 1u << 1,   ///< NaR from non-NaR inputs: x/0, 1/0, NaN/Inf conversion.
+    flag_overflow = 1u << 2,  ///< Result saturated to the largest magnitude.
+    flag_underflow = 1u << 3, ///< Non-zero result saturated to the smallest magnitude.
+    flag_inexact = 1u << 4,   ///< Result was rounded to the nearest pattern.
+    all_flags = (1u << 5) - 1u
+};
+
+namespace internal {
+
+/// @brief The calling thread's status register.
+inline unsigned& status_register() noexcept {
+    static thread_local unsigned flags = 0;
+    return flags;
+}
+
+/// @brief OR @p flags into the register (no-op with TAKUM_ENABLE_STATUS_FLAGS=0).
+inline void raise_status(unsigned flags) noexcept {
+#if TAKUM_ENABLE_STATUS_FLAGS
+    status_register() |= flags;
+#else
+    (void)flags;
+#endif
+}
+
+} // namespace internal
+
+/**
+ * @brief Flags in @p mask raised on this thread since they were last cleared.
+ */
+inline unsigned test_flags(unsigned mask = all_flags) noexcept {
+    return internal::status_register() & mask;
+}
+
+/**
+ * @brief Clear the flags in @p mask on this thread.
+ */
+inline void clear_flags(unsigned mask = all_flags) noexcept {
+    internal::status_register() &= ~mask;
+}
+
+/**
+ * @brief Raise the flags in @p flags on this thread, as an operation would.
+ */
+inline void raise_flags(unsigned flags) noexcept {
+    internal::raise_status(flags & all_flags);
+}
+
+/**
+ * @brief Snapshot of this thread's register, for restore_flags().
+ */
+inline unsigned save_flags() noexcept {
+    return internal::status_register();
+}
+
+/**
+ * @brief Replace this thread's register with a snapshot from save_flags().
+ */
+inline void restore_flags(unsigned saved) noexcept {
+    internal::status_register() = saved & all_flags;
+}
+
+/**
+ * @brief Scoped save/restore of the status register.
+ *
+ * Saves and clears the register on construction, so flags() reports only
+ * what the scope raised, and restores the saved flags on destruction.
+ * Pass `merge = true` to keep the scope's flags as well (like
+ * `feupdateenv`).
+ */
+class flags_guard {
+public:
+    explicit flags_guard(bool merge = false) noexcept : saved_(save_flags()), merge_(merge) { clear_flags(); }
+    ~flags_guard() { restore_flags(merge_ ? (saved_ | save_flags()) : saved_); }
+
+    flags_guard(const flags_guard&) = delete;
+    flags_guard& operator=(const flags_guard&) = delete;
+
+    /// @brief Flags raised inside the scope so far.
+    unsigned flags(unsigned mask = all_flags) const noexcept { return test_flags(mask); }
+
+private:
+    unsigned saved_;
+    bool merge_;
+};
+
+} // namespace takum
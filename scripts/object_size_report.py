@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Object-size report for the takum arithmetic call sites.
+
+Compiles a probe translation unit whose functions each run one takum
+operation over an array (the shape of a typical caller loop) and prints the
+code size of every probe function, plus the total .text size of the object.
+Used to check that rare paths (NaR, zero, overflow, cancellation) stay out
+of line instead of being inlined into every caller.
+
+Usage: python3 scripts/object_size_report.py [--cxx g++] [--opt -O2] [-D...]
+Extra -D/-U flags are forwarded to the compiler.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+WIDTHS = (16, 32, 64)
+
+PROBE_TEMPLATE = """
+#include <cstddef>
+#include "takum/arithmetic.h"
+#define PROBE(N)                                                                       \\
+    void probe_add_##N(const takum::takum<N>* a, const takum::takum<N>* b,             \\
+                       takum::takum<N>* out, std::size_t n) {                          \\
+        for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];                      \\
+    }                                                                                  \\
+    void probe_sub_##N(const takum::takum<N>* a, const takum::takum<N>* b,             \\
+                       takum::takum<N>* out, std::size_t n) {                          \\
+        for (std::size_t i = 0; i < n; ++i) out[i] = a[i] - b[i];                      \\
+    }                                                                                  \\
+    void probe_encode_##N(const double* x, takum::takum<N>* out, std::size_t n) {      \\
+        for (std::size_t i = 0; i < n; ++i) out[i] = takum::takum<N>(x[i]);            \\
+    }
+%s
+"""
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "g++"))
+    parser.add_argument("--opt", default="-O2")
+    args, defines = parser.parse_known_args()
+
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    source = PROBE_TEMPLATE % "\n".join("PROBE(%d)" % n for n in WIDTHS)
+    with tempfile.TemporaryDirectory() as tmp:
+        src = os.path.join(tmp, "probe.cpp")
+        obj = os.path.join(tmp, "probe.o")
+        with open(src, "w") as f:
+            f.write(source)
+        cmd = [args.cxx, "-std=c++23", args.opt, "-I", os.path.join(root, "include"),
+               *defines, "-c", src, "-o", obj]
+        subprocess.run(cmd, check=True)
+        nm = subprocess.run(["nm", "-S", "-C", "--size-sort", obj],
+                            check=True, capture_output=True, text=True).stdout
+        size = subprocess.run(["size", "-A", obj], check=True, capture_output=True, text=True).stdout
+
+    probes = {}
+    out_of_line = 0
+    for line in nm.splitlines():
+        parts = line.split(maxsplit=3)
+        if len(parts) < 4 or parts[2] not in "tTwW":
+            continue
+        bytes_ = int(parts[1], 16)
+        m = re.match(r"probe_(\w+?)_(\d+)\(", parts[3])
+        if m:
+            probes[(m.group(1), int(m.group(2)))] = bytes_
+        else:
+            out_of_line += bytes_
+    text = sum(int(l.split()[1]) for l in size.splitlines() if l.startswith(".text"))
+
+    print("%-8s" % "N" + "".join("%10s" % op for op in ("add", "sub", "encode")) + "   (bytes per caller)")
+    for n in WIDTHS:
+        print("%-8d" % n + "".join("%10d" % probes.get((op, n), 0) for op in ("add", "sub", "encode")))
+    print("out-of-line helpers: %d bytes" % out_of_line)
+    print(".text total:         %d bytes" % text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
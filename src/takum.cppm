@@ -0,0 +1,130 @@
+/**
+ * @file takum.cppm
+ * @brief `takum` named module: core type, arithmetic, aliases, precision traits and the Φ API.
+ *
+ * The headers are included in the global module fragment and their public
+ * names re-exported with using-declarations, so `import takum;` and
+ * `#include "takum/core.h"` name the same entities and can be mixed in one
+ * program. Configuration macros (config.h) take effect when the module
+ * itself is built.
+ *
+ * Experimental: this interface has not yet been built with a toolchain that
+ * supports re-exported using-declarations (GCC 14+, Clang 16+, MSVC 17.4+),
+ * and whether importing it compiles faster than the headers is unmeasured.
+ * test/module_check.cpp is the program to build and time both ways.
+ *
+ * The widths in TAKUM_COMPILED_WIDTHS and the Φ lookup tables are explicitly
+ * instantiated below, so their code and tables are emitted once, in this
+ * unit's object file; TAKUM_COMPILED makes the matching extern template
+ * declarations reachable from importers.
+ */
+
+module;
+
+#ifndef TAKUM_COMPILED
+#define TAKUM_COMPILED 1
+#endif
+
+#include "takum/arithmetic.h"
+#include "takum/config.h"
+#include "takum/core.h"
+#include "takum/precision_traits.h"
+#include "takum/status_flags.h"
+#include "takum/types.h"
+#include "takum/internal/phi_eval.h"
+
+export module takum;
+
+export namespace takum {
+using ::takum::takum;
+using ::takum::takum_error;
+using ::takum::takum_floating_point;
+
+using ::takum::operator+;
+using ::takum::operator-;
+using ::takum::operator*;
+using ::takum::operator/;
+using ::takum::abs;
+using ::takum::safe_add;
+using ::takum::safe_sub;
+using ::takum::safe_mul;
+using ::takum::safe_div;
+using ::takum::safe_abs;
+using ::takum::safe_recip;
+
+using ::takum::status_flag;
+using ::takum::flag_nar;
+using ::takum::flag_invalid;
+using ::takum::flag_overflow;
+using ::takum::flag_underflow;
+using ::takum::flag_inexact;
+using ::takum::all_flags;
+using ::takum::test_flags;
+using ::takum::clear_flags;
+using ::takum::raise_flags;
+using ::takum::save_flags;
+using ::takum::restore_flags;
+using ::takum::flags_guard;
+} // namespace takum
+
+export namespace takum::types {
+using ::takum::types::takum8;
+using ::takum::types::takum16;
+using ::takum::types::takum19;
+using ::takum::types::takum32;
+using ::takum::types::takum64;
+using ::takum::types::takum128;
+} // namespace takum::types
+
+export namespace takum::precision {
+using ::takum::precision::effective_p;
+using ::takum::precision::lambda_p;
+using ::takum::precision::combined_error;
+} // namespace takum::precision
+
+export namespace takum::config {
+using ::takum::config::fast_add;
+using ::takum::config::cubic_phi_lut;
+using ::takum::config::coarse_hybrid_lut_size;
+using ::takum::config::phi_diagnostics;
+using ::takum::config::status_flags;
+using ::takum::config::threads;
+using ::takum::config::parallel_grain;
+using ::takum::config::decode_lut_max_bits;
+using ::takum::config::compiled;
+using ::takum::config::no_long_double;
+} // namespace takum::config
+
+export namespace takum::internal::phi {
+using ::takum::internal::phi::PhiEvalResult;
+using ::takum::internal::phi::PhiDiagCounters;
+using ::takum::internal::phi::phi;
+using ::takum::internal::phi::phi_eval;
+using ::takum::internal::phi::phi_v;
+using ::takum::internal::phi::phi_poly_eval;
+using ::takum::internal::phi::phi_lut_1024;
+using ::takum::internal::phi::phi_lut_4096;
+using ::takum::internal::phi::within_phi_budget;
+using ::takum::internal::phi::phi_diag;
+} // namespace takum::internal::phi
+
+// Emitted once, here; importers reach them through the extern template declarations.
+namespace takum {
+#define TAKUM_INSTANTIATE_TAKUM(N) \
+    template struct takum<N>; \
+    template takum<N> operator+ <N>(const takum<N>&, const takum<N>&) noexcept; \
+    template takum<N> operator- <N>(const takum<N>&, const takum<N>&) noexcept; \
+    template takum<N> operator* <N>(const takum<N>&, const takum<N>&) noexcept; \
+    template takum<N> operator/ <N>(const takum<N>&, const takum<N>&) noexcept; \
+    template takum<N> abs<N>(const takum<N>&) noexcept;
+TAKUM_COMPILED_WIDTHS(TAKUM_INSTANTIATE_TAKUM)
+#undef TAKUM_INSTANTIATE_TAKUM
+} // namespace takum
+
+namespace takum::internal::phi {
+template const std::array<uint32_t, 1025>& detail::get_lut<1024>();
+template const std::array<uint32_t, 4097>& detail::get_lut<4096>();
+#define TAKUM_INSTANTIATE_PHI(N) template PhiEvalResult phi_eval<N>(wide_float) noexcept;
+TAKUM_COMPILED_WIDTHS(TAKUM_INSTANTIATE_PHI)
+#undef TAKUM_INSTANTIATE_PHI
+} // namespace takum::internal::phi
@@ -0,0 +1,38 @@
+/**
+ * @file takum_compiled.cpp
+ * @brief Explicit instantiations behind the TakumCppCompiled library.
+ *
+ * Instantiates takum<N>, its arithmetic operators, the Φ evaluators and the
+ * Φ lookup tables once for every width in TAKUM_COMPILED_WIDTHS. Translation
+ * units built with TAKUM_COMPILED=1 see matching `extern template`
+ * declarations and link against these definitions instead of instantiating
+ * their own.
+ */
+
+#include "takum/arithmetic.h"
+#include "takum/types.h"
+
+namespace takum {
+
+#define TAKUM_INSTANTIATE_TAKUM(N) \
+    template struct takum<N>; \
+    template takum<N> operator+ <N>(const takum<N>&, const takum<N>&) noexcept; \
+    template takum<N> operator- <N>(const takum<N>&, const takum<N>&) noexcept; \
+    template takum<N> operator* <N>(const takum<N>&, const takum<N>&) noexcept; \
+    template takum<N> operator/ <N>(const takum<N>&, const takum<N>&) noexcept; \
+    template takum<N> abs<N>(const takum<N>&) noexcept;
+TAKUM_COMPILED_WIDTHS(TAKUM_INSTANTIATE_TAKUM)
+#undef TAKUM_INSTANTIATE_TAKUM
+
+} // namespace takum
+
+namespace takum::internal::phi {
+
+template const std::array<uint32_t, 1025>& detail::get_lut<1024>();
+template const std::array<uint32_t, 4097>& detail::get_lut<4096>();
+
+#define TAKUM_INSTANTIATE_PHI(N) template PhiEvalResult phi_eval<N>(wide_float) noexcept;
+TAKUM_COMPILED_WIDTHS(TAKUM_INSTANTIATE_PHI)
+#undef TAKUM_INSTANTIATE_PHI
+
+} // namespace takum::internal::phi
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "takum/advisor.h"
+
+namespace {
+
+std::vector<double> smooth_dataset(size_t n) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = std::exp(std::sin(0.001 * static_cast<double>(i)) * 8.0) - 0.5;
+    return v;
+}
+
+} // namespace
+
+TEST(WidthAdvisor, RecommendsNarrowestWidthMeetingTarget) {
+    auto data = smooth_dataset(4096);
+    const double target = 1e-4;
+    auto advice = takum::advise_width(data, target);
+
+    ASSERT_NE(advice.recommended_width, 0u);
+    const auto* best = advice.find(advice.recommended_width);
+    ASSERT_NE(best, nullptr);
+    EXPECT_LE(best->max_rel_error, target);
+    // Every narrower candidate must miss the target.
+    for (const auto& c : advice.candidates) {
+        if (c.width < advice.recommended_width) {
+            EXPECT_FALSE(c.meets_target) << "N=" << c.width;
+        }
+    }
+    EXPECT_EQ(advice.baseline_bytes, data.size() * sizeof(double));
+    EXPECT_EQ(advice.bytes_saved, advice.baseline_bytes - best->packed_bytes);
+}
+
+TEST(WidthAdvisor, ErrorShrinksWithWidth) {
+    auto data = smooth_dataset(2048);
+    auto advice = takum::advise_width(data, 1e-9);
+    ASSERT_GE(advice.candidates.size(), 2u);
+    for (size_t i = 1; i < advice.candidates.size(); ++i) {
+        EXPECT_LE(advice.candidates[i].max_rel_error, advice.candidates[i - 1].max_rel_error * 1.0001)
+            << "N=" << advice.candidates[i].width;
+        EXPECT_LE(advice.candidates[i].mean_rel_error, advice.candidates[i].max_rel_error);
+    }
+}
+
+TEST(WidthAdvisor, CountsSaturationNaRAndHistogram) {
+    // 1e60 has ℓ = 2·ln(1e60) ≈ 276 > max_ell(), so it saturates at every width.
+    std::vector<double> data = {1.0, 0.0, 1e60, std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::quiet_NaN(), -2.0};
+    auto advice = takum::advise_width(data, 1.0);
+    EXPECT_EQ(advice.histogram.zeros, 1u);
+    EXPECT_EQ(advice.histogram.non_finite, 2u);
+    EXPECT_EQ(advice.histogram.count(0), 1u);                     // ℓ(1) = 0
+    EXPECT_EQ(advice.histogram.count(1), 1u);                     // ℓ(2) ≈ 1.386
+    EXPECT_EQ(advice.histogram.count(takum::ell_histogram::max_bin), 1u); // 1e60 folded into last bin
+    for (const auto& c : advice.candidates) {
+        EXPECT_EQ(c.saturated, 1u) << "N=" << c.width;
+        EXPECT_EQ(c.nar, 2u);
+        EXPECT_FALSE(c.meets_target);
+    }
+    EXPECT_EQ(advice.recommended_width, 0u);
+    EXPECT_EQ(advice.bytes_saved, 0u);
+
+    takum::advisor_options opts;
+    opts.allow_saturation = true;
+    EXPECT_EQ(takum::advise_width(data, 1.0, opts).recommended_width, 12u);
+}
+
+TEST(WidthAdvisor, ParallelScanMatchesSerial) {
+    auto data = smooth_dataset(20000);
+    takum::advisor_options serial;
+    serial.grain = data.size() + 1;
+    takum::advisor_options parallel;
+    parallel.grain = 1024;
+    parallel.min_width = serial.min_width = 16;
+    parallel.max_width = serial.max_width = 32;
+
+    auto a = takum::advise_width(data, 1e-5, serial);
+    auto b = takum::advise_width(data, 1e-5, parallel);
+    ASSERT_EQ(a.candidates.size(), b.candidates.size());
+    EXPECT_EQ(a.candidates.front().width, 16u);
+    EXPECT_EQ(a.candidates.back().width, 32u);
+    for (size_t i = 0; i < a.candidates.size(); ++i) {
+        EXPECT_EQ(a.candidates[i].max_rel_error, b.candidates[i].max_rel_error);
+        EXPECT_NEAR(a.candidates[i].mean_rel_error, b.candidates[i].mean_rel_error, 1e-15);
+    }
+    EXPECT_EQ(a.histogram.bins, b.histogram.bins);
+    EXPECT_EQ(a.recommended_width, b.recommended_width);
+}
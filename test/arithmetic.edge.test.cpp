@@ -40,3 +40,37 @@ TEST(ArithmeticEdge, NaRRoundTrip) {
     EXPECT_TRUE(n2.is_nar());
     EXPECT_EQ(n, n2);
 }
+
+template <size_t N>
+static void expect_small_magnitude_sums() {
+    using T = takum::takum<N>;
+    const double tol = N >= 32 ? 1e-6 : 1e-2;
+    EXPECT_NEAR((T(2.0) - T(0.5)).to_double(), 1.5, tol);
+    EXPECT_NEAR((T(0.25) + T(0.5)).to_double(), 0.75, tol);
+    EXPECT_NEAR((T(-0.125) + T(0.5)).to_double(), 0.375, tol);
+    EXPECT_NEAR((T(1.5) + T(-2.25)).to_double(), -0.75, tol);
+    EXPECT_NEAR((T(0.01) - T(3.0)).to_double(), -2.99, tol * 3);
+}
+
+TEST(ArithmeticEdge, AddSubBelowOne) {
+    expect_small_magnitude_sums<16>();
+    expect_small_magnitude_sums<32>();
+    expect_small_magnitude_sums<64>();
+}
+
+TEST(ArithmeticEdge, AddRarePaths) {
+    using T = takum::types::takum32;
+    const T x(3.75);
+    EXPECT_EQ(x + T(0.0), x);
+    EXPECT_EQ(T(0.0) + x, x);
+    EXPECT_TRUE((T(0.0) + T(0.0)).is_zero());
+    EXPECT_TRUE((x - x).is_zero());
+    EXPECT_EQ(x - T(0.0), x);
+    EXPECT_EQ(T(0.0) - x, -x);
+    EXPECT_TRUE((-T(0.0)).is_zero());
+    EXPECT_TRUE((takum::types::takum64(-0.3) + takum::types::takum64(0.3)).is_zero());
+    EXPECT_TRUE((T::nar() + T(0.0)).is_nar());
+    EXPECT_TRUE((T(0.0) - T::nar()).is_nar());
+    EXPECT_EQ(x + T(1e-20), x);
+    EXPECT_EQ(T(-1e-20) + x, x);
+}
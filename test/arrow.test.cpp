@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "takum/arrow.h"
+
+namespace {
+
+template <size_t N>
+std::vector<takum::takum<N>> sample(size_t n) {
+    std::vector<takum::takum<N>> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = takum::takum<N>(std::sin(0.3 * static_cast<double>(i)) * 1e3);
+    return v;
+}
+
+} // namespace
+
+TEST(Arrow, ExportDescribesExtensionType) {
+    auto v = sample<32>(10);
+    ArrowArray array{};
+    ArrowSchema schema{};
+    takum::arrow::export_array<32>(std::span<const takum::takum<32>>(v), &array, &schema, "x");
+
+    EXPECT_STREQ(schema.format, "I");
+    EXPECT_STREQ(schema.name, "x");
+    EXPECT_EQ(takum::arrow::internal::find_metadata(schema.metadata, "ARROW:extension:name"), "takum.32");
+    EXPECT_EQ(array.length, 10);
+    EXPECT_EQ(array.null_count, 0);
+    EXPECT_EQ(array.n_buffers, 2);
+    EXPECT_EQ(array.buffers[0], nullptr);
+    EXPECT_EQ(array.buffers[1], v.data());
+
+    array.release(&array);
+    schema.release(&schema);
+    EXPECT_EQ(array.release, nullptr);
+    EXPECT_EQ(schema.release, nullptr);
+}
+
+TEST(Arrow, StorageFormatByWidth) {
+    EXPECT_EQ(takum::arrow::storage_format<16>(), "I");
+    EXPECT_EQ(takum::arrow::storage_format<64>(), "L");
+    EXPECT_EQ(takum::arrow::storage_format<128>(), "w:16");
+}
+
+TEST(Arrow, RoundTripIsZeroCopy) {
+    auto v = sample<64>(100);
+    const auto* data = v.data();
+    ArrowArray array{};
+    ArrowSchema schema{};
+    takum::arrow::export_array<64>(std::move(v), &array, &schema);
+
+    auto imported = takum::arrow::import_array<64>(&array, &schema);
+    ASSERT_TRUE(imported.has_value());
+    EXPECT_EQ(array.release, nullptr); // moved into the import
+    EXPECT_TRUE(imported->zero_copy());
+    EXPECT_EQ(imported->values().data(), data);
+    const auto expect = sample<64>(100);
+    for (size_t i = 0; i < expect.size(); ++i) EXPECT_EQ((*imported)[i].raw_bits(), expect[i].raw_bits());
+    schema.release(&schema);
+}
+
+TEST(Arrow, ImportMapsNullsToNaR) {
+    auto v = sample<32>(12);
+    ArrowArray array{};
+    ArrowSchema schema{};
+    takum::arrow::export_array<32>(std::span<const takum::takum<32>>(v), &array, &schema);
+
+    // Mark elements 3 and 9 (after an offset of 1) null through a consumer-side validity bitmap.
+    const uint8_t validity[2] = {static_cast<uint8_t>(~(1u << 4)), static_cast<uint8_t>(~(1u << 2))};
+    array.buffers[0] = validity;
+    array.offset = 1;
+    array.length = 11;
+    array.null_count = 2;
+
+    auto imported = takum::arrow::import_array<32>(&array, &schema);
+    ASSERT_TRUE(imported.has_value());
+    EXPECT_FALSE(imported->zero_copy());
+    ASSERT_EQ(imported->size(), 11u);
+    for (size_t i = 0; i < 11; ++i) {
+        if (i == 3 || i == 9) EXPECT_TRUE((*imported)[i].is_nar());
+        else EXPECT_EQ((*imported)[i].raw_bits(), v[i + 1].raw_bits());
+    }
+    schema.release(&schema);
+}
+
+TEST(Arrow, ImportRejectsMismatchedWidth) {
+    auto v = sample<32>(4);
+    ArrowArray array{};
+    ArrowSchema schema{};
+    takum::arrow::export_array<32>(std::span<const takum::takum<32>>(v), &array, &schema);
+
+    EXPECT_FALSE(takum::arrow::import_array<64>(&array, &schema).has_value());
+    EXPECT_FALSE(takum::arrow::import_array<16>(&array, &schema).has_value()); // same storage, other extension
+    EXPECT_NE(array.release, nullptr); // ownership stays with the caller on failure
+    array.release(&array);
+    schema.release(&schema);
+}
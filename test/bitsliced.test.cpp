@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "takum/bitsliced.h"
+#include "takum/types.h"
+
+#include "test_data.h"
+
+using namespace takum::types;
+using takum::scan::cmp_op;
+
+namespace {
+
+bool bit(const std::vector<uint8_t>& bits, size_t i) { return ((bits[i / 8] >> (i % 8)) & 1u) != 0; }
+
+// Value-order predicate on decoded reals; NaR never matches.
+template <size_t N>
+bool reference(const takum::takum<N>& x, cmp_op op, const takum::takum<N>& c) {
+    if (x.is_nar() || c.is_nar()) return false;
+    const double a = x.to_double(), b = c.to_double();
+    switch (op) {
+    case cmp_op::lt: return a < b;
+    case cmp_op::le: return a <= b;
+    case cmp_op::gt: return a > b;
+    case cmp_op::ge: return a >= b;
+    case cmp_op::eq: return a == b;
+    case cmp_op::ne: return a != b;
+    }
+    return false;
+}
+
+template <size_t N>
+void expect_matches_scan() {
+    using T = takum::takum<N>;
+    const auto v = test_data::halves<N>(2 * TAKUM_PARALLEL_GRAIN + 77, N); // not a multiple of 512
+    const std::span<const T> in(v);
+    const takum::bitsliced_column<N> col(in);
+    ASSERT_EQ(col.size(), v.size());
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(col[i].storage, v[i].storage) << i;
+
+    const T constants[] = {T(0.0), T(1.0), T(-2.5), T(4.5), T(-10.0), T(100.0), T::nar()};
+    for (cmp_op op : {cmp_op::lt, cmp_op::le, cmp_op::gt, cmp_op::ge, cmp_op::eq, cmp_op::ne}) {
+        for (const T& c : constants) {
+            std::vector<uint8_t> want((v.size() + 7) / 8), got(want.size(), 0xFF);
+            EXPECT_EQ(col.compare(op, c, got), takum::scan::compare<N>(in, op, c, want));
+            EXPECT_EQ(got, want);
+            for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(bit(got, i), reference(v[i], op, c)) << i;
+        }
+    }
+    const std::pair<double, double> ranges[] = {{-2.0, 3.0}, {0.0, 0.0}, {-10.0, 10.0}, {5.0, -5.0}, {7.5, 50.0}};
+    for (auto [lo, hi] : ranges) {
+        std::vector<uint8_t> want((v.size() + 7) / 8), got(want.size(), 0xFF);
+        EXPECT_EQ(col.between(T(lo), T(hi), got), takum::scan::between<N>(in, T(lo), T(hi), want));
+        EXPECT_EQ(got, want);
+        for (size_t i = 0; i < v.size(); ++i) {
+            ASSERT_EQ(bit(got, i), reference(v[i], cmp_op::ge, T(lo)) && reference(v[i], cmp_op::le, T(hi))) << i;
+        }
+    }
+}
+
+} // namespace
+
+TEST(Bitsliced, MatchesRowScans16) { expect_matches_scan<16>(); }
+TEST(Bitsliced, MatchesRowScans32) { expect_matches_scan<32>(); }
+TEST(Bitsliced, MatchesRowScans64) { expect_matches_scan<64>(); }
+
+TEST(Bitsliced, PlanesHoldOrderKeysMostSignificantFirst) {
+    const std::vector<takum16> v{takum16(1.0), takum16(-1.0), takum16(0.0)};
+    const takum::bitsliced_column<16> col(v);
+    EXPECT_EQ(col.words(), 1u);
+    // Plane 0 is the key's top bit: set for non-negative values.
+    EXPECT_EQ(col.plane(0)[0], 0b101u);
+    EXPECT_EQ(col.nar_words()[0], 0u);
+    EXPECT_EQ(col.storage_bytes(), 17 * sizeof(uint64_t));
+}
+
+TEST(Bitsliced, ApproxKeepsPrefixAndConverges) {
+    std::mt19937_64 rng(7);
+    std::lognormal_distribution<double> mag(0.0, 3.0);
+    std::vector<takum32> v(1000);
+    for (auto& t : v) t = takum32((rng() & 1) ? mag(rng) : -mag(rng));
+    v[3] = takum32::nar();
+    v[4] = takum32(0.0);
+    const takum::bitsliced_column<32> col(v);
+    for (size_t i = 0; i < v.size(); ++i) {
+        const auto key = takum::internal::order_key(v[i]);
+        for (size_t k = 1; k < 32; ++k) {
+            const auto a = col.approx(i, k);
+            if (v[i].is_nar()) {
+                EXPECT_TRUE(a.is_nar());
+                continue;
+            }
+            ASSERT_FALSE(a.is_nar()) << i << " " << k;
+            const auto akey = takum::internal::order_key(a);
+            ASSERT_EQ(akey >> (32 - k), key >> (32 - k)) << i << " " << k;
+        }
+        EXPECT_EQ(col.approx(i, 32).storage, v[i].storage);
+    }
+    // Mean relative error falls as planes are added.
+    auto mean_error = [&](size_t planes) {
+        std::vector<takum32> out(v.size());
+        col.decode(out, planes);
+        double sum = 0.0;
+        for (size_t i = 0; i < v.size(); ++i) {
+            if (v[i].is_nar() || v[i].is_zero()) continue;
+            sum += std::fabs(out[i].to_double() / v[i].to_double() - 1.0);
+        }
+        return sum / static_cast<double>(v.size());
+    };
+    const double e12 = mean_error(12), e16 = mean_error(16), e24 = mean_error(24);
+    EXPECT_GT(e12, e16);
+    EXPECT_GT(e16, e24);
+    EXPECT_LT(e24, 1e-4);
+    EXPECT_EQ(mean_error(32), 0.0);
+}
+
+TEST(Bitsliced, SmallestNegativeMidpointAvoidsNaR) {
+    takum16 tiny;
+    tiny.storage = 0x8001; // smallest-magnitude negative pattern
+    const std::vector<takum16> v{tiny};
+    const takum::bitsliced_column<16> col(v);
+    EXPECT_FALSE(col.approx(0, 15).is_nar());
+    EXPECT_EQ(col.approx(0, 16).storage, 0x8001u);
+}
+
+TEST(Bitsliced, EmptyColumnAndShortBitmap) {
+    const takum::bitsliced_column<32> empty;
+    std::vector<uint8_t> bits(4, 0xFF);
+    EXPECT_EQ(empty.compare(cmp_op::ge, takum32(0.0), bits), 0u);
+    const std::vector<takum32> v(100, takum32(2.0));
+    const takum::bitsliced_column<32> col(v);
+    std::vector<uint8_t> three(3);
+    EXPECT_EQ(col.compare(cmp_op::eq, takum32(2.0), three), 24u);
+    EXPECT_EQ(col.between(takum32(3.0), takum32(1.0), three), 0u);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "takum/advisor.h"
+#include "takum/block_array.h"
+
+namespace {
+
+// Alternating regions: values near 1 (small |ℓ|, many mantissa bits at any
+// width) and values spanning ~1e-40..1e40 (large |ℓ|, long regime).
+std::vector<double> regional_dataset(size_t n) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double t = static_cast<double>(i);
+        const bool wide = (i / 1024) % 2 == 1;
+        v[i] = wide ? std::exp(std::sin(0.37 * t) * 90.0) : 1.0 + 0.5 * std::sin(0.01 * t);
+    }
+    return v;
+}
+
+} // namespace
+
+TEST(BlockArray, EveryElementMeetsBound) {
+    auto data = regional_dataset(5000);
+    data[10] = 0.0;
+    data[11] = std::numeric_limits<double>::quiet_NaN();
+    takum::block_array_options opts;
+    opts.max_rel_error = 1e-6;
+    auto arr = takum::block_array::encode(data, opts);
+    ASSERT_TRUE(arr.has_value());
+    EXPECT_EQ(arr->size(), data.size());
+    EXPECT_EQ(arr->block_count(), (data.size() + 255) / 256);
+    EXPECT_EQ(arr->block(arr->block_count() - 1).count, data.size() % 256);
+
+    std::vector<double> back(data.size());
+    ASSERT_EQ(arr->decode(back), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (i == 11) {
+            EXPECT_TRUE(std::isnan(back[i]));
+            EXPECT_TRUE((*arr)[i].is_nar());
+            continue;
+        }
+        ASSERT_LE(std::fabs(back[i] - data[i]), 1e-6 * std::fabs(data[i])) << "i=" << i;
+        ASSERT_EQ((*arr)[i].to_double(), back[i]) << "i=" << i;
+    }
+}
+
+TEST(BlockArray, NarrowerThanSingleGlobalWidth) {
+    auto data = regional_dataset(16384);
+    takum::block_array_options opts;
+    opts.max_rel_error = 1e-6;
+    auto arr = takum::block_array::encode(data, opts);
+    ASSERT_TRUE(arr.has_value());
+
+    // Each block uses the narrowest width that works for that block alone.
+    size_t narrow_blocks = 0;
+    for (size_t b = 0; b < arr->block_count(); ++b) {
+        const auto& e = arr->block(b);
+        if ((b * 256 / 1024) % 2 == 0) {
+            EXPECT_LT(e.width, 32u) << "b=" << b;
+            ++narrow_blocks;
+        }
+    }
+    EXPECT_GT(narrow_blocks, 0u);
+
+    auto advice = takum::advise_width(data, opts.max_rel_error);
+    ASSERT_NE(advice.recommended_width, 0u);
+    const size_t global_bytes = (data.size() * advice.recommended_width + 63) / 64 * 8;
+    EXPECT_LT(arr->storage_bytes(), global_bytes);
+}
+
+TEST(BlockArray, StreamingAndBlockDecode) {
+    auto data = regional_dataset(1000);
+    takum::block_array_options opts;
+    opts.block_size = 100;
+    auto arr = takum::block_array::encode(data, opts);
+    ASSERT_TRUE(arr.has_value());
+
+    std::vector<double> all(data.size());
+    arr->decode(all);
+    size_t seen = 0;
+    arr->for_each_block([&](size_t b, size_t first, std::span<const double> vals) {
+        EXPECT_EQ(first, b * 100);
+        for (size_t i = 0; i < vals.size(); ++i) EXPECT_EQ(vals[i], all[first + i]);
+        seen += vals.size();
+    });
+    EXPECT_EQ(seen, data.size());
+
+    std::vector<double> small(50);
+    EXPECT_EQ(arr->decode_block(3, small), 0u);
+}
+
+TEST(BlockArray, TransformAndZipAreBlockwise) {
+    auto data = regional_dataset(3000);
+    takum::block_array_options opts;
+    opts.max_rel_error = 1e-5;
+    auto a = takum::block_array::encode(data, opts);
+    ASSERT_TRUE(a.has_value());
+    std::vector<double> da(data.size());
+    a->decode(da);
+
+    auto doubled = a->transform([](double x) { return 2.0 * x; });
+    ASSERT_TRUE(doubled.has_value());
+    auto sum = takum::block_array::zip(*a, *doubled, [](double x, double y) { return x + y; });
+    ASSERT_TRUE(sum.has_value());
+
+    std::vector<double> dd(data.size()), ds(data.size());
+    doubled->decode(dd);
+    sum->decode(ds);
+    for (size_t i = 0; i < data.size(); ++i) {
+        ASSERT_LE(std::fabs(dd[i] - 2.0 * da[i]), 1e-5 * std::fabs(2.0 * da[i])) << "i=" << i;
+        ASSERT_LE(std::fabs(ds[i] - (da[i] + dd[i])), 1e-5 * std::fabs(da[i] + dd[i])) << "i=" << i;
+    }
+
+    auto shorter = takum::block_array::encode(std::span<const double>(data).first(100), opts);
+    ASSERT_TRUE(shorter.has_value());
+    EXPECT_FALSE(takum::block_array::zip(*a, *shorter, [](double x, double) { return x; }).has_value());
+}
+
+TEST(BlockArray, ParallelEncodeMatchesSerial) {
+    auto data = regional_dataset(4 * TAKUM_PARALLEL_GRAIN + 5);
+    auto arr = takum::block_array::encode(data);
+    ASSERT_TRUE(arr.has_value());
+    for (size_t b = 0; b < arr->block_count(); b += 17) {
+        const size_t first = b * 256;
+        const size_t n = arr->block(b).count;
+        auto one = takum::block_array::encode(std::span<const double>(data).subspan(first, n));
+        ASSERT_TRUE(one.has_value());
+        EXPECT_EQ(one->block(0).width, arr->block(b).width);
+        auto w = arr->words().subspan(arr->block(b).word_offset, one->words().size());
+        EXPECT_TRUE(std::ranges::equal(w, one->words())) << "b=" << b;
+    }
+}
+
+TEST(BlockArray, RejectsInvalidOptions) {
+    std::vector<double> data = {1.0, 2.0, 3.0};
+    takum::block_array_options opts;
+    opts.block_size = 0;
+    EXPECT_FALSE(takum::block_array::encode(data, opts).has_value());
+    opts = {};
+    opts.max_rel_error = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_FALSE(takum::block_array::encode(data, opts).has_value());
+    opts = {};
+    opts.min_width = 65;
+    EXPECT_FALSE(takum::block_array::encode(data, opts).has_value());
+
+    auto empty = takum::block_array::encode({});
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_EQ(empty->block_count(), 0u);
+    EXPECT_TRUE(empty->words().empty());
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "takum/charconv.h"
+
+namespace {
+
+template <size_t N>
+std::string format(const takum::takum<N>& x) {
+    char buf[64];
+    auto r = takum::to_chars(buf, buf + sizeof(buf), x);
+    EXPECT_EQ(r.ec, std::errc{});
+    return std::string(buf, r.ptr);
+}
+
+template <size_t N>
+std::string format(const takum::takum<N>& x, std::chars_format fmt, int precision) {
+    char buf[128];
+    auto r = takum::to_chars(buf, buf + sizeof(buf), x, fmt, precision);
+    EXPECT_EQ(r.ec, std::errc{});
+    return std::string(buf, r.ptr);
+}
+
+template <size_t N>
+takum::takum<N> parse(const std::string& s, std::chars_format fmt = std::chars_format::general) {
+    takum::takum<N> x{};
+    auto r = takum::from_chars(s.data(), s.data() + s.size(), x, fmt);
+    EXPECT_EQ(r.ec, std::errc{}) << s;
+    EXPECT_EQ(r.ptr, s.data() + s.size()) << s;
+    return x;
+}
+
+template <size_t N>
+void expect_round_trip(uint64_t bits) {
+    const auto x = takum::takum<N>::from_raw_bits(static_cast<typename takum::takum<N>::storage_t>(bits));
+    const std::string s = format(x);
+    const auto y = parse<N>(s);
+    ASSERT_EQ(static_cast<uint64_t>(y.raw_bits()), bits) << "N=" << N << " text=" << s;
+}
+
+} // namespace
+
+TEST(CharConv, ExhaustiveRoundTrip16) {
+    for (uint64_t bits = 0; bits < (uint64_t{1} << 16); ++bits) expect_round_trip<16>(bits);
+}
+
+TEST(CharConv, RandomRoundTrip) {
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 20000; ++i) {
+        expect_round_trip<24>(rng() & 0xFFFFFFu);
+        expect_round_trip<32>(rng() & 0xFFFFFFFFu);
+        expect_round_trip<48>(rng() & 0xFFFFFFFFFFFFu);
+    }
+}
+
+TEST(CharConv, RandomRoundTrip64) {
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 50000; ++i) expect_round_trip<64>(rng());
+    // Near 1 the patterns are closer than a 19th digit resolves.
+    expect_round_trip<64>(0x42c5fa1fb7ee579bULL);
+    expect_round_trip<64>(0xc009b9eb72f8478cULL);
+    EXPECT_EQ(format(takum::takum<64>::from_raw_bits(0x42c5fa1fb7ee579bULL)).size(), 21u); // "1." + 19 digits
+}
+
+TEST(CharConv, ShortestIsShort) {
+    EXPECT_EQ(format(takum::takum<32>(1.0)), "1");
+    EXPECT_EQ(format(takum::takum<32>(-2.5)), "-2.5");
+    EXPECT_EQ(format(takum::takum<32>(0.1)), "0.1");
+    EXPECT_EQ(format(takum::takum<16>(1e6)), "1e+06");
+    EXPECT_EQ(format(takum::takum<32>(0.0)), "0");
+    EXPECT_EQ(format(takum::takum<32>::nar()), "NaR");
+    // A coarse format needs fewer digits than a fine one.
+    EXPECT_LT(format(takum::takum<16>(3.14159265358979)).size(), format(takum::takum<48>(3.14159265358979)).size());
+}
+
+TEST(CharConv, FromCharsMatchesConstructor) {
+    for (double v : {1.0, -1.0, 0.1, 3.5, 1e-20, 7.25e30, -123456.789}) {
+        char buf[32];
+        auto r = std::to_chars(buf, buf + sizeof(buf), v);
+        EXPECT_EQ(parse<32>(std::string(buf, r.ptr)).raw_bits(), takum::takum<32>(v).raw_bits()) << v;
+    }
+}
+
+TEST(CharConv, PrecisionModes) {
+    const takum::takum<32> x(1234.5678);
+    EXPECT_EQ(format(x, std::chars_format::fixed, 2), "1234.57");
+    EXPECT_EQ(format(x, std::chars_format::scientific, 3), "1.235e+03");
+    EXPECT_EQ(format(x, std::chars_format::general, 6), "1234.57");
+    EXPECT_EQ(format(x, std::chars_format::general, 2), "1.2e+03");
+    EXPECT_EQ(format(takum::takum<32>(0.5), std::chars_format::fixed, 0), "0");
+    EXPECT_EQ(format(takum::takum<32>(0.0), std::chars_format::scientific, 2), "0.00e+00");
+    EXPECT_EQ(format(takum::takum<32>(-0.001), std::chars_format::fixed, 4), "-0.0010");
+}
+
+TEST(CharConv, HexIsRawPattern) {
+    const takum::takum<32> x(-3.0);
+    const std::string s = format(x, std::chars_format::hex, 0);
+    char expect[16];
+    auto r = std::to_chars(expect, expect + sizeof(expect), static_cast<uint64_t>(x.raw_bits()), 16);
+    EXPECT_EQ(s, std::string(expect, r.ptr));
+    EXPECT_EQ(parse<32>(s, std::chars_format::hex).raw_bits(), x.raw_bits());
+}
+
+TEST(CharConv, ParseEdgeCases) {
+    EXPECT_TRUE(parse<32>("NaR").is_nar());
+    EXPECT_TRUE(parse<32>("-inf").is_nar());
+    EXPECT_TRUE(parse<32>("-0").is_zero());
+    EXPECT_EQ(parse<32>(".5e1").raw_bits(), parse<32>("5").raw_bits());
+    EXPECT_EQ(parse<32>("0.000000000000000000000000001234").raw_bits(), parse<32>("1.234e-27").raw_bits());
+
+    takum::takum<32> x(7.0);
+    const auto before = x.raw_bits();
+    const char* junk = "abc";
+    EXPECT_EQ(takum::from_chars(junk, junk + 3, x).ec, std::errc::invalid_argument);
+    const char* big = "1e500";
+    EXPECT_EQ(takum::from_chars(big, big + 5, x).ec, std::errc::result_out_of_range);
+    EXPECT_EQ(x.raw_bits(), before);
+
+    // The exponent is not consumed in fixed mode or when it has no digits.
+    const char* s = "2.5e";
+    auto r = takum::from_chars(s, s + 4, x);
+    EXPECT_EQ(r.ptr, s + 3);
+    const char* f = "2.5e3";
+    r = takum::from_chars(f, f + 5, x, std::chars_format::fixed);
+    EXPECT_EQ(r.ptr, f + 3);
+}
+
+TEST(CharConv, BufferTooSmall) {
+    char buf[3];
+    auto r = takum::to_chars(buf, buf + sizeof(buf), takum::takum<32>(3.14159));
+    EXPECT_EQ(r.ec, std::errc::value_too_large);
+    EXPECT_EQ(r.ptr, buf + sizeof(buf));
+}
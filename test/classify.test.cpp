@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "takum/classify.h"
+#include "takum/types.h"
+
+#include "test_data.h"
+
+using namespace takum::types;
+
+namespace {
+
+// Mix of zeros, NaRs, positives and negatives.
+template <size_t N>
+std::vector<takum::takum<N>> mixed(size_t n, uint64_t seed) {
+    return test_data::column<N>(n, seed, [](std::mt19937_64& rng) {
+        switch (rng() % 8) {
+        case 0: return takum::takum<N>(0.0);
+        case 1: return takum::takum<N>::nar();
+        case 2: return takum::takum<N>(-1.0 - static_cast<double>(rng() % 1000));
+        default: return takum::takum<N>(1.0 + static_cast<double>(rng() % 1000));
+        }
+    });
+}
+
+template <size_t N>
+void expect_kernels_match_scalar() {
+    const auto v = mixed<N>(3 * TAKUM_PARALLEL_GRAIN + 13, N);
+    const std::span<const takum::takum<N>> in(v);
+    size_t nars = 0;
+    for (const auto& t : v) nars += t.is_nar();
+    EXPECT_EQ(takum::count_nar<N>(in), nars);
+    EXPECT_TRUE(takum::any_nar<N>(in));
+
+    std::vector<uint8_t> bits((v.size() + 7) / 8, 0xFF);
+    EXPECT_EQ(takum::nar_mask<N>(in, bits), nars);
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(((bits[i / 8] >> (i % 8)) & 1u) != 0, v[i].is_nar()) << i;
+    EXPECT_EQ(bits.back() >> (v.size() % 8), 0) << "unused bits cleared";
+
+    std::vector<takum::takum_class> cls(v.size());
+    takum::classify<N>(in, cls);
+    for (size_t i = 0; i < v.size(); ++i) {
+        const auto want = v[i].is_nar()    ? takum::takum_class::nar
+                        : v[i].is_zero()   ? takum::takum_class::zero
+                        : v[i].signbit()   ? takum::takum_class::negative
+                                           : takum::takum_class::positive;
+        ASSERT_EQ(cls[i], want) << i;
+    }
+
+    std::vector<takum::takum<N>> out(v.size());
+    const size_t kept = takum::remove_nar<N>(in, out);
+    ASSERT_EQ(kept, v.size() - nars);
+    size_t k = 0;
+    for (const auto& t : v) {
+        if (t.is_nar()) continue;
+        ASSERT_EQ(out[k++], t);
+    }
+}
+
+} // namespace
+
+TEST(Classify, KernelsMatchScalarPredicates) {
+    expect_kernels_match_scalar<16>();
+    expect_kernels_match_scalar<32>();
+    expect_kernels_match_scalar<64>();
+    expect_kernels_match_scalar<128>();
+}
+
+TEST(Classify, AnyNarAndEmptyInputs) {
+    std::vector<takum32> v(1000, takum32(1.0));
+    EXPECT_FALSE(takum::any_nar<32>(v));
+    EXPECT_EQ(takum::count_nar<32>(v), 0u);
+    v[999] = takum32::nar();
+    EXPECT_TRUE(takum::any_nar<32>(v));
+    EXPECT_FALSE(takum::any_nar<32>(std::span<const takum32>()));
+    std::vector<takum32> out;
+    EXPECT_EQ(takum::remove_nar<32>(std::span<const takum32>(), out), 0u);
+}
+
+TEST(Classify, MultiwordNaRNeedsAllLowWordsZero) {
+    auto almost = takum128::nar();
+    almost.storage[0] = 1; // sign bit plus a low bit: a negative value, not NaR
+    EXPECT_FALSE(almost.is_nar());
+    const std::vector<takum128> v{almost, takum128::nar()};
+    std::vector<takum::takum_class> cls(2);
+    takum::classify<128>(v, cls);
+    EXPECT_EQ(cls[0], takum::takum_class::negative);
+    EXPECT_EQ(cls[1], takum::takum_class::nar);
+}
+
+TEST(Classify, CompactIfStopsWhenOutputFull) {
+    std::vector<takum16> v;
+    for (int i = -5; i <= 5; ++i) v.push_back(takum16(static_cast<double>(i)));
+    std::vector<takum16> out(3);
+    const size_t n = takum::compact_if<16>(v, out, [](const takum16& t) { return !t.signbit() && !t.is_zero(); });
+    ASSERT_EQ(n, 3u);
+    EXPECT_EQ(out[0], takum16(1.0));
+    EXPECT_EQ(out[2], takum16(3.0));
+
+    std::vector<takum16> small(2);
+    const std::vector<takum16> w{takum16::nar(), takum16(1.0), takum16(2.0), takum16(3.0)};
+    EXPECT_EQ(takum::remove_nar<16>(w, small), 2u);
+    EXPECT_EQ(small[1], takum16(2.0));
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "takum/codec.h"
+#include "takum/internal/checksum.h"
+
+namespace {
+
+template <size_t N>
+std::vector<takum::takum<N>> smooth_series(size_t n) {
+    std::vector<takum::takum<N>> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = takum::takum<N>(100.0 * std::sin(1e-3 * static_cast<double>(i)));
+    return v;
+}
+
+template <size_t N>
+void expect_round_trip(const std::vector<takum::takum<N>>& in, const takum::codec::options& opts) {
+    auto frame = takum::codec::compress<N>(std::span<const takum::takum<N>>(in), opts);
+    ASSERT_TRUE(frame.has_value());
+    auto back = takum::codec::decompress<N>(std::span<const uint8_t>(*frame));
+    ASSERT_TRUE(back.has_value());
+    ASSERT_EQ(back->size(), in.size());
+    for (size_t i = 0; i < in.size(); ++i) ASSERT_EQ((*back)[i].raw_bits(), in[i].raw_bits()) << "N=" << N << " i=" << i;
+}
+
+void put(std::vector<uint8_t>& out, uint64_t v, int bytes) {
+    for (int k = 0; k < bytes; ++k) out.push_back(static_cast<uint8_t>(v >> (8 * k)));
+}
+
+// A one-block takum<16> frame whose block is built by hand from packed words.
+std::vector<uint8_t> crafted_frame(size_t n, uint8_t pred, uint8_t bits, uint8_t ebits, uint64_t anchor,
+                                   const std::vector<uint64_t>& main, const std::vector<uint16_t>& positions,
+                                   const std::vector<uint64_t>& highs) {
+    std::vector<takum::takum<16>> in(n);
+    auto frame = *takum::codec::compress<16>(std::span<const takum::takum<16>>(in));
+    frame.resize(24 + 8 + 4); // header, one index entry, header checksum
+    std::vector<uint8_t> block = {pred, bits, ebits, 0};
+    put(block, n, 4);
+    put(block, positions.size(), 4);
+    put(block, 0, 4);
+    put(block, anchor, 8);
+    put(block, 0, 8);
+    for (uint64_t w : main) put(block, w, 8);
+    for (uint16_t pos : positions) put(block, pos, 2);
+    for (uint64_t w : highs) put(block, w, 8);
+    put(block, takum::internal::crc32(0, std::span<const uint8_t>(block)), 4);
+    frame.insert(frame.end(), block.begin(), block.end());
+    return frame;
+}
+
+} // namespace
+
+TEST(Codec, Crc32MatchesReferenceVector) {
+    const char* s = "123456789";
+    EXPECT_EQ(takum::internal::crc32(0, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(s), 9)), 0xCBF43926u);
+    // Chaining equals one pass.
+    const auto* b = reinterpret_cast<const uint8_t*>(s);
+    uint32_t c = takum::internal::crc32(0, std::span<const uint8_t>(b, 4));
+    EXPECT_EQ(takum::internal::crc32(c, std::span<const uint8_t>(b + 4, 5)), 0xCBF43926u);
+}
+
+TEST(Codec, LosslessForEveryPredictor) {
+    using takum::codec::predictor;
+    auto smooth = smooth_series<32>(10000);
+    std::mt19937_64 rng(7);
+    std::vector<takum::takum<32>> noise(3000);
+    for (auto& t : noise) t = takum::takum<32>::from_raw_bits(static_cast<uint32_t>(rng()));
+    noise[5] = takum::takum<32>::nar();
+    noise[6] = takum::takum<32>(0.0);
+
+    for (predictor p : {predictor::none, predictor::delta, predictor::xor_prev, predictor::automatic}) {
+        takum::codec::options opts;
+        opts.pred = p;
+        expect_round_trip<32>(smooth, opts);
+        expect_round_trip<32>(noise, opts);
+        opts.block_size = 1;
+        expect_round_trip<32>(std::vector<takum::takum<32>>(noise.begin(), noise.begin() + 50), opts);
+    }
+    expect_round_trip<12>(smooth_series<12>(777), {});
+    expect_round_trip<19>(smooth_series<19>(5000), {});
+    expect_round_trip<64>(smooth_series<64>(5000), {});
+    expect_round_trip<32>({}, {});
+}
+
+TEST(Codec, SmoothSeriesCompressesWell) {
+    // Slowly varying sensor-like signal around a set point.
+    std::vector<takum::takum<32>> in(1 << 16);
+    for (size_t i = 0; i < in.size(); ++i) in[i] = takum::takum<32>(20.0 + std::sin(1e-4 * static_cast<double>(i)));
+    auto frame = takum::codec::compress<32>(std::span<const takum::takum<32>>(in));
+    ASSERT_TRUE(frame.has_value());
+    // Neighbouring patterns differ by small integers: expect under half the raw size.
+    EXPECT_LT(frame->size() * 2, in.size() * sizeof(uint32_t));
+
+    auto info = takum::codec::inspect(*frame);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->width, 32u);
+    EXPECT_EQ(info->count, in.size());
+    EXPECT_EQ(info->block_count, (in.size() + 4095) / 4096);
+}
+
+TEST(Codec, RandomAccessByBlock) {
+    auto in = smooth_series<24>(10000);
+    takum::codec::options opts;
+    opts.block_size = 1000;
+    auto frame = takum::codec::compress<24>(std::span<const takum::takum<24>>(in), opts);
+    ASSERT_TRUE(frame.has_value());
+
+    std::vector<takum::takum<24>> blk(1000);
+    auto n = takum::codec::decompress_block<24>(*frame, 7, std::span<takum::takum<24>>(blk));
+    ASSERT_TRUE(n.has_value());
+    ASSERT_EQ(*n, 1000u);
+    for (size_t i = 0; i < 1000; ++i) EXPECT_EQ(blk[i].raw_bits(), in[7000 + i].raw_bits());
+    EXPECT_FALSE(takum::codec::decompress_block<24>(*frame, 10, std::span<takum::takum<24>>(blk)).has_value());
+}
+
+TEST(Codec, DetectsCorruptionAndMismatch) {
+    auto in = smooth_series<16>(5000);
+    takum::codec::options opts;
+    opts.block_size = 1024;
+    auto frame = takum::codec::compress<16>(std::span<const takum::takum<16>>(in), opts);
+    ASSERT_TRUE(frame.has_value());
+
+    EXPECT_FALSE(takum::codec::decompress<32>(std::span<const uint8_t>(*frame)).has_value()); // wrong N
+
+    auto bad = *frame;
+    bad[bad.size() - 10] ^= 0x01; // inside the last block
+    EXPECT_FALSE(takum::codec::decompress<16>(std::span<const uint8_t>(bad)).has_value());
+    std::vector<takum::takum<16>> blk(1024);
+    EXPECT_TRUE(takum::codec::decompress_block<16>(bad, 0, std::span<takum::takum<16>>(blk)).has_value());
+    EXPECT_FALSE(takum::codec::decompress_block<16>(bad, 4, std::span<takum::takum<16>>(blk)).has_value());
+
+    bad = *frame;
+    bad[17] ^= 0x40; // count field: header checksum must fail
+    EXPECT_FALSE(takum::codec::inspect(bad).has_value());
+    EXPECT_FALSE(takum::codec::inspect(std::span<const uint8_t>(frame->data(), 10)).has_value());
+
+    opts.block_size = 0;
+    EXPECT_FALSE(takum::codec::compress<16>(std::span<const takum::takum<16>>(in), opts).has_value());
+}
+
+TEST(Codec, RejectsExceptionsThatDoNotFitAWord) {
+    // One residual with an exception at position 0; the high part goes above `bits`.
+    const auto ok = crafted_frame(1, 0, 60, 4, 0, {0}, {0}, {0x1});
+    EXPECT_TRUE(takum::codec::decompress<16>(std::span<const uint8_t>(ok)).has_value());
+    const auto wide = crafted_frame(1, 0, 60, 8, 0, {0}, {0}, {0x1});
+    EXPECT_FALSE(takum::codec::decompress<16>(std::span<const uint8_t>(wide)).has_value());
+    const auto full = crafted_frame(1, 0, 64, 1, 0, {0}, {0}, {0x1});
+    EXPECT_FALSE(takum::codec::decompress<16>(std::span<const uint8_t>(full)).has_value());
+}
+
+TEST(Codec, DecodedPatternsKeepOnlyNBits) {
+    // xor_prev with an anchor above bit 16 must not leak into the patterns.
+    const auto frame = crafted_frame(2, 2, 64, 0, 0xABCD0000ULL, {0x4000, 0x0100}, {}, {});
+    auto back = takum::codec::decompress<16>(std::span<const uint8_t>(frame));
+    ASSERT_TRUE(back.has_value());
+    EXPECT_EQ((*back)[0].raw_bits(), 0x4000u);
+    EXPECT_EQ((*back)[1].raw_bits(), 0x4100u);
+}
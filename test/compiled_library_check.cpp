@@ -0,0 +1,61 @@
+// Built with TAKUM_COMPILED=1: every takum<N> below for the common widths
+// resolves to the instantiations in TakumCppCompiled. Checks that they link
+// and agree with the value semantics the header-only tests cover.
+
+#include <cmath>
+#include <cstdio>
+
+#include "takum/arithmetic.h"
+#include "takum/types.h"
+
+static_assert(takum::config::compiled(), "compiled_library_check must be built with TAKUM_COMPILED=1");
+
+namespace {
+
+int failures = 0;
+
+void expect_near(const char* what, double got, double want, double rel) {
+    if (!(std::fabs(got - want) <= rel * std::fabs(want))) {
+        std::printf("FAIL %s: got %.17g, want %.17g\n", what, got, want);
+        ++failures;
+    }
+}
+
+template <size_t N>
+void check(double rel) {
+    using T = takum::takum<N>;
+    const T a(1.5), b(-2.25);
+    char what[64];
+    std::snprintf(what, sizeof(what), "takum<%zu> a+b", N);
+    expect_near(what, (a + b).to_double(), -0.75, rel);
+    std::snprintf(what, sizeof(what), "takum<%zu> a-b", N);
+    expect_near(what, (a - b).to_double(), 3.75, rel);
+    std::snprintf(what, sizeof(what), "takum<%zu> a*b", N);
+    expect_near(what, (a * b).to_double(), -3.375, rel);
+    std::snprintf(what, sizeof(what), "takum<%zu> a/b", N);
+    expect_near(what, (a / b).to_double(), -2.0 / 3.0, rel);
+    std::snprintf(what, sizeof(what), "takum<%zu> abs", N);
+    expect_near(what, takum::abs(b).to_double(), 2.25, rel);
+    if (!(T::nar() + a).is_nar()) {
+        std::printf("FAIL takum<%zu>: NaR did not propagate\n", N);
+        ++failures;
+    }
+}
+
+} // namespace
+
+int main() {
+    check<16>(1e-2);
+    check<19>(5e-3);
+    check<32>(1e-6);
+    check<64>(1e-6);
+    const takum::types::takum8 tiny{};
+    if (!tiny.is_zero() || tiny.is_nar()) {
+        std::printf("FAIL takum8 zero\n");
+        ++failures;
+    }
+    const takum::types::takum128 wide(2.0);
+    expect_near("takum128 round trip", wide.to_double(), 2.0, 1e-12);
+    if (failures == 0) std::printf("compiled library: all widths OK\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// Runs takum_convert (argv[1]) on a small raw float64 file in directory
+// argv[2]: f64 -> .npy / .tka takum patterns -> f64. Every value read back
+// must equal the input rounded once through takum<N>, and inputs the tool
+// cannot read faithfully must be rejected.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "takum/core.h"
+#include "takum/npy.h"
+
+namespace {
+
+int failures = 0;
+
+std::string dir;
+std::string tool;
+
+std::string path(const char* name) { return dir + "/" + name; }
+
+bool run(const std::string& args, bool expect_ok = true) {
+    const std::string cmd = "\"" + tool + "\" --no-stats " + args;
+    if ((std::system(cmd.c_str()) == 0) != expect_ok) {
+        std::printf("FAIL (%s expected): %s\n", expect_ok ? "success" : "error", cmd.c_str());
+        ++failures;
+        return false;
+    }
+    return true;
+}
+
+// A '<u8' pattern array read as takum16 would be silently truncated.
+void check_rejects_wide_items() {
+    const uint64_t shape[1] = {1};
+    auto bytes = takum::io::internal::npy_preamble("'<u8'", shape);
+    const uint64_t item = 0x1234ABCD00004000ULL; // low 16 bits: takum16 1.0
+    for (int k = 0; k < 8; ++k) bytes.push_back(static_cast<uint8_t>(item >> (8 * k)));
+    const std::string file = path("convert_roundtrip.u8.npy");
+    std::ofstream(file, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()),
+                                                static_cast<std::streamsize>(bytes.size()));
+    run("--from takum16 \"" + file + "\" \"" + path("convert_roundtrip.u8.f64") + "\"", false);
+}
+
+void write_f64(const std::string& file, const std::vector<double>& v) {
+    std::ofstream f(file, std::ios::binary);
+    f.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(double)));
+}
+
+std::vector<double> read_f64(const std::string& file) {
+    std::ifstream f(file, std::ios::binary);
+    std::vector<char> bytes{std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+    std::vector<double> v(bytes.size() / sizeof(double));
+    for (size_t i = 0; i < v.size(); ++i) std::memcpy(&v[i], bytes.data() + i * sizeof(double), sizeof(double));
+    return v;
+}
+
+template <size_t N>
+void check(const std::vector<double>& in, const char* via) {
+    const std::string mid = path(via), out = path("convert_roundtrip.out.f64");
+    const std::string to = "takum" + std::to_string(N);
+    if (!run("--to " + to + " \"" + path("convert_roundtrip.in.f64") + "\" \"" + mid + "\"")) return;
+    if (!run("\"" + mid + "\" \"" + out + "\"")) return;
+    const auto back = read_f64(out);
+    if (back.size() != in.size()) {
+        std::printf("FAIL %s via %s: %zu values back, want %zu\n", to.c_str(), via, back.size(), in.size());
+        ++failures;
+        return;
+    }
+    for (size_t i = 0; i < in.size(); ++i) {
+        const double want = takum::takum<N>(in[i]).to_double();
+        const bool same = std::isnan(want) ? std::isnan(back[i]) : back[i] == want;
+        if (!same) {
+            std::printf("FAIL %s via %s [%zu]: got %.17g, want %.17g\n", to.c_str(), via, i, back[i], want);
+            ++failures;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::printf("usage: convert_roundtrip_check <takum_convert> <work dir>\n");
+        return 2;
+    }
+    tool = argv[1];
+    dir = argv[2];
+
+    std::vector<double> in = {0.0, 1.0, -2.5, 3.14159, 1e-30, -6.02e23, 1e300, std::nan("")};
+    for (int i = 0; i < 1000; ++i) in.push_back(std::exp(std::sin(0.37 * i) * 20.0) * (i % 3 ? 1 : -1));
+    write_f64(path("convert_roundtrip.in.f64"), in);
+
+    check<32>(in, "convert_roundtrip.npy");
+    check<16>(in, "convert_roundtrip.npy");
+    check<64>(in, "convert_roundtrip.npy");
+    check<32>(in, "convert_roundtrip.tka");
+    check<12>(in, "convert_roundtrip.tka");
+    check_rejects_wide_items();
+
+    if (failures == 0) std::printf("takum_convert round trips match the encoder\n");
+    return failures == 0 ? 0 : 1;
+}
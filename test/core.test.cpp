@@ -63,6 +63,8 @@ TEST_F(CoreTest, RoundTripTakum64) {
         long double tol = EPS * fabsl(static_cast<long double>(inp));
         EXPECT_NEAR(back, static_cast<long double>(inp), tol);
     }
+    // The sign bit alone is NaR at full word width too.
+    EXPECT_TRUE(std::isnan(takum::takum<64>::nar().to_double()));
 }
 
 TEST_F(CoreTest, MonotonicityAndUniquenessTakum12_Corrected) {
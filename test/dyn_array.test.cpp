@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "takum/dyn_array.h"
+
+namespace {
+
+std::vector<double> sample_values(size_t n) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = std::exp(std::sin(0.01 * static_cast<double>(i)) * 30.0) * ((i % 3) ? 1.0 : -1.0);
+    return v;
+}
+
+template <size_t N>
+void expect_matches_static(const std::vector<double>& data) {
+    auto arr = takum::dyn_array::encode(N, data);
+    ASSERT_TRUE(arr.has_value());
+    EXPECT_EQ(arr->width(), N);
+    EXPECT_EQ(arr->size(), data.size());
+    EXPECT_EQ(arr->storage_bytes(), (data.size() * N + 63) / 64 * 8);
+
+    std::vector<double> back(data.size());
+    EXPECT_EQ(arr->decode(back), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        const takum::takum<N> ref(data[i]);
+        ASSERT_EQ((*arr)[i].bits, static_cast<uint64_t>(ref.raw_bits())) << "N=" << N << " i=" << i;
+        ASSERT_EQ(back[i], ref.to_double()) << "N=" << N << " i=" << i;
+    }
+}
+
+} // namespace
+
+TEST(DynArray, MatchesStaticWidthKernels) {
+    // Odd length so the last 64-element group is partial.
+    auto data = sample_values(1000);
+    expect_matches_static<12>(data);
+    expect_matches_static<16>(data);
+    expect_matches_static<19>(data);
+    expect_matches_static<28>(data);
+    expect_matches_static<32>(data);
+    expect_matches_static<40>(data);
+    expect_matches_static<64>(data);
+}
+
+TEST(DynArray, ParallelEncodeMatchesScalar) {
+    auto data = sample_values(3 * TAKUM_PARALLEL_GRAIN + 17);
+    auto arr = takum::dyn_array::encode(19, data);
+    ASSERT_TRUE(arr.has_value());
+    for (size_t i = 0; i < data.size(); i += 97) {
+        EXPECT_EQ((*arr)[i], takum::takum_dyn::from(takum::takum<19>(data[i])));
+    }
+    std::vector<takum::takum<19>> unpacked(data.size());
+    EXPECT_EQ(arr->unpack<19>(std::span<takum::takum<19>>(unpacked)), data.size());
+    EXPECT_EQ(takum::dyn_array::from_takums<19>(unpacked).words().size(), arr->words().size());
+    EXPECT_TRUE(std::ranges::equal(takum::dyn_array::from_takums<19>(unpacked).words(), arr->words()));
+}
+
+TEST(DynArray, SetGetAndNaR) {
+    auto arr = takum::dyn_array::zeros(20, 10);
+    ASSERT_TRUE(arr.has_value());
+    EXPECT_TRUE((*arr)[3].is_zero());
+
+    auto v = takum::takum_dyn::from_double(20, -1.5);
+    ASSERT_TRUE(v.has_value());
+    EXPECT_TRUE(arr->set(3, *v));
+    EXPECT_TRUE(arr->set(4, takum::takum_dyn::from(takum::takum<20>::nar())));
+    EXPECT_FALSE(arr->set(5, takum::takum_dyn::from(takum::takum<16>(1.0)))); // width mismatch
+    EXPECT_FALSE(arr->set(10, *v));                                             // out of range
+
+    EXPECT_EQ((*arr)[3].to_double(), takum::takum<20>(-1.5).to_double());
+    EXPECT_TRUE((*arr)[4].is_nar());
+    EXPECT_TRUE(std::isnan((*arr)[4].to_double()));
+    EXPECT_TRUE((*arr)[2].is_zero());
+    EXPECT_TRUE((*arr)[5].is_zero());
+}
+
+TEST(DynArray, ConvertBetweenWidths) {
+    auto data = sample_values(300);
+    data[7] = std::numeric_limits<double>::quiet_NaN();
+    auto wide = takum::dyn_array::encode(32, data);
+    ASSERT_TRUE(wide.has_value());
+
+    auto narrow = wide->convert(16);
+    ASSERT_TRUE(narrow.has_value());
+    EXPECT_EQ(narrow->width(), 16u);
+    EXPECT_LT(narrow->storage_bytes(), wide->storage_bytes());
+    for (size_t i = 0; i < data.size(); ++i) {
+        const auto ref = takum::takum<16>(takum::takum<32>(data[i]).to_double());
+        const auto expected = std::isnan(data[i]) ? takum::takum<16>::nar() : ref;
+        EXPECT_EQ((*narrow)[i].bits, expected.raw_bits()) << "i=" << i;
+    }
+    EXPECT_TRUE((*narrow)[7].is_nar());
+}
+
+TEST(DynArray, RejectsUnsupportedWidth) {
+    std::vector<double> data = {1.0, 2.0};
+    EXPECT_FALSE(takum::dyn_array::encode(13, data).has_value());
+    EXPECT_FALSE(takum::dyn_array::zeros(128, 4).has_value());
+    EXPECT_FALSE(takum::takum_dyn::from_double(7, 1.0).has_value());
+    EXPECT_TRUE(std::isnan(takum::takum_dyn{}.to_double()));
+    EXPECT_FALSE(takum::is_supported_width(0));
+    EXPECT_TRUE(takum::is_supported_width(19));
+
+    auto arr = takum::dyn_array::encode(24, data);
+    ASSERT_TRUE(arr.has_value());
+    EXPECT_FALSE(arr->convert(3).has_value());
+    std::vector<takum::takum<16>> wrong(2);
+    EXPECT_EQ(arr->unpack<16>(std::span<takum::takum<16>>(wrong)), 0u);
+}
@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "takum/elementwise.h"
+#include "takum/types.h"
+
+#include "test_data.h"
+
+using namespace takum::types;
+
+namespace {
+
+// Larger than TAKUM_PARALLEL_GRAIN so the threaded path is exercised too.
+constexpr size_t kCount = 40000;
+
+template <size_t N>
+std::vector<takum::takum<N>> operands(uint64_t seed) {
+    std::lognormal_distribution<double> mag(0.0, 3.0);
+    return test_data::column<N>(kCount, seed, [&](std::mt19937_64& rng) {
+        switch (rng() % 32) {
+        case 0: return takum::takum<N>(0.0);
+        case 1: return takum::takum<N>::nar();
+        case 2: return takum::takum<N>(1e-60);
+        case 3: return takum::takum<N>(-1e60);
+        default: return takum::takum<N>((rng() & 1) ? mag(rng) : -mag(rng));
+        }
+    });
+}
+
+template <size_t N>
+using span_t = std::span<const takum::takum<N>>;
+
+// ℓ = 2·ln|x| of the pattern `delta` steps from `t`, in long double.
+template <size_t N>
+long double ell_of(const takum::takum<N>& t, int delta = 0) {
+    using storage_t = typename takum::takum<N>::storage_t;
+    const auto bits = static_cast<storage_t>(t.raw_bits() + static_cast<storage_t>(delta));
+    return 2.0L * std::log(std::fabs(static_cast<long double>(takum::takum<N>::from_raw_bits(bits).to_double())));
+}
+
+// |ℓ(got) − ℓ_ref| within half the local pattern spacing (saturation aside).
+template <size_t N>
+void expect_rounded_in_ell(const takum::takum<N>& got, long double ell_ref, bool negative) {
+    ASSERT_FALSE(got.is_nar());
+    ASSERT_EQ(got.signbit(), negative);
+    const long double ell = ell_of<N>(got);
+    if (std::fabs(ell_ref) >= 254) return; // saturated range
+    const auto pos = got.signbit() ? -got : got; // a neighbour past the end decodes to NaN/inf
+    const long double up = std::fabs(ell_of<N>(pos, 1) - ell);
+    const long double down = std::fabs(ell - ell_of<N>(pos, -1));
+    ASSERT_LE(std::fabs(ell - ell_ref), 0.5L * std::fmax(up, down) * (1 + 1e-9L) + 1e-15L);
+}
+
+template <size_t N>
+void expect_add_sub_match_scalar() {
+    const auto a = operands<N>(N), b = operands<N>(N + 1);
+    std::vector<takum::takum<N>> out(kCount);
+    takum::add<N>(a, b, out);
+    for (size_t i = 0; i < kCount; ++i) ASSERT_EQ(out[i].raw_bits(), (a[i] + b[i]).raw_bits()) << "N=" << N << " i=" << i;
+    takum::sub<N>(a, b, out);
+    for (size_t i = 0; i < kCount; ++i) ASSERT_EQ(out[i].raw_bits(), (a[i] - b[i]).raw_bits()) << "N=" << N << " i=" << i;
+}
+
+template <size_t N>
+void expect_mul_div_rounded() {
+    const auto a = operands<N>(2 * N), b = operands<N>(2 * N + 1);
+    std::vector<takum::takum<N>> prod(kCount), quot(kCount);
+    takum::mul<N>(a, b, prod);
+    takum::div<N>(a, b, quot);
+    for (size_t i = 0; i < kCount; ++i) {
+        SCOPED_TRACE(testing::Message() << "N=" << N << " i=" << i);
+        if (a[i].is_nar() || b[i].is_nar()) {
+            EXPECT_TRUE(prod[i].is_nar());
+            EXPECT_TRUE(quot[i].is_nar());
+            continue;
+        }
+        if (a[i].is_zero() || b[i].is_zero()) {
+            EXPECT_TRUE(prod[i].is_zero());
+            EXPECT_EQ(quot[i].raw_bits(), (a[i] / b[i]).raw_bits());
+            continue;
+        }
+        const bool neg = a[i].signbit() != b[i].signbit();
+        expect_rounded_in_ell<N>(prod[i], ell_of<N>(a[i]) + ell_of<N>(b[i]), neg);
+        expect_rounded_in_ell<N>(quot[i], ell_of<N>(a[i]) - ell_of<N>(b[i]), neg);
+        // Only exact ℓ ties may round differently from the host-double scalar path.
+        const auto scalar = a[i] * b[i];
+        if (prod[i].raw_bits() != scalar.raw_bits()) {
+            const long double ref = ell_of<N>(a[i]) + ell_of<N>(b[i]);
+            EXPECT_NEAR(std::fabs(ell_of<N>(prod[i]) - ref), std::fabs(ell_of<N>(scalar) - ref), 1e-12L);
+            EXPECT_EQ(prod[i].raw_bits() & 1u, 0u) << "ties to even";
+        }
+    }
+}
+
+// Span mul/div against mul_div_ell element by element, patterns and flags,
+// over 1000 elements (one worker): first with no zero or NaR operand, so
+// every pass takes the branch-free path, then with one zero mid-pass.
+template <size_t N>
+void expect_passes_match_elementwise() {
+    using T = takum::takum<N>;
+    std::mt19937_64 rng(N);
+    std::lognormal_distribution<double> mag(0.0, 3.0);
+    std::vector<T> a(1000), b(1000), out(1000);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = T((rng() & 1) ? mag(rng) : -mag(rng));
+        b[i] = T(i % 97 == 0 ? 1e60 : i % 89 == 0 ? 1e-60 : mag(rng));
+    }
+    for (int zero = 0; zero < 2; ++zero) {
+        if (zero) a[300] = T(0.0);
+        unsigned want_mul = 0, want_div = 0;
+        std::vector<T> prod(a.size()), quot(a.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            prod[i] = takum::internal::mul_div_ell<N, false>(a[i], b[i], want_mul);
+            quot[i] = takum::internal::mul_div_ell<N, true>(a[i], b[i], want_div);
+        }
+        takum::clear_flags();
+        takum::mul<N>(span_t<N>(a), span_t<N>(b), out);
+        EXPECT_EQ(takum::test_flags(), want_mul) << "N=" << N << " zero=" << zero;
+        for (size_t i = 0; i < a.size(); ++i) ASSERT_EQ(out[i].raw_bits(), prod[i].raw_bits()) << "N=" << N << " i=" << i;
+        takum::clear_flags();
+        takum::div<N>(span_t<N>(a), span_t<N>(b), out);
+        EXPECT_EQ(takum::test_flags(), want_div) << "N=" << N << " zero=" << zero;
+        for (size_t i = 0; i < a.size(); ++i) ASSERT_EQ(out[i].raw_bits(), quot[i].raw_bits()) << "N=" << N << " i=" << i;
+    }
+    takum::clear_flags();
+}
+
+template <size_t N>
+void expect_decoder_matches_to_double() {
+    std::mt19937_64 rng(N);
+    const takum::internal::add_decoder<N> dec;
+    for (size_t i = 0; i < kCount; ++i) {
+        const auto t = takum::takum<N>::from_raw_bits(static_cast<typename takum::takum<N>::storage_t>(rng() & ((uint64_t{1} << N) - 1)));
+        const double want = t.to_double();
+        const double got = dec(t);
+        if (std::isnan(want)) ASSERT_TRUE(std::isnan(got)) << "N=" << N << " i=" << i;
+        else ASSERT_EQ(std::bit_cast<uint64_t>(got), std::bit_cast<uint64_t>(want)) << "N=" << N << " i=" << i;
+    }
+}
+
+} // namespace
+
+TEST(Elementwise, AddDecoderMatchesToDouble) {
+    expect_decoder_matches_to_double<12>();
+    expect_decoder_matches_to_double<24>();
+    expect_decoder_matches_to_double<32>();
+}
+
+TEST(Elementwise, AddSubBitIdenticalToScalar) {
+    expect_add_sub_match_scalar<8>();
+    expect_add_sub_match_scalar<16>();
+    expect_add_sub_match_scalar<32>();
+    expect_add_sub_match_scalar<64>();
+}
+
+TEST(Elementwise, MulDivCorrectlyRoundedInEll) {
+    expect_mul_div_rounded<12>();
+    expect_mul_div_rounded<16>();
+    expect_mul_div_rounded<24>();
+    expect_mul_div_rounded<32>();
+}
+
+TEST(Elementwise, MulDivPassesMatchElementKernel) {
+    expect_passes_match_elementwise<12>();
+    expect_passes_match_elementwise<16>();
+    expect_passes_match_elementwise<32>();
+}
+
+TEST(Elementwise, MulDivFallbackWidthsMatchScalar) {
+    const auto a = operands<64>(3), b = operands<64>(4);
+    std::vector<takum::takum<64>> out(kCount);
+    takum::mul<64>(a, b, out);
+    for (size_t i = 0; i < kCount; ++i) ASSERT_EQ(out[i].raw_bits(), (a[i] * b[i]).raw_bits()) << i;
+    takum::div<64>(a, b, out);
+    for (size_t i = 0; i < kCount; ++i) ASSERT_EQ(out[i].raw_bits(), (a[i] / b[i]).raw_bits()) << i;
+}
+
+TEST(Elementwise, DivisionByZeroIsNaR) {
+    using T = takum32;
+    const std::vector<T> a{T(1.0), T(0.0), T(-3.0)};
+    std::vector<T> out(3);
+    takum::div<32>(span_t<32>(a), T(0.0), out);
+    for (const auto& t : out) EXPECT_TRUE(t.is_nar());
+}
+
+TEST(Elementwise, UnaryOpsAreExact) {
+    const auto a = operands<32>(5);
+    std::vector<takum32> n(kCount), m(kCount), r(kCount);
+    takum::neg<32>(a, n);
+    takum::abs<32>(a, m);
+    takum::recip<32>(a, r);
+    for (size_t i = 0; i < kCount; ++i) {
+        ASSERT_EQ(n[i].raw_bits(), (-a[i]).raw_bits()) << i;
+        ASSERT_EQ(m[i].raw_bits(), takum::abs(a[i]).raw_bits()) << i;
+        ASSERT_EQ(r[i].raw_bits(), a[i].reciprocal().raw_bits()) << i;
+    }
+    const std::vector<takum128> w{takum128(-2.5), takum128(0.0), takum128::nar()};
+    std::vector<takum128> wn(3), wa(3);
+    takum::neg<128>(w, wn);
+    takum::abs<128>(w, wa);
+    EXPECT_EQ(wn[0].to_double(), 2.5);
+    EXPECT_EQ(wa[0].to_double(), 2.5);
+    EXPECT_TRUE(wn[1].is_zero() && wa[1].is_zero());
+    EXPECT_TRUE(wn[2].is_nar() && wa[2].is_nar());
+}
+
+TEST(Elementwise, ScalarBroadcastMatchesSpan) {
+    const auto a = operands<16>(6);
+    const takum16 s(1.75);
+    const std::vector<takum16> ss(kCount, s);
+    std::vector<takum16> x(kCount), y(kCount);
+    takum::mul<16>(span_t<16>(a), s, x);
+    takum::mul<16>(a, ss, y);
+    for (size_t i = 0; i < kCount; ++i) ASSERT_EQ(x[i].raw_bits(), y[i].raw_bits()) << i;
+    takum::sub<16>(s, span_t<16>(a), x);
+    takum::sub<16>(ss, a, y);
+    for (size_t i = 0; i < kCount; ++i) ASSERT_EQ(x[i].raw_bits(), y[i].raw_bits()) << i;
+}
+
+TEST(Elementwise, StridedColumnsAndShortestLength) {
+    // 3×4 row-major matrix: add column 1 to column 3, writing into column 0.
+    std::vector<takum32> m(12);
+    for (size_t i = 0; i < m.size(); ++i) m[i] = takum32(static_cast<double>(i));
+    takum::add<32>(takum::strided_span<const takum32>{m.data() + 1, 3, 4},
+                   takum::strided_span<const takum32>{m.data() + 3, 3, 4},
+                   takum::strided_span<takum32>{m.data(), 3, 4});
+    for (size_t row = 0; row < 3; ++row) {
+        const takum32 lhs(static_cast<double>(4 * row + 1)), rhs(static_cast<double>(4 * row + 3));
+        EXPECT_EQ(m[4 * row].raw_bits(), (lhs + rhs).raw_bits()) << row;
+        EXPECT_EQ(m[4 * row + 2].to_double(), takum32(static_cast<double>(4 * row + 2)).to_double()) << row;
+    }
+
+    // Only min(sizes) elements are written.
+    const std::vector<takum32> a(5, takum32(2.0)), b(3, takum32(3.0));
+    std::vector<takum32> out(5, takum32(-1.0));
+    takum::mul<32>(a, b, out);
+    EXPECT_NEAR(out[2].to_double(), 6.0, 1e-6);
+    EXPECT_EQ(out[3].raw_bits(), takum32(-1.0).raw_bits());
+}
+
+TEST(Elementwise, InPlaceAliasing) {
+    std::vector<takum32> v{takum32(2.0), takum32(-8.0)};
+    takum::mul<32>(span_t<32>(v), takum32(0.5), v);
+    EXPECT_NEAR(v[0].to_double(), 1.0, 1e-6);
+    EXPECT_NEAR(v[1].to_double(), -4.0, 1e-6);
+}
+
+namespace {
+
+// Span error code vs the scalar safe_* result (kind only when it is std::expected).
+template <typename Result>
+bool code_matches(uint8_t code, const Result& r) {
+    if (r.has_value()) return code == 0;
+    if constexpr (requires { r.error(); }) return code == takum::error_bit(r.error().kind);
+    else return code != 0;
+}
+
+} // namespace
+
+TEST(ElementwiseSafe, CodesMatchScalarSafeVariants) {
+    const auto a = operands<32>(7), b = operands<32>(8);
+    std::vector<takum32> out(kCount);
+    std::vector<uint8_t> codes(kCount);
+    auto check = [&](const takum::safe_span_status& st, auto&& scalar_safe, auto&& unchecked) {
+        size_t first = takum::safe_span_status::npos, count = 0;
+        for (size_t i = 0; i < kCount; ++i) {
+            const auto expect = scalar_safe(a[i], b[i]);
+            ASSERT_TRUE(code_matches(codes[i], expect)) << i << " code=" << int(codes[i]);
+            ASSERT_EQ(out[i].raw_bits(), unchecked(a[i], b[i]).raw_bits()) << i;
+            if (!expect && first == takum::safe_span_status::npos) first = i;
+            count += !expect;
+        }
+        EXPECT_EQ(st.first_error, first);
+        EXPECT_EQ(st.error_count, count);
+        EXPECT_FALSE(bool(st));
+    };
+    check(takum::safe_add<32>(a, b, out, codes), [](auto x, auto y) { return takum::safe_add(x, y); },
+          [](auto x, auto y) { return x + y; });
+    check(takum::safe_mul<32>(a, b, out, codes), [](auto x, auto y) { return takum::safe_mul(x, y); },
+          [](auto x, auto y) { std::vector<takum32> r(1); takum::mul<32>(span_t<32>(&x, 1), y, r); return r[0]; });
+    check(takum::safe_div<32>(a, b, out, codes), [](auto x, auto y) { return takum::safe_div(x, y); },
+          [](auto x, auto y) { std::vector<takum32> r(1); takum::div<32>(span_t<32>(&x, 1), y, r); return r[0]; });
+}
+
+TEST(ElementwiseSafe, SummaryWithoutCodeBuffer) {
+    using T = takum16;
+    const std::vector<T> a{T(1.0), T(2.0), T(3.0), T(4.0)};
+    const std::vector<T> b{T(1.0), T(0.0), T::nar(), T(0.0)};
+    std::vector<T> out(4);
+    const auto st = takum::safe_div<16>(a, b, out);
+    EXPECT_EQ(st.first_error, 1u);
+    EXPECT_EQ(st.error_count, 3u);
+    EXPECT_EQ(st.kinds, takum::error_bit(takum::takum_error::Kind::DomainError) |
+                            takum::error_bit(takum::takum_error::Kind::InvalidOperation));
+    EXPECT_TRUE(out[1].is_nar() && out[2].is_nar() && out[3].is_nar());
+
+    const auto ok = takum::safe_mul<16>(span_t<16>(a), T(2.0), out);
+    EXPECT_TRUE(bool(ok));
+    EXPECT_EQ(ok.first_error, takum::safe_span_status::npos);
+}
+
+TEST(ElementwiseSafe, UnaryCodes) {
+    using T = takum32;
+    const std::vector<T> in{T(-2.0), T(0.0), T::nar()};
+    std::vector<T> out(3);
+    std::vector<uint8_t> codes(3, 0xFF);
+    EXPECT_EQ(takum::safe_recip<32>(in, out, codes).error_count, 2u);
+    EXPECT_EQ(codes[0], 0);
+    EXPECT_EQ(codes[1], takum::error_bit(takum::takum_error::Kind::DomainError));
+    EXPECT_EQ(codes[2], takum::error_bit(takum::takum_error::Kind::InvalidOperation));
+    const auto st = takum::safe_abs<32>(in, out, codes);
+    EXPECT_EQ(st.first_error, 2u);
+    EXPECT_EQ(codes[1], 0);
+    EXPECT_EQ(out[0].raw_bits(), T(2.0).raw_bits());
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "takum/format.h"
+
+namespace {
+
+template <size_t N>
+std::string fmt(std::string_view spec_text, const takum::takum<N>& x) {
+    takum::internal::format_spec spec;
+    const char* end = takum::internal::parse_format_spec(spec_text.data(), spec_text.data() + spec_text.size(), spec);
+    EXPECT_NE(end, nullptr) << spec_text;
+    std::string out;
+    takum::internal::format_to(std::back_inserter(out), x, spec);
+    return out;
+}
+
+} // namespace
+
+TEST(Format, SpecParsing) {
+    takum::internal::format_spec spec;
+    const std::string_view text = "*^+#012.3e}";
+    const char* end = takum::internal::parse_format_spec(text.data(), text.data() + text.size(), spec);
+    ASSERT_NE(end, nullptr);
+    EXPECT_EQ(*end, '}');
+    EXPECT_EQ(spec.fill, '*');
+    EXPECT_EQ(spec.align, '^');
+    EXPECT_EQ(spec.sign, '+');
+    EXPECT_TRUE(spec.alternate);
+    EXPECT_TRUE(spec.zero_pad);
+    EXPECT_EQ(spec.width, 12);
+    EXPECT_EQ(spec.precision, 3);
+    EXPECT_EQ(spec.type, 'e');
+
+    takum::internal::format_spec bad;
+    for (std::string_view s : {"q", ".x", "5.2eq"}) {
+        EXPECT_EQ(takum::internal::parse_format_spec(s.data(), s.data() + s.size(), bad), nullptr) << s;
+    }
+}
+
+TEST(Format, FloatingTypes) {
+    const takum::takum<32> x(1234.5678);
+    EXPECT_EQ(fmt("", x), "1234.5678");
+    EXPECT_EQ(fmt(".2f", x), "1234.57");
+    EXPECT_EQ(fmt("e", x), "1.234568e+03");
+    EXPECT_EQ(fmt(".1E", x), "1.2E+03");
+    EXPECT_EQ(fmt(".3", x), "1.23e+03");
+    EXPECT_EQ(fmt("+", x), "+1234.5678");
+    EXPECT_EQ(fmt("", takum::takum<32>::nar()), "NaR");
+}
+
+TEST(Format, TakumTypes) {
+    const takum::takum<16> x(1.0);
+    char hex[8];
+    auto r = std::to_chars(hex, hex + sizeof(hex), static_cast<uint64_t>(x.raw_bits()), 16);
+    EXPECT_EQ(fmt("x", x), std::string(hex, r.ptr));
+    EXPECT_EQ(fmt("#x", x), "0x" + std::string(hex, r.ptr));
+    EXPECT_EQ(fmt("l", x), "0");
+    // ℓ = 3: D=1, r=2 (R=2), C=0, p=9, M=0.
+    const auto three = takum::takum<16>::from_raw_bits(0x5000);
+    const auto minus_three = takum::takum<16>::from_raw_bits(0xD000);
+    EXPECT_EQ(fmt("l", minus_three), "-3");
+    EXPECT_EQ(fmt("l", takum::takum<16>(0.0)), "-inf");
+    EXPECT_EQ(fmt("v", three), "S=0 D=1 R=2 C=0 M=0x0 (c=3, p=9)");
+}
+
+TEST(Format, Padding) {
+    const takum::takum<32> x(-2.5);
+    EXPECT_EQ(fmt("8", x), "    -2.5");
+    EXPECT_EQ(fmt("<8", x), "-2.5    ");
+    EXPECT_EQ(fmt("*^8", x), "**-2.5**");
+    EXPECT_EQ(fmt("08", x), "-00002.5");
+    EXPECT_EQ(fmt("08", takum::takum<32>::nar()), "     NaR");
+}
+
+TEST(Format, StreamOutput) {
+    std::ostringstream os;
+    os << takum::takum<32>(0.1) << ' ' << std::fixed << std::setprecision(3) << takum::takum<32>(2.0) << ' '
+       << std::scientific << std::uppercase << takum::takum<32>(2.0) << ' ' << std::defaultfloat << std::nouppercase
+       << std::showpos << std::setw(6) << std::left << std::setfill('_') << takum::takum<32>(1.0);
+    EXPECT_EQ(os.str(), "0.1 2.000 2.000E+00 +1____");
+}
+
+TEST(Format, StreamRoundTrip) {
+    std::ostringstream os;
+    const takum::takum<48> values[] = {takum::takum<48>(3.14159), takum::takum<48>(-1e-30), takum::takum<48>::nar(),
+                                       takum::takum<48>(0.0)};
+    for (const auto& v : values) os << v << ' ';
+    std::istringstream is(os.str());
+    for (const auto& v : values) {
+        takum::takum<48> y;
+        ASSERT_TRUE(is >> y);
+        EXPECT_EQ(y.raw_bits(), v.raw_bits());
+    }
+    takum::takum<48> y;
+    std::istringstream bad("12x");
+    EXPECT_FALSE(bad >> y);
+    std::istringstream plus("+2");
+    ASSERT_TRUE(plus >> y);
+    EXPECT_EQ(y.raw_bits(), takum::takum<48>(2.0).raw_bits());
+}
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+TEST(Format, StdFormat) {
+    EXPECT_EQ(std::format("{}", takum::takum<32>(0.1)), "0.1");
+    EXPECT_EQ(std::format("{:>8.2f}|{:#x}", takum::takum<32>(2.5), takum::takum<16>(0.0)), "    2.50|0x0");
+}
+#endif
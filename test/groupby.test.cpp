@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "takum/groupby.h"
+#include "takum/types.h"
+
+#include "test_data.h"
+
+using namespace takum::types;
+
+namespace {
+
+struct reference_group {
+    uint64_t count = 0;
+    long double sum = 0;
+    double min = INFINITY, max = -INFINITY;
+    long double ell = 0;
+    bool negative = false, zero = false;
+    std::vector<double> xs;
+};
+
+// One NaR in fifty, otherwise lognormal magnitudes of either sign.
+template <size_t N>
+std::vector<takum::takum<N>> values(size_t n, uint64_t seed) {
+    std::lognormal_distribution<double> mag(0.0, 1.0);
+    return test_data::column<N>(n, seed, [&](std::mt19937_64& rng) {
+        const unsigned r = rng() % 50;
+        return r == 0 ? takum::takum<N>::nar() : takum::takum<N>((r & 1) ? -mag(rng) : mag(rng));
+    });
+}
+
+template <size_t N, typename Key>
+std::map<Key, reference_group> reference(const std::vector<takum::takum<N>>& v, const std::vector<Key>& keys) {
+    std::map<Key, reference_group> groups;
+    for (size_t i = 0; i < v.size(); ++i) {
+        auto& g = groups[keys[i]];
+        if (v[i].is_nar()) continue;
+        const double x = v[i].to_double();
+        ++g.count;
+        g.sum += x;
+        g.min = std::min(g.min, x);
+        g.max = std::max(g.max, x);
+        g.xs.push_back(x);
+        if (x == 0.0) {
+            g.zero = true;
+        } else {
+            g.ell += 2 * std::log(std::fabs(static_cast<long double>(x)));
+            g.negative ^= x < 0;
+        }
+    }
+    return groups;
+}
+
+double logsumexp(const std::vector<double>& xs) {
+    double m = -INFINITY;
+    for (double x : xs) m = std::max(m, x);
+    double s = 0;
+    for (double x : xs) s += std::exp(x - m);
+    return m + std::log(s);
+}
+
+template <size_t N, typename Key>
+void expect_matches_reference(const takum::group_result<N, Key>& r, const std::vector<takum::takum<N>>& v,
+                              const std::vector<Key>& keys, double rel) {
+    using T = takum::takum<N>;
+    const auto ref = reference<N>(v, keys);
+    ASSERT_EQ(r.size(), ref.size());
+    size_t g = 0;
+    for (const auto& [key, want] : ref) {
+        ASSERT_EQ(r.keys[g], key);
+        EXPECT_EQ(r.count[g], want.count) << key;
+        EXPECT_EQ(r.sum[g].raw_bits(), T(static_cast<double>(want.sum)).raw_bits()) << key;
+        EXPECT_EQ(r.min[g].to_double(), want.min) << key;
+        EXPECT_EQ(r.max[g].to_double(), want.max) << key;
+        EXPECT_EQ(r.mean[g].raw_bits(), T(static_cast<double>(want.sum / want.count)).raw_bits()) << key;
+        // Clamped so that saturated products stay finite doubles (and saturate the same way).
+        const double ell = std::clamp(static_cast<double>(want.ell), -1200.0, 1200.0);
+        const double prod = T((want.negative ? -1.0 : 1.0) * std::exp(ell / 2)).to_double();
+        EXPECT_NEAR(r.product[g].to_double() / prod, 1.0, rel) << key;
+        EXPECT_NEAR(r.logsumexp[g].to_double(), logsumexp(want.xs), rel * std::fabs(logsumexp(want.xs))) << key;
+        ++g;
+    }
+}
+
+} // namespace
+
+TEST(GroupBy, DenseMatchesReference16) {
+    const auto v = values<16>(2 * TAKUM_PARALLEL_GRAIN + 5, 16);
+    std::vector<uint32_t> ids(v.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<uint32_t>((i * 7919) % 13);
+    const auto r = takum::group_by<16>(v, std::span<const uint32_t>(ids), 13);
+    expect_matches_reference<16>(r, v, ids, 1e-2);
+}
+
+TEST(GroupBy, DenseMatchesReference32) {
+    const auto v = values<32>(2 * TAKUM_PARALLEL_GRAIN + 5, 32);
+    std::vector<uint32_t> ids(v.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<uint32_t>((i * 7919) % 5);
+    const auto r = takum::group_by<32>(v, std::span<const uint32_t>(ids), 5);
+    expect_matches_reference<32>(r, v, ids, 1e-6);
+}
+
+TEST(GroupBy, HashAndSortMatchReference) {
+    const auto v = values<32>(2 * TAKUM_PARALLEL_GRAIN + 5, 7);
+    // Keys 200 apart from each other take the dense table; spread out, the hash or sort.
+    for (int64_t spread : {int64_t{1}, int64_t{1000003}}) {
+        std::mt19937_64 rng(3);
+        std::vector<int64_t> keys(v.size());
+        for (auto& k : keys) k = (static_cast<int64_t>(rng() % 200) - 100) * spread;
+        for (auto strategy : {takum::group_strategy::hash, takum::group_strategy::sort}) {
+            const auto r = takum::group_by_key<32>(v, std::span<const int64_t>(keys), takum::agg_all, strategy);
+            expect_matches_reference<32>(r, v, keys, 1e-6);
+        }
+    }
+}
+
+TEST(GroupBy, DenseKeyRangeKeepsNaROnlyKeysAndSkipsGaps) {
+    const std::vector<takum32> v{takum32(1.0), takum32::nar(), takum32(2.0), takum32::nar(), takum32(3.0)};
+    const std::vector<int16_t> keys{-5, -3, -5, -3, -5}; // span 2 < 5 rows: dense table
+    const auto r = takum::group_by_key<32>(v, std::span<const int16_t>(keys));
+    EXPECT_EQ(r.keys, (std::vector<int16_t>{-5, -3}));
+    EXPECT_EQ(r.count, (std::vector<uint64_t>{3, 0}));
+    EXPECT_NEAR(r.sum[0].to_double(), 6.0, 1e-6);
+    EXPECT_TRUE(r.mean[1].is_nar());
+}
+
+TEST(GroupBy, Takum64SumsKeepFullPrecision) {
+    // A one-row group's sum and mean are the row bit for bit, which a trip
+    // through double would not give for a takum64 pattern.
+    if (sizeof(takum::internal::wide_float) == sizeof(double)) GTEST_SKIP() << "wide_float is double";
+    std::mt19937_64 rng(64);
+    std::vector<takum64> v(4096);
+    for (auto& t : v) t = takum64::from_raw_bits(rng() & 0x7FFFFFFFFFFFFFFFULL);
+    std::vector<uint32_t> ids(v.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<uint32_t>(i);
+    const auto r = takum::group_by<64>(v, std::span<const uint32_t>(ids), v.size(), takum::agg_sum | takum::agg_mean);
+    for (size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(r.sum[i].raw_bits(), v[i].raw_bits()) << i;
+        ASSERT_EQ(r.mean[i].raw_bits(), v[i].raw_bits()) << i;
+    }
+}
+
+TEST(GroupBy, MinMaxFollowValueOrder64) {
+    const auto v = values<64>(2 * TAKUM_PARALLEL_GRAIN + 5, 64);
+    std::vector<uint32_t> ids(v.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<uint32_t>((i * 7919) % 11);
+    const auto ref = reference<64>(v, ids);
+    const auto dense = takum::group_by<64>(v, std::span<const uint32_t>(ids), 11, takum::agg_min | takum::agg_max);
+    const auto hashed = takum::group_by_key<64>(v, std::span<const uint32_t>(ids), takum::agg_min | takum::agg_max);
+    for (const auto& r : {dense, hashed}) {
+        ASSERT_EQ(r.size(), ref.size());
+        size_t g = 0;
+        for (const auto& [key, want] : ref) {
+            EXPECT_EQ(r.min[g].to_double(), want.min) << key;
+            EXPECT_EQ(r.max[g].to_double(), want.max) << key;
+            ++g;
+        }
+    }
+}
+
+TEST(GroupBy, NaRRowsEmptyGroupsAndOutOfRangeIds) {
+    const std::vector<takum32> v{takum32(2.0), takum32::nar(), takum32(-3.0), takum32(5.0), takum32(0.0)};
+    const std::vector<int> ids{0, 1, 0, 7, -1};
+    const auto r = takum::group_by<32>(v, std::span<const int>(ids), 3);
+    ASSERT_EQ(r.size(), 3u);
+    EXPECT_EQ(r.keys, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(r.count, (std::vector<uint64_t>{2, 0, 0}));
+    EXPECT_NEAR(r.sum[0].to_double(), -1.0, 1e-6);
+    EXPECT_NEAR(r.product[0].to_double(), -6.0, 1e-5);
+    EXPECT_EQ(r.min[0].raw_bits(), takum32(-3.0).raw_bits());
+    EXPECT_EQ(r.max[0].raw_bits(), takum32(2.0).raw_bits());
+    // Group 1 only saw a NaR; group 2 nothing.
+    for (size_t g : {1u, 2u}) {
+        EXPECT_TRUE(r.sum[g].is_zero());
+        EXPECT_NEAR(r.product[g].to_double(), 1.0, 1e-6);
+        EXPECT_TRUE(r.min[g].is_nar());
+        EXPECT_TRUE(r.max[g].is_nar());
+        EXPECT_TRUE(r.mean[g].is_nar());
+        EXPECT_TRUE(r.logsumexp[g].is_nar());
+    }
+}
+
+TEST(GroupBy, ProductWorksInEllSpaceAndSaturates) {
+    // 1e30^5 is beyond the takum range; ℓ accumulates without overflow and saturates once.
+    const std::vector<takum32> big(5, takum32(1e30));
+    const std::vector<uint8_t> ids(5, 0);
+    takum::clear_flags();
+    const auto r = takum::group_by<32>(big, std::span<const uint8_t>(ids), 1, takum::agg_product);
+    EXPECT_TRUE(r.sum.empty());
+    ASSERT_EQ(r.product.size(), 1u);
+    EXPECT_FALSE(r.product[0].is_nar());
+    EXPECT_EQ(r.product[0].raw_bits(), takum32(1e150).raw_bits());
+    EXPECT_TRUE(takum::test_flags(takum::flag_overflow));
+
+    const std::vector<takum32> with_zero{takum32(3.0), takum32(0.0), takum32(-4.0)};
+    const std::vector<uint8_t> zero_ids(3, 0);
+    EXPECT_TRUE(takum::group_by<32>(with_zero, std::span<const uint8_t>(zero_ids), 1, takum::agg_product).product[0].is_zero());
+}
+
+TEST(GroupBy, SelectedAggregatesOnly) {
+    const std::vector<takum16> v{takum16(1.0), takum16(2.0), takum16(4.0)};
+    const std::vector<uint16_t> keys{9, 3, 9};
+    const auto r = takum::group_by_key<16>(v, std::span<const uint16_t>(keys), takum::agg_count | takum::agg_max,
+                                           takum::group_strategy::sort);
+    EXPECT_EQ(r.keys, (std::vector<uint16_t>{3, 9}));
+    EXPECT_EQ(r.count, (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(r.max[1].raw_bits(), takum16(4.0).raw_bits());
+    EXPECT_TRUE(r.sum.empty() && r.min.empty() && r.mean.empty() && r.product.empty() && r.logsumexp.empty());
+}
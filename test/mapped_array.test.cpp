@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "takum/mapped_array.h"
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<takum::takum<32>> ramp(size_t n) {
+    std::vector<takum::takum<32>> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = takum::takum<32>(std::sin(0.01 * static_cast<double>(i)) * 1e3);
+    return v;
+}
+
+} // namespace
+
+TEST(MappedArray, WriteThenMapZeroCopy) {
+    const auto path = temp_path("takum_mapped_basic.tka");
+    auto data = ramp(3700);
+    data[5] = takum::takum<32>::nar();
+    const std::vector<uint64_t> shape = {100, 37};
+    {
+        auto w = takum::mapped_array_writer<32>::create(path, shape, 1000);
+        ASSERT_TRUE(w.has_value());
+        // Streamed in uneven chunks.
+        ASSERT_TRUE(w->append(std::span<const takum::takum<32>>(data).first(1234)));
+        ASSERT_TRUE(w->append(data[1234]));
+        ASSERT_TRUE(w->append(std::span<const takum::takum<32>>(data).subspan(1235)));
+        auto n = w->finish();
+        ASSERT_TRUE(n.has_value());
+        EXPECT_EQ(*n, data.size());
+    }
+
+    auto m = takum::mapped_array<32>::open(path);
+    ASSERT_TRUE(m.has_value());
+    EXPECT_TRUE(m->zero_copy());
+    ASSERT_EQ(m->size(), data.size());
+    EXPECT_TRUE(std::ranges::equal(m->shape(), shape));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(m->values().data()) % 64, 0u);
+    for (size_t i = 0; i < data.size(); ++i) ASSERT_EQ((*m)[i].raw_bits(), data[i].raw_bits()) << "i=" << i;
+
+    ASSERT_TRUE(m->has_block_index());
+    ASSERT_EQ(m->block_count(), 4u);
+    for (size_t b = 0; b < m->block_count(); ++b) {
+        const auto first = data.begin() + static_cast<std::ptrdiff_t>(b * 1000);
+        const auto last = data.begin() + static_cast<std::ptrdiff_t>(std::min(data.size(), (b + 1) * 1000));
+        std::vector<double> reals;
+        for (auto it = first; it != last; ++it) {
+            if (!it->is_nar()) reals.push_back(it->to_double());
+        }
+        const auto s = m->block(b);
+        EXPECT_EQ(s.nar_count, static_cast<uint64_t>((last - first) - static_cast<std::ptrdiff_t>(reals.size())));
+        EXPECT_EQ(s.min.to_double(), std::ranges::min(reals));
+        EXPECT_EQ(s.max.to_double(), std::ranges::max(reals));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MappedArray, BlockIndexOrdersNegativesByValue) {
+    const auto path = temp_path("takum_mapped_negatives.tka");
+    const std::vector<takum::takum<32>> data{takum::takum<32>(-1.0), takum::takum<32>(-2.0),
+                                             takum::takum<32>(-3.0), takum::takum<32>(0.5)};
+    {
+        const std::vector<uint64_t> shape = {data.size()};
+        auto w = takum::mapped_array_writer<32>::create(path, shape, 4);
+        ASSERT_TRUE(w.has_value());
+        ASSERT_TRUE(w->append(data));
+        ASSERT_TRUE(w->finish().has_value());
+    }
+    auto m = takum::mapped_array<32>::open(path);
+    ASSERT_TRUE(m.has_value());
+    ASSERT_EQ(m->block_count(), 1u);
+    EXPECT_EQ(m->block(0).min.raw_bits(), data[2].raw_bits());
+    EXPECT_EQ(m->block(0).max.raw_bits(), data[3].raw_bits());
+    std::filesystem::remove(path);
+}
+
+TEST(MappedArray, ForeignByteOrderIsSwapped) {
+    const auto path = temp_path("takum_mapped_swapped.tka");
+    auto data = ramp(50);
+    takum::internal::tka_header h;
+    h.byte_order = takum::internal::native_byte_order() == 1 ? 2 : 1;
+    h.width = 32;
+    h.element_bytes = 4;
+    h.count = data.size();
+    h.shape = {data.size()};
+    h.data_offset = takum::internal::tka_data_offset(1);
+    auto bytes = takum::internal::tka_encode_header(h);
+    for (const auto& t : data) {
+        const uint32_t v = t.raw_bits();
+        for (int k = 3; k >= 0; --k) bytes.push_back(static_cast<uint8_t>(v >> (8 * k)));
+    }
+    if (h.byte_order == 1) { // foreign is little-endian: re-swap to LE
+        for (size_t i = h.data_offset; i < bytes.size(); i += 4) std::reverse(bytes.begin() + i, bytes.begin() + i + 4);
+    }
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+    auto m = takum::mapped_array<32>::open(path);
+    ASSERT_TRUE(m.has_value());
+    EXPECT_FALSE(m->zero_copy());
+    EXPECT_FALSE(m->has_block_index());
+    for (size_t i = 0; i < data.size(); ++i) EXPECT_EQ((*m)[i].raw_bits(), data[i].raw_bits());
+    std::filesystem::remove(path);
+}
+
+TEST(MappedArray, RejectsBadFiles) {
+    const auto path = temp_path("takum_mapped_bad.tka");
+    auto data = ramp(10);
+    {
+        auto w = takum::mapped_array_writer<32>::create(path, {}, 0);
+        ASSERT_TRUE(w.has_value());
+        ASSERT_TRUE(w->append(std::span<const takum::takum<32>>(data)));
+        ASSERT_TRUE(w->finish().has_value());
+    }
+    EXPECT_FALSE(takum::mapped_array<16>::open(path).has_value()); // wrong N
+    auto ok = takum::mapped_array<32>::open(path);
+    ASSERT_TRUE(ok.has_value());
+    EXPECT_EQ(ok->shape().size(), 1u);
+    EXPECT_FALSE(ok->has_block_index());
+
+    // Corrupt the element count: header checksum must fail.
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(16);
+        f.put(static_cast<char>(11));
+    }
+    EXPECT_FALSE(takum::mapped_array<32>::open(path).has_value());
+    EXPECT_FALSE(takum::mapped_array<32>::open(temp_path("takum_mapped_missing.tka")).has_value());
+
+    // Declared shape must match what was appended.
+    const std::vector<uint64_t> shape = {4, 4};
+    auto w = takum::mapped_array_writer<32>::create(path, shape);
+    ASSERT_TRUE(w.has_value());
+    ASSERT_TRUE(w->append(std::span<const takum::takum<32>>(data)));
+    EXPECT_FALSE(w->finish().has_value());
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,42 @@
+// Exercises the `takum` module's exports. Built twice: with
+// TAKUM_MODULE_CHECK_IMPORT=1 through `import takum;`, otherwise through the
+// headers, so the two builds can be timed against each other.
+
+#if TAKUM_MODULE_CHECK_IMPORT
+import takum;
+#else
+#include "takum/arithmetic.h"
+#include "takum/config.h"
+#include "takum/precision_traits.h"
+#include "takum/types.h"
+#include "takum/internal/phi_eval.h"
+#endif
+
+namespace {
+
+template <typename T>
+bool near(T got, double want, double rel) {
+    const double d = got.to_double() - want;
+    return (d < 0 ? -d : d) <= rel * (want < 0 ? -want : want);
+}
+
+} // namespace
+
+int main() {
+    using namespace takum::types;
+    int failures = 0;
+    const takum32 a(1.5), b(2.25);
+    failures += !near(a + b, 3.75, 1e-6);
+    failures += !near(a * b, 3.375, 1e-6);
+    failures += !near(b / a, 1.5, 1e-6);
+    failures += !near(takum::abs(-a), 1.5, 1e-6);
+    failures += !near(takum64(3.0) - takum64(1.5), 1.5, 1e-9);
+    failures += !takum::safe_div(a, takum32(0.0)).has_value() ? 0 : 1;
+    failures += takum::precision::effective_p<32>() > 0 ? 0 : 1;
+    failures += takum::internal::phi::phi_eval<16>(0.0L).value > 0 ? 0 : 1;
+    // Φ works in double exactly when the build has no long double.
+    using phi_value = decltype(takum::internal::phi::phi_eval<16>(0.0L).value);
+    failures += takum::config::no_long_double() == (sizeof(phi_value) == sizeof(double)) ? 0 : 1;
+    failures += takum16::nar().is_nar() ? 0 : 1;
+    return failures == 0 ? 0 : 1;
+}
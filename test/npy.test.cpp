@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "takum/npy.h"
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+template <size_t N>
+std::vector<takum::takum<N>> sample(size_t n) {
+    std::vector<takum::takum<N>> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = takum::takum<N>(std::exp(std::sin(0.1 * static_cast<double>(i)) * 5.0) - 1.0);
+    return v;
+}
+
+std::vector<uint8_t> read_all(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+}
+
+// Hand-built .npy with the given descr and payload, as NumPy would write it.
+void write_npy(const std::string& path, const std::string& descr, const std::string& shape, const void* data, size_t bytes) {
+    std::string dict = "{'descr': " + descr + ", 'fortran_order': False, 'shape': " + shape + ", }";
+    while ((10 + dict.size() + 1) % 64) dict += ' ';
+    dict += '\n';
+    std::ofstream f(path, std::ios::binary);
+    f.write("\x93NUMPY\x01\x00", 8);
+    const char len[2] = {static_cast<char>(dict.size() & 0xFF), static_cast<char>(dict.size() >> 8)};
+    f.write(len, 2);
+    f.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+    f.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+}
+
+void put(std::vector<uint8_t>& out, uint64_t v, int bytes) {
+    for (int k = 0; k < bytes; ++k) out.push_back(static_cast<uint8_t>(v >> (8 * k)));
+}
+
+// One stored member "a.npy" holding @p npy; the central entry's sizes, local
+// offset and extra field are given so they can be made inconsistent.
+std::vector<uint8_t> zip_one(const std::vector<uint8_t>& npy, uint32_t sizes, uint32_t local,
+                             const std::vector<uint8_t>& extra) {
+    std::vector<uint8_t> z;
+    put(z, 0x04034b50, 4);
+    put(z, 20, 2);
+    put(z, 0, 8); // flags, method, time, date
+    put(z, 0, 4); // crc (not checked)
+    put(z, npy.size(), 4);
+    put(z, npy.size(), 4);
+    put(z, 5, 2);
+    put(z, 0, 2);
+    z.insert(z.end(), {'a', '.', 'n', 'p', 'y'});
+    z.insert(z.end(), npy.begin(), npy.end());
+    const size_t cd = z.size();
+    put(z, 0x02014b50, 4);
+    put(z, 20, 2);
+    put(z, 20, 2);
+    put(z, 0, 8);
+    put(z, 0, 4);
+    put(z, sizes, 4);
+    put(z, sizes, 4);
+    put(z, 5, 2);
+    put(z, extra.size(), 2);
+    put(z, 0, 6); // comment, disk, internal attributes
+    put(z, 0, 4); // external attributes
+    put(z, local, 4);
+    z.insert(z.end(), {'a', '.', 'n', 'p', 'y'});
+    z.insert(z.end(), extra.begin(), extra.end());
+    const size_t cd_size = z.size() - cd;
+    put(z, 0x06054b50, 4);
+    put(z, 0, 4);
+    put(z, 1, 2);
+    put(z, 1, 2);
+    put(z, cd_size, 4);
+    put(z, cd, 4);
+    put(z, 0, 2);
+    return z;
+}
+
+} // namespace
+
+TEST(Npy, StructuredRoundTripIsZeroCopy) {
+    const auto path = temp_path("takum_npy_structured.npy");
+    auto data = sample<32>(120);
+    const std::vector<uint64_t> shape = {10, 12};
+    ASSERT_TRUE(takum::io::save_npy<32>(path, data, shape).has_value());
+
+    const auto bytes = read_all(path);
+    const std::string head(bytes.begin(), bytes.begin() + 128);
+    EXPECT_NE(head.find("[('takum32', '<u4')]"), std::string::npos);
+    EXPECT_NE(head.find("'shape': (10, 12)"), std::string::npos);
+
+    auto back = takum::io::load_npy<32>(path);
+    ASSERT_TRUE(back.has_value());
+    EXPECT_EQ(back->zero_copy(), std::endian::native == std::endian::little);
+    EXPECT_TRUE(std::ranges::equal(back->shape(), shape));
+    for (size_t i = 0; i < data.size(); ++i) EXPECT_EQ((*back)[i].raw_bits(), data[i].raw_bits());
+
+    EXPECT_FALSE(takum::io::load_npy<24>(path).has_value()); // width recorded in the dtype
+    std::filesystem::remove(path);
+}
+
+TEST(Npy, RawNarrowPatterns) {
+    const auto path = temp_path("takum_npy_raw.npy");
+    auto data = sample<12>(33);
+    ASSERT_TRUE(takum::io::save_npy<12>(path, data, {}, takum::io::npy_layout::raw).has_value());
+    const auto bytes = read_all(path);
+    EXPECT_NE(std::string(bytes.begin(), bytes.begin() + 64).find("'descr': '<u2'"), std::string::npos);
+    EXPECT_EQ((bytes.size() - 33u * 2u) % 64u, 0u); // data starts on a 64-byte boundary
+
+    auto back = takum::io::load_npy<12>(path);
+    ASSERT_TRUE(back.has_value());
+    EXPECT_FALSE(back->zero_copy()); // u2 differs from takum<12>'s 32-bit storage
+    ASSERT_EQ(back->size(), data.size());
+    ASSERT_EQ(back->shape().size(), 1u);
+    for (size_t i = 0; i < data.size(); ++i) EXPECT_EQ((*back)[i].raw_bits(), data[i].raw_bits());
+    std::filesystem::remove(path);
+}
+
+TEST(Npy, RejectsPatternItemSizeOfOtherWidth) {
+    const auto path = temp_path("takum_npy_item_size.npy");
+    const uint16_t u2[3] = {1, 2, 3};
+    write_npy(path, "'<u2'", "(3,)", u2, sizeof u2);
+    EXPECT_TRUE(takum::io::load_npy<16>(path).has_value());
+    EXPECT_FALSE(takum::io::load_npy<32>(path).has_value()); // not 32-bit patterns
+    EXPECT_FALSE(takum::io::load_npy<8>(path).has_value());
+
+    const uint32_t u4[1] = {1};
+    write_npy(path, "[('takum32', '<u4')]", "(1,)", u4, sizeof u4);
+    EXPECT_TRUE(takum::io::load_npy<32>(path).has_value());
+    const uint64_t u8[1] = {1};
+    write_npy(path, "'<u8'", "(1,)", u8, sizeof u8);
+    EXPECT_FALSE(takum::io::load_npy<32>(path).has_value());
+    std::filesystem::remove(path);
+}
+
+TEST(Npy, MasksPatternBitsAboveN) {
+    const auto path = temp_path("takum_npy_stray_bits.npy");
+    const uint32_t u4[2] = {0xFF400000u, 0x00400000u};
+    write_npy(path, "[('takum24', '<u4')]", "(2,)", u4, sizeof u4);
+    auto back = takum::io::load_npy<24>(path);
+    ASSERT_TRUE(back.has_value());
+    EXPECT_FALSE(back->zero_copy());
+    EXPECT_EQ((*back)[0].raw_bits(), 0x400000u);
+    EXPECT_EQ((*back)[1].raw_bits(), 0x400000u);
+
+    write_npy(path, "[('takum24', '<u4')]", "(1,)", u4 + 1, 4);
+    auto clean = takum::io::load_npy<24>(path);
+    ASSERT_TRUE(clean.has_value());
+    EXPECT_EQ(clean->zero_copy(), std::endian::native == std::endian::little);
+    std::filesystem::remove(path);
+}
+
+TEST(Npy, LoadsFloatArraysThroughBatchEncoder) {
+    const auto path = temp_path("takum_npy_f8.npy");
+    std::vector<double> f8 = {0.0, 1.0, -2.5, 1e10, std::nan("")};
+    write_npy(path, "'<f8'", "(5,)", f8.data(), f8.size() * 8);
+    auto t = takum::io::load_npy<24>(path);
+    ASSERT_TRUE(t.has_value());
+    for (size_t i = 0; i < f8.size(); ++i) EXPECT_EQ((*t)[i].raw_bits(), takum::takum<24>(f8[i]).raw_bits());
+
+    std::vector<float> f4 = {0.5f, -3.0f};
+    write_npy(path, "'<f4'", "(2,)", f4.data(), f4.size() * 4);
+    auto s = takum::io::load_npy<16>(path);
+    ASSERT_TRUE(s.has_value());
+    EXPECT_EQ((*s)[1].raw_bits(), takum::takum<16>(-3.0).raw_bits());
+
+    // Big-endian float64 is swapped on load.
+    std::vector<uint8_t> be(8);
+    uint64_t bits;
+    const double two = 2.0;
+    std::memcpy(&bits, &two, 8);
+    for (int k = 0; k < 8; ++k) be[static_cast<size_t>(k)] = static_cast<uint8_t>(bits >> (8 * (7 - k)));
+    write_npy(path, "'>f8'", "(1,)", be.data(), be.size());
+    auto b = takum::io::load_npy<32>(path);
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ((*b)[0].raw_bits(), takum::takum<32>(2.0).raw_bits());
+
+    write_npy(path, "'<i4'", "(1,)", be.data(), 4);
+    EXPECT_FALSE(takum::io::load_npy<32>(path).has_value());
+    std::filesystem::remove(path);
+}
+
+TEST(Npy, NpzRoundTrip) {
+    const auto path = temp_path("takum_npz_round.npz");
+    auto a = sample<32>(64);
+    auto b = sample<32>(7);
+    std::vector<takum::io::npz_entry<32>> entries = {
+        {"weights", a, {8, 8}},
+        {"bias", b, {}},
+    };
+    auto written = takum::io::save_npz<32>(path, std::span<const takum::io::npz_entry<32>>(entries));
+    ASSERT_TRUE(written.has_value());
+
+    auto names = takum::io::list_npz(path);
+    ASSERT_TRUE(names.has_value());
+    EXPECT_EQ(*names, (std::vector<std::string>{"weights", "bias"}));
+
+    auto w = takum::io::load_npz<32>(path, "weights");
+    ASSERT_TRUE(w.has_value());
+    EXPECT_EQ(w->shape().size(), 2u);
+    for (size_t i = 0; i < a.size(); ++i) EXPECT_EQ((*w)[i].raw_bits(), a[i].raw_bits());
+    auto bias = takum::io::load_npz<32>(path, "bias.npy");
+    ASSERT_TRUE(bias.has_value());
+    ASSERT_EQ(bias->size(), b.size());
+    EXPECT_EQ((*bias)[6].raw_bits(), b[6].raw_bits());
+    EXPECT_FALSE(takum::io::load_npz<32>(path, "missing").has_value());
+    std::filesystem::remove(path);
+}
+
+TEST(Npy, NpzRejectsInconsistentZip64Fields) {
+    const auto path = temp_path("takum_npz_zip64.npz");
+    auto a = sample<32>(4);
+    const auto npy = takum::io::internal::npy_image<32>(a, {}, takum::io::npy_layout::structured);
+    auto load = [&](const std::vector<uint8_t>& z) {
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(z.data()),
+                                                    static_cast<std::streamsize>(z.size()));
+        return takum::io::load_npz<32>(path, "a").has_value();
+    };
+    const auto size = static_cast<uint32_t>(npy.size());
+    EXPECT_TRUE(load(zip_one(npy, size, 0, {})));
+
+    // Zip64 sizes: the field must hold every value marked 0xFFFFFFFF.
+    std::vector<uint8_t> sizes64;
+    put(sizes64, 0x0001, 2);
+    put(sizes64, 16, 2);
+    put(sizes64, npy.size(), 8);
+    put(sizes64, npy.size(), 8);
+    EXPECT_TRUE(load(zip_one(npy, 0xFFFFFFFF, 0, sizes64)));
+    std::vector<uint8_t> short64;
+    put(short64, 0x0001, 2);
+    put(short64, 8, 2);
+    put(short64, npy.size(), 8);
+    EXPECT_FALSE(load(zip_one(npy, 0xFFFFFFFF, 0, short64))); // csize would be read past the field
+
+    std::vector<uint8_t> overlong;
+    put(overlong, 0x5455, 2);
+    put(overlong, 64, 2); // longer than the extra field
+    EXPECT_FALSE(load(zip_one(npy, size, 0, overlong)));
+
+    // A local header offset near 2^64 must not wrap the range checks.
+    std::vector<uint8_t> far;
+    put(far, 0x0001, 2);
+    put(far, 8, 2);
+    put(far, ~uint64_t{0} - 8, 8);
+    EXPECT_FALSE(load(zip_one(npy, size, 0xFFFFFFFF, far)));
+    std::filesystem::remove(path);
+}
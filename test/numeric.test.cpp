@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "takum/numeric.h"
+#include "takum/types.h"
+
+#include "test_data.h"
+
+using namespace takum::types;
+using takum::scan_carry;
+
+namespace {
+
+// Prefix sums against a long double running sum of the decoded inputs.
+template <size_t N>
+void expect_sums_match(double rel) {
+    using T = takum::takum<N>;
+    const auto v = test_data::uniform<N>(3 * takum::scan_block + 17, N, 0.5, 2.0);
+    std::vector<T> inc(v.size()), exc(v.size());
+    for (scan_carry carry : {scan_carry::wide, scan_carry::compensated}) {
+        takum::inclusive_scan<N>(v, inc, carry);
+        takum::exclusive_scan<N>(v, exc, carry);
+        EXPECT_TRUE(exc[0].is_zero());
+        long double ref = 0;
+        for (size_t i = 0; i < v.size(); ++i) {
+            if (i > 0) {
+                ASSERT_NEAR(exc[i].to_double(), static_cast<double>(ref), rel * static_cast<double>(ref)) << i;
+            }
+            ref += v[i].to_double();
+            ASSERT_NEAR(inc[i].to_double(), static_cast<double>(ref), rel * static_cast<double>(ref)) << i;
+        }
+    }
+}
+
+} // namespace
+
+TEST(PrefixScan, SumsMatchWideReference) {
+    expect_sums_match<16>(2e-3);
+    expect_sums_match<32>(1e-6);
+    expect_sums_match<64>(1e-12);
+}
+
+TEST(PrefixScan, Takum64SumsKeepFullPrecision) {
+    // x + 0 is x: the wide carry is decoded and rounded without narrowing
+    // to double, which would lose the low bits of a takum64 pattern.
+    if (sizeof(takum::internal::wide_float) == sizeof(double)) GTEST_SKIP() << "wide_float is double";
+    std::mt19937_64 rng(8);
+    std::vector<takum64> v(2), out(2);
+    for (int i = 0; i < 1000; ++i) {
+        v[0] = takum64::from_raw_bits(rng());
+        if (v[0].is_nar()) continue;
+        takum::inclusive_scan<64>(v, out);
+        ASSERT_EQ(out[0].raw_bits(), v[0].raw_bits()) << i;
+        ASSERT_EQ(out[1].raw_bits(), v[0].raw_bits()) << i;
+    }
+}
+
+TEST(PrefixScan, CompensatedCarryKeepsLowOrderTerms) {
+    const std::vector<takum32> v{takum32(1.0), takum32(1e40), takum32(1.0), takum32(-1e40)};
+    std::vector<takum32> out(v.size());
+    takum::inclusive_scan<32>(v, out);
+    EXPECT_TRUE(out[3].is_zero());
+    takum::inclusive_scan<32>(v, out, scan_carry::compensated);
+    EXPECT_EQ(out[3].raw_bits(), takum32(2.0).raw_bits());
+    EXPECT_EQ(out[2].raw_bits(), takum32(1e40).raw_bits());
+}
+
+TEST(PrefixScan, InPlaceMatchesOutOfPlace) {
+    const auto v = test_data::uniform<32>(2 * takum::scan_block + 5, 7, 0.5, 2.0);
+    std::vector<takum32> out(v.size()), in_place = v;
+    takum::exclusive_scan<32>(v, out);
+    takum::exclusive_scan<32>(in_place, in_place);
+    EXPECT_EQ(out, in_place);
+    takum::inclusive_product_scan<32>(v, out);
+    in_place = v;
+    takum::inclusive_product_scan<32>(in_place, in_place);
+    EXPECT_EQ(out, in_place);
+}
+
+TEST(PrefixScan, NaRPoisonsLaterOutputs) {
+    std::vector<takum16> v(10, takum16(1.5));
+    v[4] = takum16::nar();
+    std::vector<takum16> sum(v.size()), prod(v.size());
+    takum::inclusive_scan<16>(v, sum);
+    takum::exclusive_product_scan<16>(v, prod);
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(sum[i].is_nar(), i >= 4) << i;
+        EXPECT_EQ(prod[i].is_nar(), i >= 5) << i;
+    }
+}
+
+TEST(PrefixScan, NaRRaisesOnlyTheNaRFlag) {
+    // Like operator+: a NaR operand is not an invalid operation.
+    takum::flags_guard guard;
+    const std::vector<takum64> v{takum64::nar(), takum64(0.0)};
+    std::vector<takum64> out(v.size());
+    takum::clear_flags();
+    takum::inclusive_scan<64>(v, out, scan_carry::compensated);
+    EXPECT_TRUE(out[0].is_nar() && out[1].is_nar());
+    EXPECT_EQ(takum::test_flags(), unsigned{takum::flag_nar});
+    const std::vector<takum32> w{takum32(0.0), takum32::nar()};
+    std::vector<takum32> out32(w.size());
+    takum::clear_flags();
+    takum::exclusive_scan<32>(w, out32);
+    EXPECT_TRUE(out32[0].is_zero() && !out32[1].is_nar());
+    EXPECT_EQ(takum::test_flags(), 0u);
+    takum::inclusive_scan<32>(w, out32);
+    EXPECT_TRUE(out32[1].is_nar());
+    const unsigned scan_flags = takum::test_flags();
+    takum::clear_flags();
+    (void)(w[0] + w[1]);
+    EXPECT_EQ(scan_flags, takum::test_flags());
+}
+
+TEST(ProductScan, IntegerEllCarryIsExact) {
+    // ℓ in multiples of 1/8 is exact in takum32, so every prefix product is
+    // exactly from_ell(parity, Σℓ) while Σℓ is in range.
+    std::mt19937_64 rng(11);
+    const size_t n = 2 * takum::scan_block + 99;
+    std::vector<takum32> v(n), out(n);
+    std::vector<double> ell(n);
+    for (size_t i = 0; i < n; ++i) {
+        ell[i] = static_cast<double>(static_cast<int>(rng() % 33) - 16) / 8.0;
+        v[i] = takum32::from_ell(rng() % 3 == 0, ell[i]);
+    }
+    takum::inclusive_product_scan<32>(v, out);
+    double sum = 0;
+    bool negative = false;
+    for (size_t i = 0; i < n; ++i) {
+        sum += ell[i];
+        negative ^= v[i].signbit();
+        if (std::fabs(sum) < 200) {
+            ASSERT_EQ(out[i].raw_bits(), takum32::from_ell(negative, sum).raw_bits()) << i;
+        }
+    }
+}
+
+TEST(ProductScan, FixedEllCarryIsExactTo64Bits) {
+    // ℓ of a random pattern is carried exactly, so a one-element product scan
+    // reproduces it, and sums of ℓ in multiples of 1/8 round exactly.
+    std::mt19937_64 rng(12);
+    auto round_trip = [&]<size_t N>() {
+        using T = takum::takum<N>;
+        for (int i = 0; i < 20000; ++i) {
+            const T x = T::from_raw_bits(rng() & ((uint64_t{1} << (N - 1) << 1) - 1u));
+            T out;
+            takum::inclusive_product_scan<N>(std::span<const T>(&x, 1), std::span<T>(&out, 1));
+            ASSERT_EQ(out.raw_bits(), x.raw_bits()) << "N=" << N << " i=" << i;
+        }
+    };
+    round_trip.operator()<33>();
+    round_trip.operator()<48>();
+    round_trip.operator()<64>();
+
+    const size_t n = 2 * takum::scan_block + 99;
+    std::vector<takum64> v(n), out(n);
+    std::vector<double> ell(n);
+    for (size_t i = 0; i < n; ++i) {
+        ell[i] = static_cast<double>(static_cast<int>(rng() % 33) - 16) / 8.0;
+        v[i] = takum64::from_ell(rng() % 3 == 0, ell[i]);
+    }
+    takum::inclusive_product_scan<64>(v, out);
+    double sum = 0;
+    bool negative = false;
+    for (size_t i = 0; i < n; ++i) {
+        sum += ell[i];
+        negative ^= v[i].signbit();
+        if (std::fabs(sum) < 200) {
+            ASSERT_EQ(out[i].raw_bits(), takum64::from_ell(negative, sum).raw_bits()) << i;
+        }
+    }
+}
+
+TEST(ProductScan, SaturatesAndRecoversExactly) {
+    // 4000 factors of e^40 overflow far past the range; as many of e^-40 bring
+    // the exact product back to 1.
+    std::vector<takum32> v(8000, takum32::from_ell(false, 80.0));
+    std::fill(v.begin() + 4000, v.end(), takum32::from_ell(false, -80.0));
+    std::vector<takum32> out(v.size());
+    takum::flags_guard guard;
+    takum::inclusive_product_scan<32>(v, out);
+    EXPECT_TRUE(takum::test_flags(takum::flag_overflow));
+    EXPECT_EQ(out[10].raw_bits(), out[3999].raw_bits());
+    EXPECT_FALSE(out[3999].is_nar());
+    EXPECT_EQ(out.back().raw_bits(), takum32(1.0).raw_bits());
+
+    std::vector<takum64> w(8000, takum64::from_ell(false, 80.0));
+    std::fill(w.begin() + 4000, w.end(), takum64::from_ell(false, -80.0));
+    std::vector<takum64> out64(w.size());
+    takum::clear_flags();
+    takum::inclusive_product_scan<64>(w, out64);
+    EXPECT_TRUE(takum::test_flags(takum::flag_overflow));
+    EXPECT_EQ(out64[3999].raw_bits(), takum64::from_raw_bits(takum64::nar().raw_bits() - 1).raw_bits());
+    EXPECT_EQ(out64.back().raw_bits(), takum64::from_ell(false, 0.0).raw_bits());
+}
+
+TEST(ProductScan, ZerosSignsAndFloatEllWidths) {
+    const std::vector<double> x{2.0, -0.5, 3.0, -1.25, 0.0, 7.0};
+    std::vector<takum16> v16;
+    std::vector<takum64> v64;
+    for (double d : x) {
+        v16.emplace_back(d);
+        v64.emplace_back(d);
+    }
+    std::vector<takum16> out16(x.size());
+    std::vector<takum64> out64(x.size()), exc64(x.size());
+    takum::inclusive_product_scan<16>(v16, out16);
+    takum::inclusive_product_scan<64>(v64, out64, scan_carry::compensated);
+    takum::exclusive_product_scan<64>(v64, exc64);
+    EXPECT_EQ(exc64[0].raw_bits(), takum64(1.0).raw_bits());
+    double ref = 1;
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (i > 0) {
+            EXPECT_NEAR(exc64[i].to_double(), ref, 1e-12 * std::fabs(ref)) << i;
+        }
+        ref *= v64[i].to_double();
+        EXPECT_NEAR(out64[i].to_double(), ref, 1e-12 * std::fabs(ref)) << i;
+        EXPECT_NEAR(out16[i].to_double(), ref, 2e-3 * std::fabs(ref)) << i;
+    }
+    EXPECT_TRUE(out16[5].is_zero());
+    EXPECT_TRUE(out64[4].is_zero());
+    EXPECT_TRUE(out16[3].signbit() == false && out16[1].signbit());
+}
+
+TEST(ProductScan, WideEllMatchesPatterns64) {
+    // ℓ read from the bits round-trips through from_ell, so a one-element
+    // product scan reproduces its input.
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> ell(-250.0, 250.0);
+    std::vector<takum64> v(1000), out(1000);
+    for (auto& t : v) t = takum64::from_ell(rng() & 1, ell(rng));
+    for (size_t i = 0; i < v.size(); ++i) {
+        takum::inclusive_product_scan<64>(std::span<const takum64>(&v[i], 1), std::span<takum64>(&out[i], 1));
+        ASSERT_EQ(out[i].raw_bits(), v[i].raw_bits()) << i;
+    }
+}
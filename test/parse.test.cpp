@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "takum/parse.h"
+
+namespace {
+
+template <size_t N>
+using storage_t = typename takum::takum<N>::storage_t;
+
+// Tokens of mixed shapes: shortest to_chars output, %.17g, long digit strings, zeros and signs.
+template <size_t N>
+std::vector<std::string> sample_tokens(size_t count, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::string> tokens;
+    char buf[64];
+    while (tokens.size() < count) {
+        auto x = takum::takum<N>::from_raw_bits(static_cast<storage_t<N>>(rng() & ((N == 64 ? 0 : uint64_t{1} << N) - 1)));
+        if (x.is_nar()) continue;
+        switch (rng() % 5) {
+        case 0: tokens.emplace_back(buf, takum::to_chars(buf, buf + sizeof(buf), x).ptr); break;
+        case 1: std::snprintf(buf, sizeof(buf), "%.17g", x.to_double()); tokens.emplace_back(buf); break;
+        case 2: std::snprintf(buf, sizeof(buf), "%.25e", x.to_double()); tokens.emplace_back(buf); break;
+        case 3: std::snprintf(buf, sizeof(buf), "%.12f", x.to_double()); tokens.emplace_back(buf); break;
+        default: {
+            const uint64_t digits = rng() % 1000000000000ULL;
+            std::snprintf(buf, sizeof(buf), "%s%llu.%llue%d", (rng() & 1) ? "-" : "+",
+                          static_cast<unsigned long long>(digits % 1000), static_cast<unsigned long long>(digits),
+                          static_cast<int>(rng() % 40) - 20);
+            tokens.emplace_back(buf);
+        }
+        }
+    }
+    return tokens;
+}
+
+template <size_t N>
+void expect_matches_from_chars(size_t pieces) {
+    const auto tokens = sample_tokens<N>(5000, N * 7 + pieces);
+    const char* delims[] = {",", " ", "\n", "\r\n", ", ", "\t"};
+    std::string text;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        if (i) text += delims[i % 6];
+        text += tokens[i];
+    }
+    text += "\n";
+
+    std::vector<takum::takum<N>> out(tokens.size());
+    const auto r = takum::internal::parse_pieces<N>(text, std::span<takum::takum<N>>(out), pieces);
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_EQ(r.count, tokens.size());
+    EXPECT_EQ(r.ptr, text.data() + text.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        std::string_view t = tokens[i];
+        if (t.front() == '+') t.remove_prefix(1);
+        takum::takum<N> expected{};
+        const auto e = takum::from_chars(t.data(), t.data() + t.size(), expected);
+        ASSERT_EQ(e.ec, std::errc{}) << tokens[i];
+        ASSERT_EQ(out[i].raw_bits(), expected.raw_bits()) << tokens[i];
+    }
+}
+
+template <size_t N>
+takum::parse_many_result parse(std::string_view text, std::vector<takum::takum<N>>& out) {
+    return takum::parse_many<N>(text, std::span<takum::takum<N>>(out));
+}
+
+} // namespace
+
+TEST(Parse, MatchesFromCharsSingleThreaded) {
+    expect_matches_from_chars<16>(1);
+    expect_matches_from_chars<24>(1);
+    expect_matches_from_chars<32>(1);
+    expect_matches_from_chars<40>(1);
+    expect_matches_from_chars<48>(1);
+    expect_matches_from_chars<64>(1);
+}
+
+TEST(Parse, MatchesFromCharsAcrossPieces) {
+    expect_matches_from_chars<32>(7);
+    expect_matches_from_chars<64>(3);
+}
+
+TEST(Parse, DelimitersAndSpecials) {
+    std::vector<takum::takum<32>> out(16);
+    const auto r = parse<32>("  1,2\n\n-3.5e1\t,,NaR , inf\r\n0.0 -0 +.25 7.\n", out);
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_EQ(r.count, 9u);
+    EXPECT_DOUBLE_EQ(out[0].to_double(), 1.0);
+    EXPECT_NEAR(out[1].to_double(), 2.0, 1e-7);
+    EXPECT_NEAR(out[2].to_double(), -35.0, 1e-5);
+    EXPECT_TRUE(out[3].is_nar());
+    EXPECT_TRUE(out[4].is_nar());
+    EXPECT_TRUE(out[5].is_zero());
+    EXPECT_TRUE(out[6].is_zero());
+    EXPECT_NEAR(out[7].to_double(), 0.25, 1e-8);
+    EXPECT_NEAR(out[8].to_double(), 7.0, 1e-6);
+
+    EXPECT_EQ(parse<32>("", out).count, 0u);
+    EXPECT_EQ(parse<32>(" \n,, ", out).count, 0u);
+}
+
+TEST(Parse, LongMantissasAndLeadingZeros) {
+    std::vector<takum::takum<64>> out(4);
+    const std::string text = "000000000000001.5,0.000000000000000000000123456789012345678901,"
+                             "12345678901234567890123456789,3.14159265358979323846264338327950288";
+    const auto r = parse<64>(text, out);
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_EQ(r.count, 4u);
+    EXPECT_DOUBLE_EQ(out[0].to_double(), 1.5);
+    EXPECT_NEAR(out[1].to_double() / 1.23456789012345678901e-22, 1.0, 1e-14);
+    EXPECT_NEAR(out[2].to_double() / 1.2345678901234567890123e28, 1.0, 1e-14);
+    EXPECT_NEAR(out[3].to_double(), 3.14159265358979323846, 1e-15);
+}
+
+TEST(Parse, ReportsErrors) {
+    std::vector<takum::takum<32>> out(8);
+    const std::string bad = "1, 2, 3x, 4";
+    auto r = parse<32>(bad, out);
+    EXPECT_EQ(r.ec, std::errc::invalid_argument);
+    EXPECT_EQ(r.count, 2u);
+    EXPECT_EQ(r.ptr - bad.data(), 6);
+
+    const std::string range = "1 1e300 2";
+    r = parse<32>(range, out);
+    EXPECT_EQ(r.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(r.count, 1u);
+    EXPECT_EQ(r.ptr - range.data(), 2);
+
+    std::vector<takum::takum<32>> small(2);
+    const std::string many = "1 2 3 4";
+    r = parse<32>(many, small);
+    EXPECT_EQ(r.ec, std::errc::value_too_large);
+    EXPECT_EQ(r.count, 2u);
+    EXPECT_EQ(r.ptr - many.data(), 4);
+
+    EXPECT_EQ(parse<32>("1,-,2", out).ec, std::errc::invalid_argument);
+    EXPECT_EQ(parse<32>("1,.,2", out).ec, std::errc::invalid_argument);
+    EXPECT_EQ(parse<32>("1;2", out).ec, std::errc::invalid_argument);
+}
+
+TEST(Parse, ErrorsAcrossPieces) {
+    std::string text;
+    for (int i = 0; i < 1000; ++i) text += std::to_string(i) + (i == 612 ? "q\n" : "\n");
+    std::vector<takum::takum<32>> out(1000);
+    const auto r = takum::internal::parse_pieces<32>(text, std::span<takum::takum<32>>(out), 5);
+    EXPECT_EQ(r.ec, std::errc::invalid_argument);
+    EXPECT_EQ(r.count, 612u);
+    EXPECT_EQ(std::string_view(r.ptr, 4), "612q");
+    for (size_t i = 0; i < 612; ++i) ASSERT_NEAR(out[i].to_double(), static_cast<double>(i), i * 1e-7);
+
+    std::vector<takum::takum<32>> small(500);
+    const auto s = takum::internal::parse_pieces<32>(text, std::span<takum::takum<32>>(small), 5);
+    EXPECT_EQ(s.ec, std::errc::value_too_large);
+    EXPECT_EQ(s.count, 500u);
+    EXPECT_EQ(std::string_view(s.ptr, 4), "500\n");
+}
+
+TEST(Parse, SwarDigitHelpers) {
+    EXPECT_TRUE(takum::internal::is_eight_digits(takum::internal::load8("12345678")));
+    EXPECT_FALSE(takum::internal::is_eight_digits(takum::internal::load8("1234567.")));
+    EXPECT_FALSE(takum::internal::is_eight_digits(takum::internal::load8("/2345678")));
+    EXPECT_FALSE(takum::internal::is_eight_digits(takum::internal::load8("1234567:")));
+    EXPECT_EQ(takum::internal::parse_eight_digits(takum::internal::load8("12345678")), 12345678u);
+    EXPECT_EQ(takum::internal::parse_eight_digits(takum::internal::load8("00000009")), 9u);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "takum/polynomial.h"
+#include "takum/types.h"
+
+#include "test_data.h"
+
+using namespace takum::types;
+
+namespace {
+
+// Horner in long double over the decoded coefficients and point.
+template <size_t N>
+long double reference(std::span<const takum::takum<N>> c, const takum::takum<N>& x) {
+    long double p = 0;
+    for (size_t k = c.size(); k-- > 0;) p = p * x.to_double() + c[k].to_double();
+    return p;
+}
+
+// The batched result is the reference rounded once, up to the last bits of the
+// accumulator: the same pattern or a neighbour of it.
+template <size_t N>
+void expect_rounded_once(const takum::takum<N>& got, long double want) {
+    const auto r = takum::takum<N>(static_cast<double>(want));
+    const auto diff = static_cast<int64_t>(got.raw_bits()) - static_cast<int64_t>(r.raw_bits());
+    EXPECT_LE(std::llabs(diff), 1) << static_cast<double>(want);
+}
+
+} // namespace
+
+TEST(Polyval, MatchesWideHornerRoundedOnce) {
+    const std::vector<takum32> c{takum32(0.5), takum32(-1.25), takum32(2.0), takum32(0.125), takum32(-0.75)};
+    const auto x = test_data::uniform<32>(3 * TAKUM_PARALLEL_GRAIN + 7, 1, -3.0, 3.0);
+    std::vector<takum32> out(x.size());
+    takum::polyval<32>(c, x, out);
+    for (size_t i = 0; i < x.size(); ++i) expect_rounded_once(out[i], reference<32>(c, x[i]));
+}
+
+TEST(Polyval, FixedDegreeMatchesSpanAndScalar) {
+    const std::array<takum16, 4> c{takum16(1.0), takum16(-0.5), takum16(0.25), takum16(3.0)};
+    const auto x = test_data::uniform<16>(1000, 2, -3.0, 3.0);
+    std::vector<takum16> fixed(x.size()), dynamic(x.size());
+    takum::polyval<16>(c, x, fixed);
+    takum::polyval<16>(std::span<const takum16>(c), x, dynamic);
+    EXPECT_EQ(fixed, dynamic);
+    EXPECT_EQ(takum::polyval<16>(c, x[17]).raw_bits(), fixed[17].raw_bits());
+}
+
+TEST(Polyval, MoreAccurateThanScalarHorner) {
+    // (x - 1)^4 expanded: heavy cancellation near x = 1.
+    const std::vector<takum32> c{takum32(1.0), takum32(-4.0), takum32(6.0), takum32(-4.0), takum32(1.0)};
+    const std::vector<takum32> x{takum32(1.01), takum32(0.97), takum32(1.1)};
+    std::vector<takum32> out(x.size());
+    takum::polyval<32>(c, x, out);
+    for (size_t i = 0; i < x.size(); ++i) {
+        takum32 h = c.back();
+        for (size_t k = c.size() - 1; k-- > 0;) h = h * x[i] + c[k];
+        const long double want = reference<32>(c, x[i]);
+        expect_rounded_once(out[i], want);
+        EXPECT_LE(std::fabs(out[i].to_double() - want), std::fabs(h.to_double() - want));
+    }
+}
+
+TEST(Polyval, EdgeCases) {
+    const std::vector<takum64> x{takum64(2.0), takum64::nar(), takum64(0.0)};
+    std::vector<takum64> out(x.size());
+    takum::polyval<64>(std::span<const takum64>(), x, out);
+    for (const auto& t : out) EXPECT_TRUE(t.is_zero());
+
+    const std::vector<takum64> c{takum64(1.0), takum64(1.0)};
+    takum::polyval<64>(c, x, out);
+    // takum64(2.0) is 2 - 1.3e-18, so 1 + x rounds to the pattern below
+    // takum64(3.0) once the sum is not narrowed to double.
+    const bool wide = sizeof(takum::internal::wide_float) > sizeof(double);
+    EXPECT_EQ(out[0].raw_bits(), takum64(3.0).raw_bits() - (wide ? 1 : 0));
+    EXPECT_TRUE(out[1].is_nar());
+    EXPECT_EQ(out[2].raw_bits(), takum64(1.0).raw_bits());
+
+    // x^8 at x = 1e50 overflows double; the result saturates like the encoder.
+    std::vector<takum32> c8(9, takum32(0.0));
+    c8[8] = takum32(1.0);
+    const std::vector<takum32> big{takum32(1e50), takum32(-1e50)};
+    std::vector<takum32> r(2);
+    takum::polyval<32>(c8, big, r);
+    EXPECT_EQ(r[0].raw_bits(), takum32(1e300).raw_bits());
+    EXPECT_EQ(r[1].raw_bits(), takum32(1e300).raw_bits());
+}
+
+TEST(Polyval, Takum64KeepsFullPrecision) {
+    // p(x) = x and x / 1 give x back bit for bit: a takum64 pattern carries
+    // more precision than a double, so any trip through double would not.
+    if (sizeof(takum::internal::wide_float) == sizeof(double)) GTEST_SKIP() << "wide_float is double";
+    std::mt19937_64 rng(9);
+    std::vector<takum64> x(4096);
+    for (auto& t : x) t = takum64::from_raw_bits(rng() & 0x7FFFFFFFFFFFFFFFULL);
+    const std::vector<takum64> identity{takum64(0.0), takum64(1.0)}, one{takum64(1.0)};
+    std::vector<takum64> p(x.size()), q(x.size());
+    takum::polyval<64>(identity, x, p);
+    takum::ratval<64>(identity, one, x, q);
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (x[i].is_zero()) continue;
+        ASSERT_EQ(p[i].raw_bits(), x[i].raw_bits()) << i;
+        ASSERT_EQ(q[i].raw_bits(), x[i].raw_bits()) << i;
+    }
+}
+
+TEST(Ratval, QuotientAndZeroDenominator) {
+    const std::vector<takum32> num{takum32(1.0), takum32(2.0)};            // 1 + 2x
+    const std::vector<takum32> den{takum32(-1.0), takum32(0.0), takum32(1.0)}; // x^2 - 1
+    auto x = test_data::uniform<32>(2000, 3, -3.0, 3.0);
+    x[5] = takum32(1.0);
+    x[6] = takum32(-1.0);
+    std::vector<takum32> out(x.size());
+    takum::flags_guard guard;
+    takum::ratval<32>(num, den, x, out);
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (i == 5 || i == 6) {
+            EXPECT_TRUE(out[i].is_nar());
+            continue;
+        }
+        expect_rounded_once(out[i], reference<32>(num, x[i]) / reference<32>(den, x[i]));
+    }
+    EXPECT_TRUE(takum::test_flags(takum::flag_invalid));
+
+    const std::array<takum32, 2> fn{num[0], num[1]};
+    const std::array<takum32, 3> fd{den[0], den[1], den[2]};
+    std::vector<takum32> fixed(x.size());
+    takum::ratval<32>(fn, fd, x, fixed);
+    EXPECT_EQ(fixed, out);
+}
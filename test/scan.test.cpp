@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "takum/scan.h"
+#include "takum/types.h"
+
+#include "test_data.h"
+
+using namespace takum::types;
+using takum::scan::cmp_op;
+
+namespace {
+
+// Value order of two reals, from the decoded values.
+template <size_t N>
+int order(const takum::takum<N>& x, const takum::takum<N>& y) {
+    const double a = x.to_double(), b = y.to_double();
+    return (a > b) - (a < b);
+}
+
+template <size_t N>
+bool reference(const takum::takum<N>& x, cmp_op op, const takum::takum<N>& c) {
+    if (x.is_nar() || c.is_nar()) return false;
+    const int o = order(x, c);
+    switch (op) {
+    case cmp_op::lt: return o < 0;
+    case cmp_op::le: return o <= 0;
+    case cmp_op::gt: return o > 0;
+    case cmp_op::ge: return o >= 0;
+    case cmp_op::eq: return o == 0;
+    case cmp_op::ne: return o != 0;
+    }
+    return false;
+}
+
+bool bit(const std::vector<uint8_t>& bits, size_t i) { return ((bits[i / 8] >> (i % 8)) & 1u) != 0; }
+
+template <size_t N>
+void expect_compare_matches_values(const std::vector<takum::takum<N>>& v) {
+    using T = takum::takum<N>;
+    const std::span<const T> in(v);
+    const auto zm = takum::scan::make_zone_map<N>(in, 256);
+    const T constants[] = {T(0.0), T(1.0), T(-2.5), T(4.5), T(-10.0), T(100.0), T::nar()};
+    for (cmp_op op : {cmp_op::lt, cmp_op::le, cmp_op::gt, cmp_op::ge, cmp_op::eq, cmp_op::ne}) {
+        for (const T& c : constants) {
+            std::vector<uint8_t> bits((v.size() + 7) / 8, 0xFF), zoned(bits.size(), 0xAA);
+            size_t expected = 0;
+            for (const T& x : v) expected += reference(x, op, c);
+            EXPECT_EQ(takum::scan::compare<N>(in, op, c, bits), expected);
+            EXPECT_EQ(takum::scan::compare<N>(in, zm, op, c, zoned), expected);
+            for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(bit(bits, i), reference(v[i], op, c)) << i;
+            EXPECT_EQ(bits, zoned);
+            if (v.size() % 8) {
+                EXPECT_EQ(bits.back() >> (v.size() % 8), 0) << "unused bits cleared";
+            }
+        }
+    }
+}
+
+template <size_t N>
+void expect_between_matches_values(const std::vector<takum::takum<N>>& v) {
+    using T = takum::takum<N>;
+    const std::span<const T> in(v);
+    const auto zm = takum::scan::make_zone_map<N>(in, 100);
+    EXPECT_EQ(zm.block, 128u);
+    const std::pair<double, double> ranges[] = {{-2.0, 3.0}, {0.0, 0.0}, {-20.0, 20.0}, {5.0, -5.0}, {7.5, 50.0}};
+    for (auto [lo_d, hi_d] : ranges) {
+        const T lo(lo_d), hi(hi_d);
+        auto want = [&](const T& x) { return reference(x, cmp_op::ge, lo) && reference(x, cmp_op::le, hi); };
+        std::vector<uint8_t> bits((v.size() + 7) / 8), zoned(bits.size());
+        size_t expected = 0;
+        for (const T& x : v) expected += want(x);
+        EXPECT_EQ(takum::scan::between<N>(in, lo, hi, bits), expected);
+        EXPECT_EQ(takum::scan::between<N>(in, zm, lo, hi, zoned), expected);
+        for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(bit(bits, i), want(v[i])) << i;
+        EXPECT_EQ(bits, zoned);
+    }
+    std::vector<uint8_t> bits((v.size() + 7) / 8, 0xFF);
+    EXPECT_EQ(takum::scan::between<N>(in, T::nar(), T(1.0), bits), 0u);
+    EXPECT_TRUE(std::all_of(bits.begin(), bits.end(), [](uint8_t b) { return b == 0; }));
+}
+
+template <size_t N>
+void expect_all() {
+    auto v = test_data::halves<N>(3 * TAKUM_PARALLEL_GRAIN + 13, N);
+    expect_compare_matches_values<N>(v);
+    expect_between_matches_values<N>(v);
+    // Sorted (NaRs first) so most blocks are decided by the zone map alone.
+    std::sort(v.begin(), v.end(), [](const auto& a, const auto& b) {
+        if (a.is_nar() || b.is_nar()) return a.is_nar() && !b.is_nar();
+        return order(a, b) < 0;
+    });
+    expect_compare_matches_values<N>(v);
+    expect_between_matches_values<N>(v);
+}
+
+} // namespace
+
+TEST(Scan, CompareAndBetweenMatchValueOrder16) { expect_all<16>(); }
+TEST(Scan, CompareAndBetweenMatchValueOrder32) { expect_all<32>(); }
+TEST(Scan, CompareAndBetweenMatchValueOrder64) { expect_all<64>(); }
+
+TEST(Scan, NegativesOrderByValue) {
+    const std::vector<takum32> v{takum32(-3.0), takum32(-2.0), takum32(-1.0), takum32(-0.5), takum32(0.0),
+                                 takum32(0.5), takum32(1.0), takum32(2.0)};
+    std::vector<uint8_t> bits(1);
+    EXPECT_EQ(takum::scan::compare<32>(v, cmp_op::lt, takum32(-1.0), bits), 2u);
+    EXPECT_EQ(bits[0], 0b00000011);
+    EXPECT_EQ(takum::scan::between<32>(v, takum32(-2.0), takum32(0.5), bits), 5u);
+    EXPECT_EQ(bits[0], 0b00111110);
+}
+
+TEST(Scan, NaRNeverMatches) {
+    const std::vector<takum32> v{takum32::nar(), takum32(1.0), takum32::nar()};
+    std::vector<uint8_t> bits(1);
+    EXPECT_EQ(takum::scan::compare<32>(v, cmp_op::ne, takum32(5.0), bits), 1u);
+    EXPECT_EQ(bits[0], 0b010);
+    EXPECT_EQ(takum::scan::compare<32>(v, cmp_op::lt, takum32(5.0), bits), 1u);
+    EXPECT_EQ(takum::scan::compare<32>(v, cmp_op::eq, takum32::nar(), bits), 0u);
+    EXPECT_EQ(bits[0], 0);
+}
+
+TEST(Scan, ZoneMapRecordsRangesAndSkipsBlocks) {
+    std::vector<takum32> v(256, takum32(1.0));
+    for (size_t i = 64; i < 128; ++i) v[i] = takum32::nar();
+    for (size_t i = 128; i < 192; ++i) v[i] = takum32(static_cast<double>(i));
+    v[200] = takum32::nar();
+    const auto zm = takum::scan::make_zone_map<32>(v, 64);
+    ASSERT_EQ(zm.blocks(), 4u);
+    EXPECT_EQ(zm.has_nar, (std::vector<uint8_t>{0, 1, 0, 1}));
+    EXPECT_GT(zm.min[1], zm.max[1]) << "all-NaR block has an empty range";
+    EXPECT_EQ(zm.min[0], zm.max[0]);
+    EXPECT_LT(zm.min[2], zm.max[2]);
+
+    std::vector<uint8_t> bits(32, 0x5A);
+    EXPECT_EQ(takum::scan::compare<32>(v, zm, cmp_op::le, takum32(150.0), bits), 64u + 23u + 63u);
+    for (size_t b = 0; b < 8; ++b) EXPECT_EQ(bits[b], 0xFF);
+    for (size_t b = 8; b < 16; ++b) EXPECT_EQ(bits[b], 0x00);
+    EXPECT_FALSE(bit(bits, 200));
+
+    // A zone map for other data is ignored rather than trusted.
+    std::vector<takum32> w(v.begin(), v.begin() + 100);
+    std::vector<uint8_t> wbits(13);
+    EXPECT_EQ(takum::scan::compare<32>(w, zm, cmp_op::gt, takum32(0.0), wbits), 64u);
+}
+
+TEST(Scan, ShortBitmapCoversPrefix) {
+    const std::vector<takum16> v(40, takum16(2.0));
+    std::vector<uint8_t> bits(3);
+    EXPECT_EQ(takum::scan::compare<16>(v, cmp_op::ge, takum16(2.0), bits), 24u);
+    EXPECT_EQ(bits, (std::vector<uint8_t>{0xFF, 0xFF, 0xFF}));
+}
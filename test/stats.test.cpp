@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "takum/stats.h"
+#include "takum/types.h"
+
+#include "test_data.h"
+
+using namespace takum::types;
+
+namespace {
+
+struct reference_moments {
+    long double mean = 0, var = 0, skew = 0, kurt = 0;
+    double min = INFINITY, max = -INFINITY;
+    uint64_t count = 0;
+};
+
+template <size_t N>
+reference_moments two_pass(const std::vector<takum::takum<N>>& v) {
+    reference_moments r;
+    long double sum = 0;
+    for (const auto& t : v) {
+        if (t.is_nar()) continue;
+        const double x = t.to_double();
+        sum += x;
+        r.min = std::min(r.min, x);
+        r.max = std::max(r.max, x);
+        ++r.count;
+    }
+    r.mean = sum / r.count;
+    long double m2 = 0, m3 = 0, m4 = 0;
+    for (const auto& t : v) {
+        if (t.is_nar()) continue;
+        const long double d = t.to_double() - r.mean;
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+    }
+    const long double n = r.count;
+    r.var = m2 / n;
+    r.skew = std::sqrt(n) * m3 / std::pow(m2, 1.5L);
+    r.kurt = n * m4 / (m2 * m2) - 3;
+    return r;
+}
+
+template <size_t N>
+std::vector<takum::takum<N>> gamma_like(size_t n, uint64_t seed) {
+    std::gamma_distribution<double> g(2.0, 3.0);
+    return test_data::column<N>(n, seed, [&](std::mt19937_64& rng) {
+        return (rng() % 97 == 0) ? takum::takum<N>::nar() : takum::takum<N>(1000.0 + g(rng));
+    });
+}
+
+template <size_t N>
+void expect_close(const takum::stats::running_moments<N>& m, const reference_moments& r, double rel) {
+    EXPECT_EQ(m.count(), r.count);
+    EXPECT_NEAR(m.mean().to_double(), static_cast<double>(r.mean), rel * std::fabs(static_cast<double>(r.mean)));
+    EXPECT_NEAR(m.variance().to_double(), static_cast<double>(r.var), rel * static_cast<double>(r.var));
+    EXPECT_NEAR(m.skewness().to_double(), static_cast<double>(r.skew), rel * std::fabs(static_cast<double>(r.skew)));
+    EXPECT_NEAR(m.kurtosis().to_double(), static_cast<double>(r.kurt), rel * std::fabs(static_cast<double>(r.kurt)));
+    EXPECT_EQ(m.min().to_double(), r.min);
+    EXPECT_EQ(m.max().to_double(), r.max);
+}
+
+} // namespace
+
+TEST(RunningMoments, SpanUpdateMatchesTwoPass32) {
+    // A large offset relative to the spread stresses cancellation in the moments.
+    const auto v = gamma_like<32>(3 * TAKUM_PARALLEL_GRAIN + 11, 1);
+    takum::stats::running_moments<32> m;
+    m.update(std::span<const takum32>(v));
+    expect_close(m, two_pass(v), 1e-6);
+    EXPECT_EQ(m.count() + m.nar_count(), v.size());
+}
+
+TEST(RunningMoments, SpanUpdateMatchesTwoPass16And64) {
+    const auto v16 = gamma_like<16>(5000, 2);
+    takum::stats::running_moments<16> m16;
+    m16.update(std::span<const takum16>(v16));
+    expect_close(m16, two_pass(v16), 1e-3);
+
+    const auto v64 = gamma_like<64>(5000, 3);
+    takum::stats::running_moments<64> m64;
+    m64.update(std::span<const takum64>(v64));
+    expect_close(m64, two_pass(v64), 1e-9);
+}
+
+TEST(RunningMoments, ScalarUpdatesAndMergeAgreeWithBatch) {
+    const auto v = gamma_like<32>(10000, 4);
+    takum::stats::running_moments<32> batch, one, left, right;
+    batch.update(std::span<const takum32>(v));
+    for (const auto& x : v) one.update(x);
+    left.update(std::span<const takum32>(v).first(3333));
+    right.update(std::span<const takum32>(v).subspan(3333));
+    left.merge(right);
+    for (const auto* m : {&one, &left}) {
+        EXPECT_EQ(m->count(), batch.count());
+        EXPECT_EQ(m->nar_count(), batch.nar_count());
+        EXPECT_NEAR(m->variance().to_double(), batch.variance().to_double(), 1e-6 * batch.variance().to_double());
+        EXPECT_NEAR(m->kurtosis().to_double(), batch.kurtosis().to_double(), 1e-5);
+        EXPECT_EQ(m->min().raw_bits(), batch.min().raw_bits());
+        EXPECT_EQ(m->max().raw_bits(), batch.max().raw_bits());
+    }
+}
+
+TEST(RunningMoments, MinMaxFollowValueOrder64) {
+    // Both signs and a wide magnitude range, so sign and regime bits matter.
+    std::mt19937_64 rng(6);
+    std::lognormal_distribution<double> mag(0.0, 4.0);
+    std::vector<takum64> v(4000);
+    for (auto& t : v) t = takum64((rng() & 1) ? -mag(rng) : mag(rng));
+    v[17] = takum64::nar();
+    const auto want = two_pass(v);
+    takum::stats::running_moments<64> batch, one;
+    batch.update(std::span<const takum64>(v));
+    for (const auto& x : v) one.update(x);
+    for (const auto* m : {&batch, &one}) {
+        EXPECT_EQ(m->min().to_double(), want.min);
+        EXPECT_EQ(m->max().to_double(), want.max);
+    }
+}
+
+TEST(RunningMoments, EmptyConstantAndNegativeStreams) {
+    takum::stats::running_moments<32> m;
+    EXPECT_TRUE(m.mean().is_nar());
+    EXPECT_TRUE(m.min().is_nar());
+    m.update(takum32::nar());
+    EXPECT_EQ(m.nar_count(), 1u);
+    EXPECT_TRUE(m.variance().is_nar());
+
+    const std::vector<takum32> same(10, takum32(-2.5));
+    m.update(std::span<const takum32>(same));
+    EXPECT_EQ(m.count(), 10u);
+    EXPECT_EQ(m.mean().raw_bits(), takum32(-2.5).raw_bits());
+    EXPECT_TRUE(m.variance().is_zero());
+    EXPECT_TRUE(m.skewness().is_nar());
+    EXPECT_TRUE(m.variance(10).is_nar());
+
+    m.update(takum32(-7.0));
+    EXPECT_EQ(m.min().raw_bits(), takum32(-7.0).raw_bits());
+    EXPECT_EQ(m.max().raw_bits(), takum32(-2.5).raw_bits());
+    EXPECT_NEAR(m.variance(1).to_double(), (11.0 / 10.0) * m.variance().to_double(), 1e-6);
+    EXPECT_FALSE(m.skewness().is_nar());
+
+    m.reset();
+    EXPECT_EQ(m.count() + m.nar_count(), 0u);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "takum/elementwise.h"
+#include "takum/status_flags.h"
+#include "takum/types.h"
+
+using namespace takum::types;
+
+namespace {
+
+// Flags raised by `f` alone.
+template <typename F>
+unsigned flags_of(F&& f) {
+    takum::flags_guard guard;
+    f();
+    return guard.flags();
+}
+
+} // namespace
+
+TEST(StatusFlags, ConversionFlags) {
+    EXPECT_EQ(flags_of([] { (void)takum32(1.0); }), 0u);
+    EXPECT_EQ(flags_of([] { (void)takum32(0.0); }), 0u);
+    EXPECT_EQ(flags_of([] { (void)takum32(3.0); }), unsigned(takum::flag_inexact));
+    EXPECT_EQ(flags_of([] { (void)takum32(std::numeric_limits<double>::quiet_NaN()); }),
+              takum::flag_nar | takum::flag_invalid);
+    EXPECT_EQ(flags_of([] { (void)takum16(std::numeric_limits<double>::infinity()); }),
+              takum::flag_nar | takum::flag_invalid);
+    EXPECT_EQ(flags_of([] { (void)takum32(1e300); }), takum::flag_overflow | takum::flag_inexact);
+    EXPECT_EQ(flags_of([] { (void)takum32(-1e-300); }), takum::flag_underflow | takum::flag_inexact);
+    EXPECT_EQ(flags_of([] { (void)takum128(std::numeric_limits<double>::quiet_NaN()); }),
+              takum::flag_nar | takum::flag_invalid);
+}
+
+TEST(StatusFlags, ArithmeticFlags) {
+    const takum32 one(1.0), two(2.0), zero(0.0), nar = takum32::nar();
+    EXPECT_EQ(flags_of([&] { (void)(one / zero); }), takum::flag_nar | takum::flag_invalid);
+    EXPECT_EQ(flags_of([&] { (void)zero.reciprocal(); }), takum::flag_nar | takum::flag_invalid);
+    EXPECT_EQ(flags_of([&] { (void)(one + nar); }), unsigned(takum::flag_nar));
+    EXPECT_EQ(flags_of([&] { (void)(nar * two); }), unsigned(takum::flag_nar));
+    EXPECT_EQ(flags_of([&] { (void)(one * one); }), 0u);
+    EXPECT_EQ(flags_of([&] { (void)two.reciprocal(); }), 0u);
+    EXPECT_EQ(flags_of([&] { (void)-nar; (void)-two; }), 0u);
+    const takum32 big(1e100);
+    EXPECT_TRUE(flags_of([&] { (void)(big * big); }) & takum::flag_overflow);
+}
+
+TEST(StatusFlags, StickyUntilCleared) {
+    takum::flags_guard guard;
+    (void)(takum32(1.0) / takum32(0.0));
+    (void)(takum32(1.0) + takum32(1.0));
+    EXPECT_TRUE(takum::test_flags(takum::flag_invalid));
+    takum::clear_flags(takum::flag_invalid);
+    EXPECT_FALSE(takum::test_flags(takum::flag_invalid));
+    EXPECT_TRUE(takum::test_flags(takum::flag_nar));
+    takum::clear_flags();
+    EXPECT_EQ(takum::test_flags(), 0u);
+}
+
+TEST(StatusFlags, GuardRestoresOrMerges) {
+    takum::clear_flags();
+    takum::raise_flags(takum::flag_overflow);
+    {
+        takum::flags_guard inner;
+        EXPECT_EQ(takum::test_flags(), 0u);
+        (void)takum32::nar().reciprocal();
+        EXPECT_EQ(inner.flags(), unsigned(takum::flag_nar));
+    }
+    EXPECT_EQ(takum::test_flags(), unsigned(takum::flag_overflow));
+    {
+        takum::flags_guard inner(/*merge=*/true);
+        (void)takum32::nar().reciprocal();
+    }
+    EXPECT_EQ(takum::test_flags(), takum::flag_overflow | takum::flag_nar);
+    const unsigned saved = takum::save_flags();
+    takum::clear_flags();
+    takum::restore_flags(saved);
+    EXPECT_EQ(takum::test_flags(), saved);
+    takum::clear_flags();
+}
+
+TEST(StatusFlags, ThreadLocal) {
+    takum::clear_flags();
+    std::thread([] { (void)(takum32(1.0) / takum32(0.0)); }).join();
+    EXPECT_EQ(takum::test_flags(), 0u);
+}
+
+TEST(StatusFlags, SpanKernelsReportWorkerFlags) {
+    // Several grains, so threaded builds fold worker registers back in.
+    std::vector<takum32> a(4 * TAKUM_PARALLEL_GRAIN, takum32(2.0)), out(a.size());
+    a.back() = takum32(0.0);
+    EXPECT_EQ(flags_of([&] { takum::recip<32>(a, out); }), takum::flag_nar | takum::flag_invalid);
+    a.back() = takum32(1e100);
+    const unsigned mul = flags_of([&] { takum::mul<32>(a, a, out); });
+    EXPECT_TRUE(mul & takum::flag_overflow);
+    EXPECT_FALSE(mul & takum::flag_nar);
+    std::fill(a.begin(), a.end(), takum32(0.5));
+    EXPECT_EQ(flags_of([&] { takum::mul<32>(a, a, out); }), 0u); // ℓ sums are exact here
+}
+
+TEST(StatusFlags, ScalarInexactIsConservative) {
+    // ℓ(2) + ℓ(1) = ℓ(2) exactly: the ℓ kernel raises nothing, but operator*
+    // re-encodes the host-double product 2·1 through a logarithm and cannot
+    // tell that it landed on a pattern.
+    const std::vector<takum16> two(1, takum16(2.0)), one(1, takum16(1.0));
+    std::vector<takum16> out(1);
+    EXPECT_EQ(flags_of([&] { takum::mul<16>(two, one, out); }), 0u);
+    EXPECT_EQ(out[0].raw_bits(), two[0].raw_bits());
+    EXPECT_EQ(flags_of([&] { (void)(two[0] * one[0]); }), unsigned(takum::flag_inexact));
+    EXPECT_EQ(flags_of([&] { (void)(two[0] / one[0]); }), unsigned(takum::flag_inexact));
+
+    // The kernel still reports real roundings in ℓ, and the scalar operators
+    // raise flag_inexact whenever the kernel does.
+    unsigned kernel_inexact = 0;
+    std::vector<takum16> x(1), y(1);
+    for (uint32_t a = 1; a < (1u << 15); a += 397) {
+        for (uint32_t b = 1; b < (1u << 15); b += 389) {
+            x[0] = takum16::from_raw_bits(a);
+            y[0] = takum16::from_raw_bits(b);
+            const unsigned k = flags_of([&] { takum::mul<16>(x, y, out); });
+            const unsigned s = flags_of([&] { (void)(x[0] * y[0]); });
+            if (k & takum::flag_inexact) {
+                ++kernel_inexact;
+                EXPECT_TRUE(s & takum::flag_inexact) << a << " * " << b;
+            }
+        }
+    }
+    EXPECT_GT(kernel_inexact, 0u);
+}
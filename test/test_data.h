@@ -0,0 +1,51 @@
+/**
+ * @file test_data.h
+ * @brief Seeded takum<N> columns for the span kernel tests.
+ *
+ * `column<N>(n, seed, draw)` fills n elements with `draw(rng)` from one
+ * std::mt19937_64 seeded with @p seed, so a test can regenerate the same data.
+ * The draw returns a double or a takum<N>; the latter is needed for NaR, which
+ * converting a NaN would also record as an invalid operation. Sizes are
+ * usually a few TAKUM_PARALLEL_GRAIN plus an odd remainder, so the threaded
+ * paths and a ragged last chunk both run.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "takum/core.h"
+
+namespace test_data {
+
+template <size_t N, typename Draw>
+std::vector<takum::takum<N>> column(size_t n, uint64_t seed, const Draw& draw) {
+    std::mt19937_64 rng(seed);
+    std::vector<takum::takum<N>> v(n);
+    for (auto& t : v) t = takum::takum<N>(draw(rng));
+    return v;
+}
+
+/// @brief Uniform values in [lo, hi).
+template <size_t N>
+std::vector<takum::takum<N>> uniform(size_t n, uint64_t seed, double lo, double hi) {
+    std::uniform_real_distribution<double> dist(lo, hi);
+    return column<N>(n, seed, [&](std::mt19937_64& rng) { return dist(rng); });
+}
+
+/// @brief One zero and one NaR in ten, otherwise halves in [-10, 10] (so equality hits).
+template <size_t N>
+std::vector<takum::takum<N>> halves(size_t n, uint64_t seed) {
+    return column<N>(n, seed, [](std::mt19937_64& rng) {
+        switch (rng() % 10) {
+        case 0: return takum::takum<N>(0.0);
+        case 1: return takum::takum<N>::nar();
+        default: return takum::takum<N>(static_cast<double>(static_cast<int>(rng() % 41) - 20) / 2.0);
+        }
+    });
+}
+
+} // namespace test_data
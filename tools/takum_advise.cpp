@@ -0,0 +1,126 @@
+/**
+ * @file takum_advise.cpp
+ * @brief CLI front-end for takum::advise_width().
+ *
+ * Reads a dataset (text, raw float32 or raw float64), runs the width advisor
+ * and prints one line per candidate width plus the recommendation.
+ *
+ * Usage:
+ *   takum_advise [--text|--f32|--f64] <file|-> <error_target>
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "takum/advisor.h"
+
+namespace {
+
+enum class input_format { text, f32, f64 };
+
+void print_usage(std::ostream& os) {
+    os << "usage: takum_advise [--text|--f32|--f64] <file|-> <error_target>\n"
+          "  --text  whitespace/comma separated decimals (default)\n"
+          "  --f32   raw native-endian float32 values\n"
+          "  --f64   raw native-endian float64 values\n"
+          "  file    input path, or '-' for stdin\n";
+}
+
+bool read_input(std::istream& in, input_format fmt, std::vector<double>& out) {
+    if (fmt == input_format::text) {
+        std::string token;
+        char c;
+        auto flush = [&] {
+            if (token.empty()) return true;
+            char* end = nullptr;
+            double v = std::strtod(token.c_str(), &end);
+            if (end == token.c_str() || *end != '\0') return false;
+            out.push_back(v);
+            token.clear();
+            return true;
+        };
+        while (in.get(c)) {
+            if (c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                if (!flush()) return false;
+            } else {
+                token.push_back(c);
+            }
+        }
+        return flush();
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const size_t elem = (fmt == input_format::f32) ? sizeof(float) : sizeof(double);
+    if (bytes.size() % elem != 0) return false;
+    out.resize(bytes.size() / elem);
+    for (size_t i = 0; i < out.size(); ++i) {
+        if (fmt == input_format::f32) {
+            float f;
+            std::memcpy(&f, bytes.data() + i * elem, elem);
+            out[i] = f;
+        } else {
+            std::memcpy(&out[i], bytes.data() + i * elem, elem);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    input_format fmt = input_format::text;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") { print_usage(std::cout); return 0; }
+        if (arg == "--text") fmt = input_format::text;
+        else if (arg == "--f32") fmt = input_format::f32;
+        else if (arg == "--f64") fmt = input_format::f64;
+        else positional.push_back(arg);
+    }
+    if (positional.size() != 2) { print_usage(std::cerr); return 2; }
+
+    char* end = nullptr;
+    const double target = std::strtod(positional[1].c_str(), &end);
+    if (end == positional[1].c_str() || !(target > 0.0)) {
+        std::cerr << "takum_advise: invalid error target '" << positional[1] << "'\n";
+        return 2;
+    }
+
+    std::vector<double> data;
+    bool ok;
+    if (positional[0] == "-") {
+        ok = read_input(std::cin, fmt, data);
+    } else {
+        std::ifstream file(positional[0], std::ios::binary);
+        if (!file) { std::cerr << "takum_advise: cannot open '" << positional[0] << "'\n"; return 1; }
+        ok = read_input(file, fmt, data);
+    }
+    if (!ok) { std::cerr << "takum_advise: malformed input\n"; return 1; }
+
+    const auto advice = takum::advise_width(data, target);
+
+    std::printf("values: %zu  zeros: %llu  non-finite: %llu  target: %g\n", data.size(),
+                static_cast<unsigned long long>(advice.histogram.zeros),
+                static_cast<unsigned long long>(advice.histogram.non_finite), target);
+    std::printf("%6s %14s %14s %10s %14s %s\n", "N", "max_rel_err", "mean_rel_err", "saturated",
+                "packed_bytes", "ok");
+    for (const auto& c : advice.candidates) {
+        std::printf("%6zu %14.6e %14.6e %10llu %14llu %s\n", c.width, c.max_rel_error, c.mean_rel_error,
+                    static_cast<unsigned long long>(c.saturated),
+                    static_cast<unsigned long long>(c.packed_bytes), c.meets_target ? "yes" : "no");
+    }
+    if (advice.recommended_width == 0) {
+        std::printf("no candidate width meets the target\n");
+        return 3;
+    }
+    std::printf("recommended: takum<%zu>  bytes saved vs double: %llu of %llu\n", advice.recommended_width,
+                static_cast<unsigned long long>(advice.bytes_saved),
+                static_cast<unsigned long long>(advice.baseline_bytes));
+    return 0;
+}
@@ -0,0 +1,556 @@
+/**
+ * @file takum_convert.cpp
+ * @brief Bulk converter between float32/float64 and takum<N> array files.
+ *
+ * Inputs are memory-mapped; a three-stage pipeline (read → convert → write)
+ * runs each stage on its own thread with a small pool of chunk buffers, so
+ * disk I/O overlaps the conversion. The convert stage uses the parallel
+ * batch kernels from batch.h. At the end the tool prints throughput and,
+ * unless disabled, the relative error of the output against the input.
+ *
+ * Containers are chosen by file extension: `.npy` (NumPy), `.tka` (takum
+ * array file, takum output only), anything else is raw native-endian data.
+ *
+ * Usage:
+ *   takum_convert [--from TYPE] [--to TYPE] [--chunk N] [--no-stats] <input> <output>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "takum/batch.h"
+#include "takum/mapped_array.h"
+#include "takum/npy.h"
+#include "takum/internal/byte_io.h"
+#include "takum/internal/file_map.h"
+#include "takum/internal/width_dispatch.h"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/// Element type on one side of the conversion.
+struct element_type {
+    enum class kind { f32, f64, takum } k = kind::f64;
+    size_t width = 0; ///< N for kind::takum
+
+    /// Bytes per element in memory (the takum<N> storage word for patterns).
+    size_t bytes() const { return k == kind::f32 ? 4 : k == kind::f64 ? 8 : (width <= 32 ? 4 : 8); }
+
+    std::string name() const {
+        return k == kind::f32 ? "f32" : k == kind::f64 ? "f64" : "takum" + std::to_string(width);
+    }
+};
+
+enum class container { raw, npy, tka };
+
+void print_usage(std::ostream& os) {
+    os << "usage: takum_convert [--from TYPE] [--to TYPE] [--chunk N] [--no-stats] <input> <output>\n"
+          "  TYPE        f32, f64 or takumN (N = 12 16 19 20 24 28 32 40 48 56 64)\n"
+          "  --from      element type of a raw input file (default f64); .npy/.tka inputs\n"
+          "              describe themselves\n"
+          "  --to        output element type (default takum32 for float input, f64 for takum input)\n"
+          "  --chunk     elements per pipeline chunk (default 1048576)\n"
+          "  --no-stats  skip the error statistics pass\n"
+          "  files ending in .npy are NumPy arrays, .tka are takum array files (takum output\n"
+          "  only), anything else is raw native-endian data\n";
+}
+
+bool parse_type(const std::string& s, element_type& t) {
+    if (s == "f32") { t = {element_type::kind::f32, 0}; return true; }
+    if (s == "f64") { t = {element_type::kind::f64, 0}; return true; }
+    if (s.rfind("takum", 0) != 0 || s.size() == 5) return false;
+    char* end = nullptr;
+    const unsigned long n = std::strtoul(s.c_str() + 5, &end, 10);
+    if (*end != '\0' || !takum::internal::is_dispatch_width(n)) return false;
+    t = {element_type::kind::takum, n};
+    return true;
+}
+
+container container_of(const std::string& path) {
+    auto ends_with = [&](const char* ext) {
+        const size_t n = std::strlen(ext);
+        return path.size() >= n && path.compare(path.size() - n, n, ext) == 0;
+    };
+    return ends_with(".npy") ? container::npy : ends_with(".tka") ? container::tka : container::raw;
+}
+
+/// A mapped input file and where its elements live.
+struct input_file {
+    takum::internal::file_map map;
+    element_type type;
+    size_t item_bytes = 0;        ///< Bytes per element on disk
+    bool little_endian = true;    ///< Byte order on disk
+    uint64_t count = 0;
+    std::vector<uint64_t> shape;  ///< Empty for raw inputs
+    std::span<const uint8_t> data;
+};
+
+bool open_input(const std::string& path, container c, const element_type* from, input_file& in, std::string& err) {
+    if (!in.map.open(path)) { err = "cannot open '" + path + "'"; return false; }
+    const auto bytes = in.map.bytes();
+    in.little_endian = std::endian::native == std::endian::little;
+
+    if (c == container::raw) {
+        in.type = from ? *from : element_type{};
+        in.item_bytes = in.type.bytes();
+        if (bytes.size() % in.item_bytes != 0) { err = "raw input size is not a multiple of the element size"; return false; }
+        in.count = bytes.size() / in.item_bytes;
+        in.data = bytes;
+        return true;
+    }
+
+    if (c == container::npy) {
+        auto h = takum::io::internal::npy_parse(bytes);
+        if (!h) { err = "malformed .npy input"; return false; }
+        using takum::io::internal::npy_kind;
+        if (h->kind == npy_kind::float32) in.type = {element_type::kind::f32, 0};
+        else if (h->kind == npy_kind::float64) in.type = {element_type::kind::f64, 0};
+        else {
+            size_t width = h->takum_width;
+            if (from && from->k == element_type::kind::takum) {
+                if (width != 0 && width != from->width) { err = ".npy holds takum" + std::to_string(width); return false; }
+                width = from->width;
+            }
+            if (width == 0) { err = "unsigned .npy input needs --from takumN"; return false; }
+            if (!takum::internal::is_dispatch_width(width)) { err = "unsupported width takum" + std::to_string(width); return false; }
+            in.type = {element_type::kind::takum, width};
+            if (h->item_bytes != takum::io::internal::npy_pattern_bytes(width)) {
+                err = ".npy item size does not match takum" + std::to_string(width);
+                return false;
+            }
+        }
+        in.item_bytes = h->item_bytes;
+        in.little_endian = h->little_endian || h->item_bytes == 1;
+        in.count = h->count;
+        in.shape = h->shape;
+        in.data = bytes.subspan(h->data_offset, h->count * h->item_bytes);
+        return true;
+    }
+
+    auto h = takum::internal::tka_decode_header(bytes);
+    if (!h) { err = "malformed .tka input"; return false; }
+    if (!takum::internal::is_dispatch_width(h->width)) { err = "unsupported width takum" + std::to_string(h->width); return false; }
+    in.type = {element_type::kind::takum, h->width};
+    if (h->element_bytes != in.type.bytes()) { err = "unexpected .tka element size"; return false; }
+    in.item_bytes = h->element_bytes;
+    in.little_endian = h->byte_order == 1;
+    in.count = h->count;
+    in.shape = h->shape;
+    in.data = bytes.subspan(h->data_offset, h->count * h->element_bytes);
+    return true;
+}
+
+/// Destination of converted chunks (native in-memory layout of the output type).
+struct output_sink {
+    std::function<bool(const uint8_t*, size_t)> write; ///< (elements, count)
+    std::function<bool()> finish;
+};
+
+bool open_output(const std::string& path, container c, const element_type& type, const input_file& in,
+                 output_sink& out, std::string& err) {
+    if (c == container::tka) {
+        if (type.k != element_type::kind::takum) { err = ".tka output requires a takum type"; return false; }
+        bool ok = false;
+        takum::internal::dispatch_width(type.width, [&](auto width) {
+            constexpr size_t N = decltype(width)::value;
+            auto w = takum::mapped_array_writer<N>::create(path, in.shape);
+            if (!w) return;
+            auto writer = std::make_shared<takum::mapped_array_writer<N>>(std::move(*w));
+            out.write = [writer](const uint8_t* p, size_t n) {
+                return writer->append(std::span<const takum::takum<N>>(reinterpret_cast<const takum::takum<N>*>(p), n));
+            };
+            out.finish = [writer] { return writer->finish().has_value(); };
+            ok = true;
+        });
+        if (!ok) err = "cannot create '" + path + "'";
+        return ok;
+    }
+
+    std::FILE* raw = std::fopen(path.c_str(), "wb");
+    if (!raw) { err = "cannot create '" + path + "'"; return false; }
+    auto file = std::shared_ptr<std::FILE>(raw, [](std::FILE* f) { std::fclose(f); });
+
+    if (c == container::raw) {
+        const size_t elem = type.bytes();
+        out.write = [file, elem](const uint8_t* p, size_t n) { return std::fwrite(p, elem, n, file.get()) == n; };
+        out.finish = [file] { return std::fflush(file.get()) == 0; };
+        return true;
+    }
+
+    // .npy: little-endian items; takum patterns use the smallest unsigned type.
+    const size_t item = type.k == element_type::kind::takum ? takum::io::internal::npy_pattern_bytes(type.width) : type.bytes();
+    std::string descr;
+    if (type.k == element_type::kind::f32) descr = "'<f4'";
+    else if (type.k == element_type::kind::f64) descr = "'<f8'";
+    else descr = "[('takum" + std::to_string(type.width) + "', '<u" + std::to_string(item) + "')]";
+    const uint64_t flat[1] = {in.count};
+    const auto preamble = takum::io::internal::npy_preamble(
+        descr, in.shape.empty() ? std::span<const uint64_t>(flat) : std::span<const uint64_t>(in.shape));
+    if (std::fwrite(preamble.data(), 1, preamble.size(), file.get()) != preamble.size()) {
+        err = "write failed";
+        return false;
+    }
+    const size_t elem = type.bytes();
+    const bool direct = item == elem && std::endian::native == std::endian::little;
+    auto scratch = std::make_shared<std::vector<uint8_t>>();
+    out.write = [file, elem, item, direct, scratch](const uint8_t* p, size_t n) {
+        if (direct) return std::fwrite(p, elem, n, file.get()) == n;
+        scratch->resize(n * item);
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t v = 0;
+            if (elem == 4) {
+                uint32_t u;
+                std::memcpy(&u, p + i * 4, 4);
+                v = u;
+            } else {
+                std::memcpy(&v, p + i * 8, 8);
+            }
+            takum::internal::store_le(scratch->data() + i * item, v, item);
+        }
+        return std::fwrite(scratch->data(), item, n, file.get()) == n;
+    };
+    out.finish = [file] { return std::fflush(file.get()) == 0; };
+    return true;
+}
+
+/// Copy @p n on-disk elements into native layout (byte order and item width).
+void load_chunk(const input_file& in, const uint8_t* src, size_t n, uint8_t* dst) {
+    const size_t elem = in.type.bytes();
+    const bool native = in.little_endian == (std::endian::native == std::endian::little);
+    const bool pattern = in.type.k == element_type::kind::takum;
+    const uint64_t mask = pattern ? takum::internal::low_mask(in.type.width) : ~uint64_t{0};
+    if (in.item_bytes == elem) {
+        std::memcpy(dst, src, n * elem);
+        if (!native) takum::internal::byteswap_units(dst, n * elem, elem);
+        // Patterns keep only their low N bits, like the library loaders.
+        if (pattern && in.type.width < 8 * elem) {
+            for (size_t i = 0; i < n; ++i) {
+                if (elem == 4) {
+                    uint32_t u;
+                    std::memcpy(&u, dst + i * 4, 4);
+                    u &= static_cast<uint32_t>(mask);
+                    std::memcpy(dst + i * 4, &u, 4);
+                } else {
+                    uint64_t v;
+                    std::memcpy(&v, dst + i * 8, 8);
+                    v &= mask;
+                    std::memcpy(dst + i * 8, &v, 8);
+                }
+            }
+        }
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t v = takum::internal::load_le(src + i * in.item_bytes, in.item_bytes);
+        if (!in.little_endian) v = std::byteswap(v) >> (64 - 8 * in.item_bytes);
+        v &= mask;
+        if (elem == 4) {
+            const auto u = static_cast<uint32_t>(v);
+            std::memcpy(dst + i * 4, &u, 4);
+        } else {
+            std::memcpy(dst + i * 8, &v, 8);
+        }
+    }
+}
+
+/// Widen @p n elements of @p t to double.
+void to_doubles(const element_type& t, const uint8_t* p, size_t n, double* out) {
+    if (t.k == element_type::kind::f32) {
+        const auto* f = reinterpret_cast<const float*>(p);
+        for (size_t i = 0; i < n; ++i) out[i] = f[i];
+    } else if (t.k == element_type::kind::f64) {
+        std::memcpy(out, p, n * sizeof(double));
+    } else {
+        takum::internal::dispatch_width(t.width, [&](auto width) {
+            constexpr size_t N = decltype(width)::value;
+            takum::decode_batch<N, double>(
+                std::span<const takum::takum<N>>(reinterpret_cast<const takum::takum<N>*>(p), n), std::span<double>(out, n));
+        });
+    }
+}
+
+/// Convert @p n elements between the native layouts of @p from and @p to.
+void convert_chunk(const element_type& from, const element_type& to, const uint8_t* in, size_t n, uint8_t* out,
+                   std::vector<double>& scratch) {
+    using kind = element_type::kind;
+    if (from.k != kind::takum && to.k == kind::takum) {
+        takum::internal::dispatch_width(to.width, [&](auto width) {
+            constexpr size_t N = decltype(width)::value;
+            std::span<takum::takum<N>> dst(reinterpret_cast<takum::takum<N>*>(out), n);
+            if (from.k == kind::f32) takum::encode_batch<N, float>(std::span<const float>(reinterpret_cast<const float*>(in), n), dst);
+            else takum::encode_batch<N, double>(std::span<const double>(reinterpret_cast<const double*>(in), n), dst);
+        });
+        return;
+    }
+    if (from.k == kind::takum && to.k != kind::takum) {
+        takum::internal::dispatch_width(from.width, [&](auto width) {
+            constexpr size_t N = decltype(width)::value;
+            std::span<const takum::takum<N>> src(reinterpret_cast<const takum::takum<N>*>(in), n);
+            if (to.k == kind::f32) takum::decode_batch<N, float>(src, std::span<float>(reinterpret_cast<float*>(out), n));
+            else takum::decode_batch<N, double>(src, std::span<double>(reinterpret_cast<double*>(out), n));
+        });
+        return;
+    }
+    // Float ↔ float or takum ↔ takum: go through double.
+    scratch.resize(n);
+    to_doubles(from, in, n, scratch.data());
+    if (to.k == kind::f32) {
+        auto* f = reinterpret_cast<float*>(out);
+        for (size_t i = 0; i < n; ++i) f[i] = static_cast<float>(scratch[i]);
+    } else if (to.k == kind::f64) {
+        std::memcpy(out, scratch.data(), n * sizeof(double));
+    } else {
+        takum::internal::dispatch_width(to.width, [&](auto width) {
+            constexpr size_t N = decltype(width)::value;
+            takum::encode_batch<N, double>(std::span<const double>(scratch),
+                                           std::span<takum::takum<N>>(reinterpret_cast<takum::takum<N>*>(out), n));
+        });
+    }
+}
+
+/// Relative error of the output against the input.
+struct error_stats {
+    uint64_t compared = 0;
+    uint64_t non_finite = 0; ///< Non-finite inputs (NaR / NaN / ±inf), not compared
+    double max_rel = 0.0;
+    double sum_rel = 0.0;
+
+    void add(const double* in, const double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            if (!std::isfinite(in[i])) { ++non_finite; continue; }
+            const double err = in[i] == 0.0 ? std::fabs(out[i]) : std::fabs(out[i] - in[i]) / std::fabs(in[i]);
+            const double e = std::isnan(err) ? HUGE_VAL : err;
+            max_rel = std::max(max_rel, e);
+            sum_rel += e;
+            ++compared;
+        }
+    }
+};
+
+/// One pipeline buffer.
+struct chunk {
+    size_t first = 0;
+    size_t count = 0;
+    std::vector<uint64_t> in;  ///< Native input elements (8-byte aligned)
+    std::vector<uint64_t> out; ///< Native output elements
+};
+
+/// Bounded blocking FIFO connecting two pipeline stages.
+class chunk_queue {
+public:
+    void push(chunk* c) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.push_back(c);
+        }
+        ready_.notify_one();
+    }
+
+    /// @return nullptr once the queue is closed and drained
+    chunk* pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [&] { return !items_.empty() || closed_; });
+        if (items_.empty()) return nullptr;
+        chunk* c = items_.front();
+        items_.pop_front();
+        return c;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        ready_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<chunk*> items_;
+    bool closed_ = false;
+};
+
+/// Per-stage busy time in seconds.
+struct stage_times {
+    double read = 0.0, convert = 0.0, write = 0.0;
+};
+
+double seconds_since(clock_type::time_point t0) {
+    return std::chrono::duration<double>(clock_type::now() - t0).count();
+}
+
+/**
+ * Run read → convert → write. Capacity is bounded by the chunk pool: the
+ * reader blocks on the free queue until the writer hands a buffer back.
+ */
+bool run_pipeline(const input_file& in, const element_type& to, output_sink& sink, size_t chunk_elems, bool stats,
+                  error_stats& errors, stage_times& times) {
+    const size_t words_in = (chunk_elems * in.type.bytes() + 7) / 8;
+    const size_t words_out = (chunk_elems * to.bytes() + 7) / 8;
+    std::vector<double> scratch, a, b;
+
+    auto read = [&](chunk& c) {
+        const auto t0 = clock_type::now();
+        load_chunk(in, in.data.data() + c.first * in.item_bytes, c.count, reinterpret_cast<uint8_t*>(c.in.data()));
+        times.read += seconds_since(t0);
+    };
+    auto convert = [&](chunk& c) {
+        const auto t0 = clock_type::now();
+        const auto* src = reinterpret_cast<const uint8_t*>(c.in.data());
+        auto* dst = reinterpret_cast<uint8_t*>(c.out.data());
+        convert_chunk(in.type, to, src, c.count, dst, scratch);
+        if (stats) {
+            a.resize(c.count);
+            b.resize(c.count);
+            to_doubles(in.type, src, c.count, a.data());
+            to_doubles(to, dst, c.count, b.data());
+            errors.add(a.data(), b.data(), c.count);
+        }
+        times.convert += seconds_since(t0);
+    };
+    auto write = [&](chunk& c) {
+        const auto t0 = clock_type::now();
+        const bool ok = sink.write(reinterpret_cast<const uint8_t*>(c.out.data()), c.count);
+        times.write += seconds_since(t0);
+        return ok;
+    };
+
+#if TAKUM_ENABLE_THREADS
+    constexpr size_t depth = 4;
+    std::vector<chunk> pool(depth);
+    chunk_queue free_q, convert_q, write_q;
+    for (auto& c : pool) {
+        c.in.resize(words_in);
+        c.out.resize(words_out);
+        free_q.push(&c);
+    }
+    std::atomic<bool> failed{false};
+
+    std::thread reader([&] {
+        for (size_t first = 0; first < in.count && !failed.load(std::memory_order_relaxed); first += chunk_elems) {
+            chunk* c = free_q.pop();
+            c->first = first;
+            c->count = std::min<size_t>(chunk_elems, in.count - first);
+            read(*c);
+            convert_q.push(c);
+        }
+        convert_q.close();
+    });
+    std::thread converter([&] {
+        while (chunk* c = convert_q.pop()) {
+            if (!failed.load(std::memory_order_relaxed)) convert(*c);
+            write_q.push(c);
+        }
+        write_q.close();
+    });
+    while (chunk* c = write_q.pop()) {
+        if (!failed.load(std::memory_order_relaxed) && !write(*c)) failed = true;
+        free_q.push(c);
+    }
+    reader.join();
+    converter.join();
+    return !failed;
+#else
+    chunk c;
+    c.in.resize(words_in);
+    c.out.resize(words_out);
+    for (size_t first = 0; first < in.count; first += chunk_elems) {
+        c.first = first;
+        c.count = std::min<size_t>(chunk_elems, in.count - first);
+        read(c);
+        convert(c);
+        if (!write(c)) return false;
+    }
+    return true;
+#endif
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    element_type from, to;
+    bool have_from = false, have_to = false, stats = true;
+    size_t chunk_elems = size_t{1} << 20;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string { return i + 1 < argc ? argv[++i] : std::string(); };
+        if (arg == "--help" || arg == "-h") { print_usage(std::cout); return 0; }
+        if (arg == "--from") {
+            if (!parse_type(value(), from)) { std::cerr << "takum_convert: invalid --from type\n"; return 2; }
+            have_from = true;
+        } else if (arg == "--to") {
+            if (!parse_type(value(), to)) { std::cerr << "takum_convert: invalid --to type\n"; return 2; }
+            have_to = true;
+        } else if (arg == "--chunk") {
+            const std::string v = value();
+            char* end = nullptr;
+            chunk_elems = std::strtoull(v.c_str(), &end, 10);
+            if (v.empty() || *end != '\0' || chunk_elems == 0) { std::cerr << "takum_convert: invalid --chunk\n"; return 2; }
+        } else if (arg == "--no-stats") {
+            stats = false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() != 2) { print_usage(std::cerr); return 2; }
+
+    std::string err;
+    input_file in;
+    if (!open_input(positional[0], container_of(positional[0]), have_from ? &from : nullptr, in, err)) {
+        std::cerr << "takum_convert: " << err << "\n";
+        return 1;
+    }
+    if (!have_to) {
+        to = in.type.k == element_type::kind::takum ? element_type{element_type::kind::f64, 0}
+                                                    : element_type{element_type::kind::takum, 32};
+    }
+    output_sink sink;
+    if (!open_output(positional[1], container_of(positional[1]), to, in, sink, err)) {
+        std::cerr << "takum_convert: " << err << "\n";
+        return 1;
+    }
+
+    error_stats errors;
+    stage_times times;
+    const auto t0 = clock_type::now();
+    bool ok = run_pipeline(in, to, sink, chunk_elems, stats, errors, times);
+    ok = sink.finish() && ok;
+    const double wall = seconds_since(t0);
+    if (!ok) { std::cerr << "takum_convert: write to '" << positional[1] << "' failed\n"; return 1; }
+
+    const double in_bytes = static_cast<double>(in.count * in.item_bytes);
+    const double out_bytes = static_cast<double>(in.count * to.bytes());
+    const double secs = std::max(wall, 1e-9);
+    std::printf("converted %llu elements %s -> %s\n", static_cast<unsigned long long>(in.count), in.type.name().c_str(),
+                to.name().c_str());
+    std::printf("time: %.3f s  in: %.3f GB/s (%.1f MB)  out: %.3f GB/s (%.1f MB)\n", wall, in_bytes / secs * 1e-9,
+                in_bytes * 1e-6, out_bytes / secs * 1e-9, out_bytes * 1e-6);
+    std::printf("stage busy: read %.3f s  convert %.3f s  write %.3f s\n", times.read, times.convert, times.write);
+    if (stats) {
+        std::printf("error: max_rel %.6e  mean_rel %.6e  compared %llu  non-finite %llu\n", errors.max_rel,
+                    errors.compared ? errors.sum_rel / static_cast<double>(errors.compared) : 0.0,
+                    static_cast<unsigned long long>(errors.compared), static_cast<unsigned long long>(errors.non_finite));
+    }
+    return 0;
+}